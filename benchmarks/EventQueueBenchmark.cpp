@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include "../include/ListQueue.h"
+#include "../include/HeapQueue.h"
+#include "../include/CalendarQueue.h"
+
+/**
+ * Event which can be rescheduled by the benchmark
+ */
+class BenchmarkEvent : public Event {
+public:
+    explicit BenchmarkEvent(double time) : Event(time) {};
+
+    void setTime(double newTime) { time = newTime; };
+};
+
+/**
+ * Run the hold model on the queue : the first event is removed and rescheduled
+ * after the next increment, numberOfEvents times, with pendingEvents events in the queue.
+ * @return the average duration of one hold operation in nanoseconds
+ */
+double holdBenchmark(OrderedSet *queue, const std::vector<double> &increments, int pendingEvents) {
+    std::vector<BenchmarkEvent *> events;
+    for (int i = 0; i < pendingEvents; ++i) {
+        events.push_back(new BenchmarkEvent(increments[i]));
+        queue->insert(events.back());
+    }
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t i = pendingEvents; i < increments.size(); ++i) {
+        auto *event = (BenchmarkEvent *) queue->removeFirst();
+        event->setTime(event->getTime() + increments[i]);
+        queue->insert(event);
+    }
+    auto end = std::chrono::steady_clock::now();
+    while (queue->removeFirst() != nullptr) {}
+    for (auto &event : events) {
+        delete event;
+    }
+    return std::chrono::duration<double, std::nano>(end - begin).count() / (increments.size() - pendingEvents);
+}
+
+/**
+ * Compare the event calendars on a synthetic workload mimicking the simulation :
+ * job completions after a normally distributed duration, users resubmitting after an
+ * exponential time and week-end events coming back every 168 hours.
+ * usage : EventQueueBenchmark [numberOfEvents] [pendingEvents]
+ */
+int main(int argc, char *argv[]) {
+    int numberOfEvents = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int pendingEvents = argc > 2 ? std::atoi(argv[2]) : 1000;
+    if (numberOfEvents <= pendingEvents) {
+        std::cout << "The number of events shall be larger than the number of pending events\n";
+        return 1;
+    }
+
+    std::mt19937_64 generator(42);
+    std::exponential_distribution<double> userArrival(1.0 / 12);
+    std::normal_distribution<double> jobDuration(9, 2);
+    std::discrete_distribution<int> kindOfEvent({60, 39, 1});
+    std::vector<double> increments;
+    increments.reserve(numberOfEvents);
+    for (int i = 0; i < numberOfEvents; ++i) {
+        switch (kindOfEvent(generator)) {
+            case 0:
+                increments.push_back(std::max(0.0, jobDuration(generator)));
+                break;
+            case 1:
+                increments.push_back(userArrival(generator));
+                break;
+            default:
+                increments.push_back(168);
+        }
+    }
+
+    std::cout << numberOfEvents << " events, " << pendingEvents << " pending events\n";
+    for (const char *name : {"list", "heap", "calendar"}) {
+        OrderedSet *queue;
+        if (std::string(name) == "list") {
+            queue = new ListQueue();
+        } else if (std::string(name) == "heap") {
+            queue = new HeapQueue();
+        } else {
+            queue = new CalendarQueue();
+        }
+        std::cout << name << " : " << holdBenchmark(queue, increments, pendingEvents) << " ns per event\n";
+        delete queue;
+    }
+    return 0;
+}
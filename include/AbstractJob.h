@@ -13,24 +13,31 @@ class HPCSimulator;
 
 class AbstractScheduler;
 
+class RandomStream;
+
+class JobCompletion;
+
 /**
  * This class define the common API for the different categories of Jobs
  */
 class AbstractJob {
 protected:
     /**
-     * Job id is a unique integer that
-     */
-    int id;   // job id
-    /**
-     * Static variable used to ensure that every Id is unique.
-     * It is incremented at each job creation
+     * Job id is a unique integer in the simulation, given by HPCSimulator::newJobId
      */
-    static int jobCounter;
+    int id = 0;   // job id
     /**
      * Time at which the job is submitted to the scheduler
      */
     double submittingTime = 0; // job scheduling time
+    /**
+     * Time at which the job starts to run, -1 while it is waiting
+     */
+    double startTime = -1;
+    /**
+     * Priority of the job in the queues, the higher the sooner it runs
+     */
+    double jobPriority = 0;
     /**
      * Time at which the job finishes to run
      */
@@ -40,13 +47,45 @@ protected:
      */
     double executionDuration = 0;  // job execution time
     /**
-     * Number of nodes required for the job
+     * Duration of the execution left, longer than the execution duration once the job has been checkpointed
+     */
+    double remainingDuration = 0;
+    /**
+     * Number of times the job has been checkpointed and requeued
+     */
+    int numberOfCheckpoints = 0;
+    /**
+     * Number of cores used on each node, 0 when the job uses whole nodes
+     */
+    int numberOfCores = 0;
+    /**
+     * Duration declared by the user, 0 if none
+     */
+    double declaredWalltime = 0;
+    /**
+     * Number of nodes required for the job, the most nodes a moldable job may use
      */
     int numberOfNodes = 0;
+    /**
+     * Fewest nodes a moldable job may use, 0 when the job only runs on its number of nodes
+     */
+    int minNumberOfNodes = 0;
+    /**
+     * Share of the execution of a moldable job which does not run faster on more nodes (Amdahl's law)
+     */
+    double serialFraction = 0;
+    /**
+     * Share of the execution spent on I/O when the job does not compete for the filesystem
+     */
+    double ioIntensity = 0;
     /**
      * Pointer to the user who generated the job
      */
     User *user = nullptr;
+    /**
+     * Event ending the job, owned by the job. nullptr while the job has not started
+     */
+    JobCompletion *completion = nullptr;
 
     /**
      * This function is used to generate a random time between minTime and maxTime
@@ -54,20 +93,27 @@ protected:
      * The values are generated according to a normal law.
      * @param minTime the minimal execution time for this job
      * @param maxTime the maximal execution time for this job
+     * @param stream from which the random numbers are drawn
      */
-    void generateRandomTime(double minTime, double maxTime);
+    void generateRandomTime(double minTime, double maxTime, RandomStream &stream);
 
-
-public:
     /**
-     * The default constructor is incrementing the static job counter and setting the job id
+     * Make the job moldable down to half of its nodes, but not below the minimum number of nodes passed as
+     * parameter. The serial fraction of the job is drawn uniformly between 0 and 0.2.
+     * @param lowestNumberOfNodes fewest nodes the job may use
+     * @param stream from which the random numbers are drawn
      */
-    AbstractJob();
+    void generateRandomRange(int lowestNumberOfNodes, RandomStream &stream);
+
+
+public:
+    AbstractJob() = default;
 
     /**
-     * To allow class inheriting from this one to define their own destructor if needed
+     * To allow class inheriting from this one to define their own destructor if needed.
+     * Delete the completion event of the job.
      */
-    virtual ~AbstractJob() {};
+    virtual ~AbstractJob();
 
     /**
      * Return the job id
@@ -75,12 +121,28 @@ public:
      */
     int getId() const { return id; }
 
+    /**
+     * Set the job id
+     * @param jobId unique in the simulation
+     * @return this job
+     */
+    AbstractJob &setId(int jobId) {
+        id = jobId;
+        return *this;
+    }
+
     /**
      * Return the time at which the job as been submitted
      * @return submitting time
      */
     double getSubmittingTime() const { return submittingTime; }
 
+    /**
+     * Return the time at which the job started to run
+     * @return start time, -1 if the job has not started
+     */
+    double getStartTime() const { return startTime; }
+
     /**
      * Return the time at which a job as been completed
      * @return completion time
@@ -93,6 +155,110 @@ public:
      */
     double getExecutionDuration() const { return executionDuration; }
 
+    /**
+     * Return the number of cores the job uses on each of its nodes
+     * @return the number of cores of a node when the job uses whole nodes
+     */
+    int getNumberOfCores() const { return numberOfCores > 0 ? numberOfCores : HPCParameters::coresPerNode; }
+
+    /**
+     * Return whether the scheduler may choose the number of nodes of the job when it starts
+     * @return
+     */
+    bool isMoldable() const { return minNumberOfNodes > 0 && minNumberOfNodes < numberOfNodes; }
+
+    int getMinNumberOfNodes() const { return minNumberOfNodes; }
+
+    double getSerialFraction() const { return serialFraction; }
+
+    /**
+     * Return the walltime of the job if it runs on the number of nodes passed as parameter. The durations of a
+     * moldable job are the ones on all its nodes, they are scaled according to Amdahl's law.
+     * @param nodes between the minimum and the number of nodes of the job
+     * @return
+     */
+    double getWalltimeOn(int nodes) const {
+        return getWalltime() * (serialFraction + (1 - serialFraction) / nodes) /
+               (serialFraction + (1 - serialFraction) / numberOfNodes);
+    }
+
+    /**
+     * Fix the number of nodes of a moldable job when it starts, its durations are scaled accordingly and
+     * the nodes it does not use are given back to its user. The job is not moldable anymore.
+     * @param nodes between the minimum and the number of nodes of the job
+     */
+    void mold(int nodes);
+
+    /**
+     * Return whether the job leaves cores of its nodes to other jobs
+     * @return
+     */
+    bool isSharingNodes() const { return numberOfCores > 0 && numberOfCores < HPCParameters::coresPerNode; }
+
+    /**
+     * Return the node-hours used by the execution of the job, the cores it uses are counted as a share of
+     * their node
+     * @return
+     */
+    double getNodeHours() const { return executionDuration * getNodeShare(); }
+
+    /**
+     * Return the number of nodes used by the job, the cores it uses are counted as a share of their node
+     * @return
+     */
+    double getNodeShare() const {
+        return numberOfNodes * ((double) getNumberOfCores() / HPCParameters::coresPerNode);
+    }
+
+    /**
+     * Return the duration the scheduler relies on : the walltime declared by the user if any,
+     * the execution duration otherwise
+     * @return
+     */
+    double getWalltime() const {
+        return (declaredWalltime > 0 ? declaredWalltime : executionDuration) - executionDuration + remainingDuration;
+    }
+
+    /**
+     * Return for how long the job runs once started : the execution duration, less what has been done before
+     * the checkpoints of the job and plus their overheads
+     * @return
+     */
+    double getRemainingDuration() const { return remainingDuration; }
+
+    int getNumberOfCheckpoints() const { return numberOfCheckpoints; }
+
+    /**
+     * Stop the job after it ran for some time since its last start, it runs again from its last checkpoint
+     * @param timeRan since the last start of the job
+     * @param overhead of the checkpoint, added to the remaining duration
+     */
+    void checkpoint(double timeRan, double overhead) {
+        remainingDuration += overhead - timeRan;
+        numberOfCheckpoints++;
+    }
+
+    /**
+     * Lengthen the execution left of the job, when it runs slower on the nodes it was given
+     * @param factor by which the remaining duration is multiplied, at least 1
+     */
+    void slowDown(double factor) {
+        executionDuration += remainingDuration * (factor - 1);
+        remainingDuration *= factor;
+    }
+
+    /**
+     * Lengthen the execution of the job once it is known, when it ran slower than planned
+     * @param hours added to the execution duration
+     */
+    void extendExecution(double hours) { executionDuration += hours; }
+
+    /**
+     * Return the share of the execution spent on I/O when the job does not compete for the filesystem
+     * @return I/O intensity, between 0 and 1
+     */
+    double getIoIntensity() const { return ioIntensity; }
+
     /**
      * Return the number of nodes on which the job is going to run
      * @return number of nodes required for this job
@@ -100,12 +266,35 @@ public:
     int getNumberOfNodes() { return (numberOfNodes); };
 
     /**
-     * Set the time at which the job as been submitted
+     * Set the time at which the job as been submitted, the priority of the job is reset to
+     * its default value : the older the job is the higher its priority
      * @param time of submission
      * @return this job
      */
     AbstractJob &setSubmittingTime(double time) {
         submittingTime = time;
+        jobPriority = -time;
+        return *this;
+    }
+
+    /**
+     * Set the priority of the job. The priority of a job waiting in a queue must be changed
+     * through the queue, which is ordered by priority.
+     * @param priority the higher the sooner the job runs
+     * @return this job
+     */
+    AbstractJob &setPriority(double priority) {
+        jobPriority = priority;
+        return *this;
+    }
+
+    /**
+     * Set the time at which the job started to run
+     * @param time at which the job started
+     * @return this job
+     */
+    AbstractJob &setStartTime(double time) {
+        startTime = time;
         return *this;
     }
 
@@ -126,6 +315,25 @@ public:
      */
     AbstractJob &setExecutionDuration(double time) {
         executionDuration = time;
+        remainingDuration = time;
+        return *this;
+    }
+
+    /**
+     * Set the number of cores used on each node
+     * @param cores 0 to use whole nodes
+     */
+    AbstractJob &setNumberOfCores(int cores) {
+        numberOfCores = cores;
+        return *this;
+    }
+
+    /**
+     * Set the walltime declared by the user, which must not be shorter than the execution duration
+     * @param time 0 to rely on the execution duration
+     */
+    AbstractJob &setDeclaredWalltime(double time) {
+        declaredWalltime = time;
         return *this;
     }
 
@@ -139,6 +347,34 @@ public:
         return *this;
     };
 
+    /**
+     * Let the scheduler run the job on fewer nodes than its number of nodes
+     * @param minNodes fewest nodes the job may use, 0 for a job which is not moldable
+     * @param fraction serial fraction of the execution
+     * @return this job
+     */
+    AbstractJob &setMoldable(int minNodes, double fraction) {
+        minNumberOfNodes = minNodes;
+        serialFraction = fraction;
+        return *this;
+    }
+
+    /**
+     * Set the share of the execution spent on I/O when the job does not compete for the filesystem
+     * @param intensity between 0 and 1
+     * @return this job
+     */
+    AbstractJob &setIoIntensity(double intensity) {
+        ioIntensity = intensity;
+        return *this;
+    }
+
+    /**
+     * Draw the share of the execution spent on I/O
+     * @param stream from which the random numbers are drawn
+     */
+    void generateRandomIoIntensity(RandomStream &stream);
+
     /**
      * Return the user who generated this job
      * @return user who generated this job
@@ -156,6 +392,23 @@ public:
         return *this;
     }
 
+    /**
+     * Return the event ending the job
+     * @return nullptr if the job has not started
+     */
+    JobCompletion *getCompletion() const {
+        return completion;
+    }
+
+    /**
+     * Set the event ending the job, the job takes the ownership of the event
+     * @param jobCompletion
+     */
+    AbstractJob &setCompletion(JobCompletion *jobCompletion) {
+        completion = jobCompletion;
+        return *this;
+    }
+
     /**
      * Insert the job in the appropriate queue of the scheduler
      * @param simulator handling the current simulation
@@ -181,6 +434,25 @@ public:
      */
     virtual string getType() = 0;
 
+    /**
+     * Return the index of the type of job, in the order of the permissions : small, medium, large, huge, gpu
+     * @return
+     */
+    virtual int getTypeIndex() const = 0;
+
+    /**
+     * Index of the type of the huge jobs, which are queued and scheduled apart from the others
+     */
+    static const int HugeJobTypeIndex = 3;
+
+    /**
+     * Return a record of the binary trace describing this job
+     * @param kind of record
+     * @param time of the record
+     * @return
+     */
+    BinaryTraceRecord traceRecord(TraceRecordKind kind, double time);
+
     /**
      * Try to execute the current job, assuming it is the next in his queue.
      * Checks for nodes available according to priority rules and reservation
@@ -199,16 +471,31 @@ public:
     }
 
     /**
-     * Return the priority of job. This function can be modified if you want to change how the
-     * priority is computed. As we implemented, the older the job is the one with the highest priority
+     * Return the priority of job. By default the older the job is the one with the highest priority,
+     * schedulers may set another priority with setPriority
      * @return
      */
-    double priority() const { return (-getSubmittingTime()); };
+    double priority() const { return jobPriority; };
 
     /**
      * This function shall generates random requirements according to the requirements of the subclasse
+     * @param stream from which the random numbers are drawn
+     */
+    virtual void generateRandomRequirements(RandomStream &stream) = 0;
+
+    /**
+     * Draw the number of cores used on each node, for the jobs which may share their nodes.
+     * By default the job uses whole nodes.
+     * @param stream from which the random numbers are drawn
+     */
+    virtual void generateRandomCores(RandomStream &) {};
+
+    /**
+     * Draw the range of nodes and the serial fraction of the jobs which may run on fewer nodes.
+     * By default the job is not moldable.
+     * @param stream from which the random numbers are drawn
      */
-    virtual void generateRandomRequirements() = 0;
+    virtual void generateRandomScaling(RandomStream &) {};
 
     /**
      * This function return true if the Job requires GPU, false in the other cases
@@ -240,7 +527,11 @@ public:
 
     string getType() { return type; };
 
-    void generateRandomRequirements();
+    int getTypeIndex() const override { return 2; };
+
+    void generateRandomRequirements(RandomStream &stream);
+
+    void generateRandomScaling(RandomStream &stream) override;
 
     void registerAsFinishedJob(HPCSimulator *pSimulator);
 };
@@ -261,12 +552,14 @@ public:
 
     string getType() { return type; };
 
+    int getTypeIndex() const override { return 1; };
+
     /*
      * Assume that the job that you are trying to execute is the first in his queue
      */
     void tryToExecute(AbstractSimulator *simulator, AbstractScheduler *scheduler);
 
-    void generateRandomRequirements();
+    void generateRandomRequirements(RandomStream &stream);
 
     void registerAsFinishedJob(HPCSimulator *pSimulator);
 };
@@ -292,7 +585,11 @@ public:
 
     string getType() { return type; };
 
-    void generateRandomRequirements();
+    int getTypeIndex() const override { return 0; };
+
+    void generateRandomRequirements(RandomStream &stream);
+
+    void generateRandomCores(RandomStream &stream) override;
 
     void registerAsFinishedJob(HPCSimulator *pSimulator);
 
@@ -313,9 +610,13 @@ public:
 
     string getType() { return type; };
 
+    int getTypeIndex() const override { return HugeJobTypeIndex; };
+
     void tryToExecute(AbstractSimulator *simulator, AbstractScheduler *scheduler);
 
-    void generateRandomRequirements();
+    void generateRandomRequirements(RandomStream &stream);
+
+    void generateRandomScaling(RandomStream &stream) override;
 
     void registerAsFinishedJob(HPCSimulator *pSimulator);
 };
@@ -341,7 +642,9 @@ public:
 
     string getType() { return type; };
 
-    void generateRandomRequirements();
+    int getTypeIndex() const override { return 4; };
+
+    void generateRandomRequirements(RandomStream &stream);
 
     bool isGpuJob() override { return true; };
 
@@ -355,8 +658,9 @@ typedef AbstractJob *(*CreateJobFn)();
  * This function is creating a job of a random type according to the users permissions passed
  * as a parameters and the relative proportions of the different types of jobs defined in HPC Parameters
  * @param permissions of the users (one boolean for each type of jobs: small, medium, large, huge, gpu)
+ * @param stream from which the type of job is drawn
  * @return a job of a random type
  */
-AbstractJob *CreateRandomJob(const bool permissions[5]);
+AbstractJob *CreateRandomJob(const bool permissions[5], RandomStream &stream);
 
 #endif
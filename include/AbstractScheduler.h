@@ -1,10 +1,16 @@
 #ifndef SUPERCOMPUTERSIMULATION_ABSTRACTSCHEDULER_H
 #define SUPERCOMPUTERSIMULATION_ABSTRACTSCHEDULER_H
 
-#include <queue>
+#include <vector>
 #include "../include/Node.h"
 #include "AbstractJob.h"
-#include <list>
+#include "FreeNodePool.h"
+#include "JobQueue.h"
+#include "WeekendPlanner.h"
+#include "PartitionController.h"
+#include "IoContention.h"
+#include "ReservationCalendar.h"
+#include <map>
 
 //required due to cyclic includes
 class User;
@@ -21,10 +27,6 @@ class GpuJob;
 
 class Node;
 
-class ReservedForMediumJobNode;
-
-class ReservedForSmallJobNode;
-
 class GpuNode;
 
 /**
@@ -33,48 +35,389 @@ class GpuNode;
  */
 class AbstractScheduler {
 protected:
+    /**
+     * job with the highest priority among the heads of the medium, large, small and gpu queues
+     */
+    NextJobIndex nextJobIndex;
     /**
      * queue for medium jobs
      */
-    std::list<MediumJob *> *mediumJobs{};
+    JobQueue<MediumJob> *mediumJobs{};
     /**
      * queue for small jobs
      */
-    std::list<SmallJob *> *smallJobs{};
+    JobQueue<SmallJob> *smallJobs{};
 
     /**
      * queue for large jobs
      */
-    std::list<LargeJob *> *largeJobs{};
+    JobQueue<LargeJob> *largeJobs{};
 
     /**
      * queue for huge jobs
      */
-    std::list<HugeJob *> *hugeJobs{};
+    JobQueue<HugeJob> *hugeJobs{};
 
     /**
      * queue for gpu jobs
      */
-    std::list<GpuJob *> *gpuJobs{};
+    JobQueue<GpuJob> *gpuJobs{};
+
+    /**
+     * free nodes of each class : normal nodes, nodes reserved for medium jobs,
+     * nodes reserved for small jobs and nodes equipped with gpu
+     */
+    FreeNodePool freeNodePool;
+
+    /**
+     * jobs being executed, by time of completion
+     */
+    std::multimap<double, AbstractJob *> runningJobs;
+
+    /**
+     * selects the jobs run during the week-end, nullptr to start the huge jobs in order of submission
+     */
+    WeekendPlanner *weekendPlanner = nullptr;
+
+    /**
+     * resizes the partitions of nodes reserved for small and medium jobs, nullptr to keep them as created
+     */
+    PartitionController *partitionController = nullptr;
+
+    /**
+     * whether the jobs may run into the week-end, to be checkpointed when huge jobs need their nodes
+     */
+    bool preemption = false;
+
+    /**
+     * hours added to the remaining duration of a checkpointed job
+     */
+    double checkpointOverhead = 0;
+
+    /**
+     * whether small jobs use some cores of a node and share it
+     */
+    bool coreSharing = false;
+
+    /**
+     * nodes used by jobs sharing them and which have free cores, by number of free cores
+     */
+    std::multimap<int, Node *> sharedNodes;
+
+    /**
+     * whether the large and huge jobs submitted may run on fewer nodes
+     */
+    bool molding = false;
+
+    /**
+     * With molding, the nodes of the completed job still to be given back while releaseNodes adds them one
+     * after the other : they count as free now when a moldable job would start on fewer nodes
+     */
+    std::vector<Node *> nodesStillReleased;
+
+    /**
+     * number of consecutive node ids in each rack of the platform, 0 if the topology is unknown
+     */
+    int nodesPerRack = 0;
+
+    /**
+     * share of its duration by which a job runs longer for each rack it spans after the first
+     */
+    double communicationPenalty = 0;
+
+    /**
+     * slows down the jobs doing I/O when they ask for more than the filesystem bandwidth,
+     * nullptr if the filesystem is never a bottleneck
+     */
+    IoContention *ioContention = nullptr;
+
+    /**
+     * advance reservations of nodes, nullptr if no node is ever reserved
+     */
+    ReservationCalendar *reservationCalendar = nullptr;
+
+    /**
+     * nodes taken by the reservations going on, given back once no reservation keeps them
+     */
+    std::vector<Node *> reservedNodes;
+
+    /**
+     * Return the number of nodes on which a moldable job should start now : the one with which it is predicted
+     * to complete first, given the free nodes and the nodes released by the running jobs in order of completion.
+     * It waits while the nodes of a completed job are being given back.
+     * @param simulator running the current simulation
+     * @param job moldable
+     * @param nodeClasses the job may use
+     * @param numberOfNodesFree number of nodes the job may take now
+     * @param hoursLeft before which the job must end
+     * @return 0 if the job completes sooner by waiting for more nodes, or can not end in time
+     */
+    int moldedNumberOfNodes(AbstractSimulator *simulator, AbstractJob *job, const std::vector<NodeClass> &nodeClasses,
+                            int numberOfNodesFree, double hoursLeft) const;
+
+    /**
+     * Release the cores of a completed or checkpointed job on its nodes
+     * @param job
+     * @param nodes of the job
+     * @param freeNodes receives the nodes no job uses anymore, the others are kept as shared nodes
+     */
+    void releaseCores(AbstractJob *job, const std::vector<Node *> &nodes, std::vector<Node *> &freeNodes);
+
+    /**
+     * Take the shared node with the fewest free cores on which a job fits, and which is not reserved before
+     * the walltime of the job is over
+     * @param simulator running the current simulation
+     * @param job sharing its nodes, using a single node
+     * @return nullptr if there is no such node
+     */
+    Node *takeSharedNode(AbstractSimulator *simulator, AbstractJob *job);
 
     /**
-     * list of free nodes reserved for medium jobs
+     * Move the completions of the running jobs whose speed changed, all at once
+     * @param simulator running the current simulation
+     * @param completions jobs running with their new completion time
+     */
+    void rescheduleCompletions(AbstractSimulator *simulator,
+                               const std::vector<std::pair<AbstractJob *, double>> &completions);
+
+    /**
+     * Return the number of free nodes of a class which no reservation takes during a time window
+     * @param nodeClass
+     * @param from start of the window
+     * @param to end of the window, excluded
+     * @return
+     */
+    int availableUntilReserved(NodeClass nodeClass, double from, double to) const;
+
+    /**
+     * Return whether a job starting now on free nodes, taken from the classes in the order in which they are
+     * passed, gets enough of them which are not reserved before its walltime is over
+     * @param simulator running the current simulation
+     * @param job to start
+     * @param first class of nodes, in order of preference
+     * @param last class of nodes, excluded
+     * @param numberOfNodes the job runs on, fewer than its number of nodes when it is molded
+     * @return
      */
-    std::queue<Node *> freeMediumNodes;
+    bool fitsBeforeReservationsIn(AbstractSimulator *simulator, AbstractJob *job, const NodeClass *first,
+                                  const NodeClass *last, int numberOfNodes) const;
+
     /**
-     * list of free nodes reserved for small jobs
+     * Return whether a job can start now on free nodes of some classes and end before the next reservation of
+     * the nodes it would be given : a job which does not is left waiting, instead of being checkpointed when the
+     * reservation begins
+     * @param simulator running the current simulation
+     * @param job to start
+     * @param nodeClasses the nodes are taken from, in order of preference
+     * @param numberOfNodes the job runs on, fewer than its number of nodes when it is molded
+     * @return true if no node is ever reserved
      */
-    std::queue<Node *> freeSmallNodes;
+    bool fitsBeforeReservations(AbstractSimulator *simulator, AbstractJob *job,
+                                std::initializer_list<NodeClass> nodeClasses, int numberOfNodes) const {
+        return reservationCalendar == nullptr ||
+               fitsBeforeReservationsIn(simulator, job, nodeClasses.begin(), nodeClasses.end(), numberOfNodes);
+    }
+
+    bool fitsBeforeReservations(AbstractSimulator *simulator, AbstractJob *job,
+                                const std::vector<NodeClass> &nodeClasses, int numberOfNodes) const {
+        return reservationCalendar == nullptr ||
+               fitsBeforeReservationsIn(simulator, job, nodeClasses.data(), nodeClasses.data() + nodeClasses.size(),
+                                        numberOfNodes);
+    }
 
     /**
-     * list of free nodes equiped with gpu
+     * Replace the nodes of a job which are reserved before its walltime is over by free nodes of the same
+     * class which are not. The jobs only start when there are enough of them (see fitsBeforeReservations).
+     * The nodes already running jobs which share them are kept.
+     * @param simulator running the current simulation
+     * @param job starting now
+     * @param nodes allocated to the job, changed in place
      */
-    std::queue<Node *> freeGpuNodes;
+    void avoidReservations(AbstractSimulator *simulator, AbstractJob *job, std::vector<Node *> &nodes);
 
     /**
-     * list of free normal nodes
+     * Keep the nodes released by a job which are reserved now, until their reservation ends
+     * @param simulator running the current simulation
+     * @param freeNodes released, the reserved ones are removed
      */
-    std::queue<Node *> freeNodes;
+    void holdReservedNodes(AbstractSimulator *simulator, std::vector<Node *> &freeNodes);
+
+    /**
+     * Start a job on the nodes passed as parameter. The end of the job is a single JobCompletion
+     * event releasing all the nodes, whatever their number. A job spread over several racks is slowed
+     * down by the communication penalty, a job doing I/O may slow down the jobs sharing the filesystem.
+     * The nodes reserved before the walltime of the job is over are replaced when possible (see avoidReservations).
+     * @param simulator running the current simulation
+     * @param job to start
+     * @param nodes allocated to the job, they must be free. The job must not be waiting in a queue anymore.
+     */
+    virtual void startJob(AbstractSimulator *simulator, AbstractJob *job, const std::vector<Node *> &nodes);
+
+    /**
+     * Give the nodes of a completed job back to the scheduler. By default every node is added as a free
+     * node of its class, last allocated first, and each addition tries to start the next jobs.
+     * @param simulator running the current simulation
+     * @param nodes of the completed job
+     */
+    virtual void releaseNodes(AbstractSimulator *simulator, const std::vector<Node *> &nodes);
+
+    /**
+     * Start as many huge jobs as possible, in order of submission, on all the classes of nodes.
+     * With preemption, running jobs are first checkpointed to make room for them (see preemptForHugeJobs).
+     * With a week-end planner the jobs are selected by packWeekend instead.
+     * @param simulator running the current simulation
+     */
+    void startHugeJobs(AbstractSimulator *simulator);
+
+    /**
+     * Checkpoint running jobs until the free nodes are enough for the huge jobs which would start if every node
+     * but those of the running huge jobs was free (see nodesForHugeJobs). The jobs ending last are checkpointed first.
+     * A node shared by several jobs is only free once all of them are checkpointed, the jobs which would free no node
+     * keep running.
+     * @param simulator running the current simulation
+     * @return the number of jobs checkpointed
+     */
+    int preemptForHugeJobs(AbstractSimulator *simulator);
+
+    /**
+     * Return the number of nodes taken by the huge jobs which would start on some nodes : in order of submission
+     * while they fit, as startHugeJobs does, or the huge jobs of the selection of the week-end planner
+     * (see selectForWeekend)
+     * @param simulator running the current simulation
+     * @param numberOfNodes free
+     * @return
+     */
+    int nodesForHugeJobs(AbstractSimulator *simulator, int numberOfNodes);
+
+    /**
+     * Return the jobs the week-end planner selects among the waiting jobs for some free nodes
+     * @param simulator running the current simulation
+     * @param numberOfNodes free, of every class
+     * @return the jobs selected, in the order in which they are started
+     */
+    std::vector<AbstractJob *> selectForWeekend(AbstractSimulator *simulator, int numberOfNodes);
+
+    /**
+     * Return whether a job selected for the week-end may start now : a job which is not huge needs enough free
+     * nodes of its classes, and no job may run into a reservation
+     * @param simulator running the current simulation
+     * @param job waiting
+     * @return
+     */
+    bool fitsAtWeekend(AbstractSimulator *simulator, AbstractJob *job) const;
+
+    /**
+     * Stop a running job : its completion is cancelled, its nodes are free again without trying to start
+     * other jobs, and it is requeued with the duration left plus the checkpoint overhead
+     * @param simulator running the current simulation
+     * @param job running
+     */
+    void preempt(AbstractSimulator *simulator, AbstractJob *job);
+
+    /**
+     * Put a checkpointed job back in the queue of its type, where its priority is kept
+     * @param simulator running the current simulation
+     * @param job checkpointed
+     */
+    virtual void requeueJob(AbstractSimulator *simulator, AbstractJob *job);
+
+    /**
+     * Start the selection of the week-end planner on the free nodes (see WeekendPlanner::select). A job whose
+     * nodes were taken by the jobs started before it is left waiting.
+     * @param simulator running the current simulation
+     * @param weekendBegins whether the huge jobs left waiting count a skipped week-end
+     * @return the number of jobs started
+     */
+    int packWeekend(AbstractSimulator *simulator, bool weekendBegins);
+
+    /**
+     * Start jobs on the nodes left idle before the week-end cut-off, when the next job can not end before it.
+     * The job of each queue with the longest walltime ending in time on the free nodes it may use is found
+     * through the walltime index of the queue, and the one using the most node-hours is started, until none fits.
+     * The gpu jobs are only started this way when the next gpu job can not end before the cut-off.
+     * @param simulator running the current simulation
+     * @return the number of jobs started
+     */
+    int fillBeforeWeekend(AbstractSimulator *simulator);
+
+    /**
+     * Move free nodes between the normal nodes and the partitions reserved for small and medium jobs, as decided
+     * by the partition controller once its period has elapsed. The nodes moved are then given to partitionsResized.
+     * @param simulator running the current simulation
+     * @return the number of nodes moved
+     */
+    int resizePartitions(AbstractSimulator *simulator);
+
+    /**
+     * Called once free nodes moved to another class when the partitions are resized. By default the nodes are
+     * released in their new class, which tries to start the next jobs.
+     * @param simulator running the current simulation
+     * @param nodes moved, in their new class
+     */
+    virtual void partitionsResized(AbstractSimulator *simulator, const std::vector<Node *> &nodes) {
+        releaseNodes(simulator, nodes);
+    };
+
+    /**
+     * Called once the nodes of a reservation are taken or given back. By default the scheduler tries to start
+     * the jobs waiting.
+     * @param simulator running the current simulation
+     */
+    virtual void reservationsChanged(AbstractSimulator *simulator) { tryToExecuteNextJobs(simulator); };
+
+    /**
+     * Called once the completion of a running job moved, because the job runs slower on the racks it was given
+     * or because the jobs sharing the file system changed
+     * @param simulator running the current simulation
+     * @param job running
+     * @param previousTime at which the job was expected to complete
+     */
+    virtual void completionMoved(AbstractSimulator *, AbstractJob *, double) {};
+
+    /**
+     * Return the classes of nodes a job may run on, in order of preference
+     * @param job waiting in a queue
+     * @param isNextJob whether the job has the highest priority, only this job may use the gpu nodes
+     * if it does not need a gpu
+     * @return
+     */
+    static const std::vector<NodeClass> &nodeClassesFor(AbstractJob *job, bool isNextJob);
+
+    /**
+     * Return whether a job started at the time passed as parameter ends before the week-end cut-off,
+     * given its walltime. With preemption any job started during the week qualifies.
+     * @param job
+     * @param time
+     * @return
+     */
+    bool endsBeforeWeekend(AbstractJob *job, double time) const;
+
+    /**
+     * Add a job to the queue of its type, without trying to start it
+     * @param job
+     */
+    void addWaitingJob(AbstractJob *job);
+
+    /**
+     * Change the priority of a job waiting in the queue of its type
+     * @param job waiting in a queue
+     * @param priority new priority of the job
+     */
+    void setWaitingJobPriority(AbstractJob *job, double priority);
+
+    /**
+     * Remove a job from the queue of its type
+     * @param job waiting in a queue
+     */
+    void removeWaitingJob(AbstractJob *job);
+
+    /**
+     * Return the non huge jobs waiting in the queues, by decreasing priority.
+     * On equal priorities the order is the one of nextJob : gpu, medium, large, small
+     * @param withGpuJobs whether the gpu jobs are included
+     * @return
+     */
+    std::vector<AbstractJob *> waitingJobsByPriority(bool withGpuJobs = true);
 
 public:
 
@@ -128,6 +471,101 @@ public:
     */
     virtual ~AbstractScheduler();
 
+    /**
+     * Select the huge jobs started during the week-end with a planner, which is then owned by the scheduler
+     * @param planner
+     */
+    void setWeekendPlanner(WeekendPlanner *planner);
+
+    /**
+     * Resize the partitions of reserved nodes with a controller, which is then owned by the scheduler
+     * @param controller
+     */
+    void setPartitionController(PartitionController *controller);
+
+    /**
+     * Let the jobs run into the week-end, they are checkpointed when huge jobs need their nodes
+     * @param overhead hours added to the remaining duration of a checkpointed job
+     */
+    void enablePreemption(double overhead);
+
+    /**
+     * Let the small jobs use some cores of a node, the schedulers which support it put several of them on
+     * the same node
+     */
+    void enableCoreSharing() { coreSharing = true; };
+
+    /**
+     * Return whether the small jobs submitted use some cores of a node
+     * @return
+     */
+    bool isSharingCores() const { return coreSharing; };
+
+    /**
+     * Describe the racks of the platform
+     * @param numberOfNodes in each rack, made of consecutive node ids
+     * @param penalty share of its duration by which a job runs longer for each rack it spans after the first
+     * @param compactPlacement whether the nodes of a job are allocated in as few racks as possible,
+     * instead of by increasing id
+     */
+    void setTopology(int numberOfNodes, double penalty, bool compactPlacement);
+
+    /**
+     * Let the large and huge jobs start on fewer nodes than they require, the schedulers which support it
+     * choose their number of nodes when they start
+     */
+    void enableMolding() { molding = true; };
+
+    /**
+     * Return whether the large and huge jobs submitted are moldable
+     * @return
+     */
+    bool isMoldingJobs() const { return molding; };
+
+    /**
+     * Limit the bandwidth of the filesystem, the jobs doing I/O run slower when they ask for more
+     * @param bandwidth in units used by a node doing I/O all the time
+     */
+    void setFilesystemBandwidth(double bandwidth);
+
+    /**
+     * Return whether the jobs submitted do I/O and compete for the filesystem
+     * @return
+     */
+    bool isModelingIo() const { return ioContention != nullptr; };
+
+    /**
+     * Stop the I/O of a job which completes or is checkpointed now. Its execution duration is lengthened by
+     * the time it lost waiting for the filesystem and the jobs still running are rescheduled.
+     * @param simulator running the current simulation
+     * @param job running
+     * @return the duration of execution done since the job started, when it runs alone
+     */
+    double stopIo(AbstractSimulator *simulator, AbstractJob *job);
+
+    /**
+     * Book nodes in advance with a calendar of reservations, which is then owned by the scheduler.
+     * The reservations begin and end with ReservationBegin and ReservationEnd events.
+     * @param calendar
+     */
+    void setReservationCalendar(ReservationCalendar *calendar);
+
+    /**
+     * Take the nodes of a reservation beginning now : with preemption the jobs running on them are checkpointed,
+     * otherwise their nodes join the reservation when they complete. The free nodes are kept until the
+     * reservation ends.
+     * @param simulator running the current simulation
+     * @param reservation of the calendar
+     */
+    void beginReservation(AbstractSimulator *simulator, const Reservation &reservation);
+
+    /**
+     * Give back the nodes of a reservation ending now, except those another reservation keeps
+     * @param simulator running the current simulation
+     * @param reservation of the calendar
+     */
+    void endReservation(AbstractSimulator *simulator, const Reservation &reservation);
+
     /**
      * add a free node to the list of free nodes kept by the scheduler
      * Try to trigger the next job without GPU requirement according to week-end cut-off
@@ -142,7 +580,7 @@ public:
      * @param simulator running the current simulation
      * @param node to add
      */
-    virtual void addFreeMediumNode(AbstractSimulator *simulator, ReservedForMediumJobNode *node) = 0;
+    virtual void addFreeMediumNode(AbstractSimulator *simulator, Node *node) = 0;
 
     /**
      * add a free node reserved for small job to the list of free nodes kept by the scheduler
@@ -150,7 +588,7 @@ public:
      * @param simulator running the current simulation
      * @param node to add
      */
-    virtual void addFreeSmallNode(AbstractSimulator *simulator, ReservedForSmallJobNode *node) = 0;
+    virtual void addFreeSmallNode(AbstractSimulator *simulator, Node *node) = 0;
 
     /**
      * add a free node equipped with Gpu to the list of free nodes kept by the scheduler
@@ -210,11 +648,33 @@ public:
      */
     virtual void tryToExecuteNextJobs(AbstractSimulator *pSimulator) = 0;
 
+    /**
+     * Return the next non-gpu Job
+     * @return
+     */
+    AbstractJob *nextNonGpuJob() { return nextJobIndex.nextNonGpuJob(); };
+
+    /**
+     * Return the next job including gpu jobs
+     * @return
+     */
+    AbstractJob *nextJob() { return nextJobIndex.nextJob(); };
+
     /**
      * Return the total of non-huge job waiting in the different queues
      * @return
      */
-    int totalOfNonHugeJobsWaiting();
+    virtual int totalOfNonHugeJobsWaiting();
+
+    /**
+     * Called by the JobCompletion event of a job : the job is no more running and its nodes are released.
+     * The nodes still used by other jobs stay shared, the next small job is tried on the cores freed.
+     * The partitions of reserved nodes are then resized if the period of the controller has elapsed.
+     * @param simulator running the current simulation
+     * @param job completed
+     * @param nodes of the job
+     */
+    void completeJob(AbstractSimulator *simulator, AbstractJob *job, const std::vector<Node *> &nodes);
 };
 
 
@@ -224,6 +684,15 @@ public:
  */
 class Scheduler : public AbstractScheduler {
 
+protected:
+    /**
+     * Give the nodes of a completed job back one after the other, then fill the nodes left idle
+     * before the week-end cut-off
+     * @param simulator running the current simulation
+     * @param nodes of the completed job
+     */
+    void releaseNodes(AbstractSimulator *simulator, const std::vector<Node *> &nodes) override;
+
 public:
 
     Scheduler();
@@ -248,24 +717,12 @@ public:
 
     void addFreeNode(AbstractSimulator *simulator, Node *node);
 
-    void addFreeMediumNode(AbstractSimulator *simulator, ReservedForMediumJobNode *node);
+    void addFreeMediumNode(AbstractSimulator *simulator, Node *node);
 
-    void addFreeSmallNode(AbstractSimulator *simulator, ReservedForSmallJobNode *node);
+    void addFreeSmallNode(AbstractSimulator *simulator, Node *node);
 
     void addFreeGpuNode(AbstractSimulator *simulator, GpuNode *node);
 
-    /**
-     * Return the next non-gpu Job
-     * @return
-     */
-    AbstractJob *nextNonGpuJob();
-
-    /**
-     * Return the next job including gpu jobs
-     * @return
-     */
-    AbstractJob *nextJob();
-
     void insertMediumJob(AbstractSimulator *simulator, MediumJob *job);
 
     void insertSmallJob(AbstractSimulator *simulator, SmallJob *job);
@@ -287,6 +744,21 @@ public:
  */
 bool isDuringWeekend(double time);
 
+/**
+ * Return the number of hours left before the next week-end, Friday 5PM, with the same assumption as isDuringWeekend
+ * @param time
+ * @return 0 during the week-end
+ */
+double hoursUntilNextWeekend(double time);
+
+/**
+ * Return the number of hours left before the next monday 9 AM, when the week-end ends, with the same assumption
+ * as isDuringWeekend
+ * @param time
+ * @return a whole week on monday 9 AM
+ */
+double hoursUntilMonday(double time);
+
 /**
  * This function allows us to compare two job pointers according to their submitting time.
  * The one with the lowest submission time is (for the FIFO scheduler) the one with the highest
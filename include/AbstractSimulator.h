@@ -1,8 +1,11 @@
 
 #pragma once
 
+#include <functional>
 #include <iostream>
 #include <string>
+#include <vector>
+#include "Tracer.h"
 /*=================USED AS IS FROM C++ EXERCISE ON PATIENT SIMULATOR =============================*/
 // excepted for the addition of the method for AbstractSimulator returning the size of the event queue//
 using namespace std;
@@ -33,6 +36,15 @@ public:
 
     virtual Comparable *remove(Comparable *x) = 0;
 
+    /**
+     * Move elements of the set : they are taken out, changed by the function passed as parameter, which may change
+     * their order, and put back as if inserted again in the order in which they are passed.
+     * By default each element is removed then inserted.
+     * @param xs elements in the set
+     * @param change applied to each element while it is out of the set
+     */
+    virtual void update(const std::vector<Comparable *> &xs, const std::function<void(Comparable *)> &change);
+
     virtual ~OrderedSet() {}
 };
 
@@ -40,11 +52,29 @@ public:
 class AbstractSimulator {
 protected:
     OrderedSet *events;
+    /**
+     * Trace of what the events are doing
+     */
+    Tracer tracer;
 public:
     AbstractSimulator();
 
     void insert(AbstractEvent *e);
 
+    /**
+     * Remove an event which has not been executed yet, the event is not deleted
+     * @param e
+     * @return false if the event is not waiting
+     */
+    bool remove(AbstractEvent *e);
+
+    /**
+     * Change the time of events which have not been executed yet, in bulk (see OrderedSet::update)
+     * @param events waiting
+     * @param change applied to each event while it is out of the event calendar
+     */
+    void update(const std::vector<Comparable *> &events, const std::function<void(Comparable *)> &change);
+
     virtual void doAllEvents() = 0;
 
     virtual double now() = 0;
@@ -52,5 +82,7 @@ public:
     virtual ~AbstractSimulator();
 
     int eventsSize();
+
+    Tracer &getTracer() { return tracer; }
 };
 
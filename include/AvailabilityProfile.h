@@ -0,0 +1,99 @@
+#ifndef SUPERCOMPUTERSIMULATION_AVAILABILITYPROFILE_H
+#define SUPERCOMPUTERSIMULATION_AVAILABILITYPROFILE_H
+
+#include <array>
+#include <map>
+#include <vector>
+#include "FreeNodePool.h"
+
+/**
+ * Number of nodes of each class, indexed by NodeClass
+ */
+typedef std::array<int, NumberOfNodeClasses> NodeCounts;
+
+/**
+ * Number of free nodes of each class over time, as a step function : every step gives the free nodes
+ * from its time until the time of the next step, the last step lasts forever.
+ * Reserving nodes for a job splits the steps at the start and at the end of the job, and the steps
+ * in the past are dropped as the simulation advances, so that the profile only holds the times at
+ * which running or reserved jobs end.
+ */
+class AvailabilityProfile {
+private:
+    /**
+     * Free nodes of each class, by time from which they are free
+     */
+    std::map<double, NodeCounts> steps;
+
+    /**
+     * Make sure that a step begins at the time passed as parameter
+     * @param time
+     * @return the step beginning at this time
+     */
+    std::map<double, NodeCounts>::iterator split(double time);
+
+    /**
+     * Remove the step passed as parameter if it does not change the number of free nodes
+     * @param step
+     */
+    void merge(std::map<double, NodeCounts>::iterator step);
+
+public:
+    /**
+     * Remove all the steps, no node is free anymore
+     */
+    void clear() { steps.clear(); };
+
+    /**
+     * Change the number of free nodes of a class during an interval
+     * @param from beginning of the interval
+     * @param until end of the interval, excluded, can be infinite
+     * @param nodeClass
+     * @param numberOfNodes added, negative for removing nodes
+     */
+    void add(double from, double until, NodeClass nodeClass, int numberOfNodes);
+
+    /**
+     * Remove the nodes passed as parameter from the free nodes during an interval
+     * @param from beginning of the interval
+     * @param until end of the interval, excluded
+     * @param nodes number of nodes of each class
+     */
+    void reserve(double from, double until, const NodeCounts &nodes);
+
+    /**
+     * Forget the free nodes before the time passed as parameter
+     * @param time
+     */
+    void advanceTo(double time);
+
+    /**
+     * Find the earliest time from which enough nodes are free during the duration passed as parameter.
+     * The nodes are taken in the order of the classes, the same number of nodes of each class during
+     * the whole duration.
+     * @param from earliest time accepted
+     * @param duration during which the nodes must be free
+     * @param numberOfNodes required
+     * @param nodeClasses the nodes may belong to, in order of preference
+     * @param nodes filled with the number of nodes taken in each class
+     * @return the time found, infinity if the nodes will never be free
+     */
+    double earliestFit(double from, double duration, int numberOfNodes, const std::vector<NodeClass> &nodeClasses,
+                       NodeCounts &nodes) const;
+
+    /**
+     * Return the number of free nodes of a class at the time passed as parameter
+     * @param time
+     * @param nodeClass
+     * @return
+     */
+    int freeAt(double time, NodeClass nodeClass) const;
+
+    /**
+     * Return the number of steps of the profile
+     * @return
+     */
+    size_t size() const { return steps.size(); };
+};
+
+#endif //SUPERCOMPUTERSIMULATION_AVAILABILITYPROFILE_H
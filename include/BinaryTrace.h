@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * Kinds of the records of a binary trace
+ */
+enum TraceRecordKind : int32_t {
+    RecordJobSubmit = 0,
+    RecordJobStart = 1,
+    RecordJobFinish = 2,
+    RecordNodeFree = 3,
+    RecordWeekendBegin = 4,
+    RecordWeekendEnd = 5
+};
+
+/**
+ * Return the name of a kind of record, "unknown" if the kind is not valid
+ * @param kind
+ * @return
+ */
+const char *recordKindName(int32_t kind);
+
+/**
+ * A record of the binary trace. Every record has the same size so that a trace can be read
+ * or indexed without parsing. The fields which do not apply to a kind of record are set to -1.
+ */
+struct BinaryTraceRecord {
+    /**
+     * Time of the event in hours since the beginning of the simulation
+     */
+    double time;
+    /**
+     * Execution duration of the job
+     */
+    double duration;
+    /**
+     * Time at which the job has been submitted
+     */
+    double submittingTime;
+    int32_t kind;
+    int32_t jobId;
+    int32_t userId;
+    /**
+     * Index of the type of the job : 0 small, 1 medium, 2 large, 3 huge, 4 gpu
+     */
+    int32_t jobType;
+    int32_t numberOfNodes;
+    int32_t nodeId;
+
+    /**
+     * Return a record without job, e.g. for the weekend boundaries
+     * @param kind
+     * @param time
+     * @return
+     */
+    static BinaryTraceRecord event(TraceRecordKind kind, double time) {
+        return BinaryTraceRecord{time, -1, -1, kind, -1, -1, -1, -1, -1};
+    }
+};
+
+static_assert(sizeof(BinaryTraceRecord) == 48, "the binary trace records must keep a fixed size");
+
+/**
+ * Header at the beginning of a binary trace file. The values are written in the byte order
+ * of the machine running the simulation.
+ */
+struct BinaryTraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+};
+
+/**
+ * Write the records of a binary trace to a file through a large buffer
+ */
+class BinaryTraceWriter {
+private:
+    std::ofstream file;
+    std::vector<BinaryTraceRecord> buffer;
+    size_t numberOfBufferedRecords = 0;
+
+public:
+    static const uint32_t version = 1;
+    static const size_t bufferedRecords = 1 << 16;
+
+    explicit BinaryTraceWriter(const std::string &filename);
+
+    BinaryTraceWriter(const BinaryTraceWriter &writer) = delete;
+
+    BinaryTraceWriter &operator=(const BinaryTraceWriter &writer) = delete;
+
+    /**
+     * Flush the buffer and close the file
+     */
+    ~BinaryTraceWriter();
+
+    bool isOpen() const { return file.is_open(); };
+
+    void write(const BinaryTraceRecord &record) {
+        buffer[numberOfBufferedRecords++] = record;
+        if (numberOfBufferedRecords == buffer.size()) {
+            flush();
+        }
+    }
+
+    /**
+     * Write the buffered records to the file
+     */
+    void flush();
+};
+
+/**
+ * Read the records of a binary trace file
+ */
+class BinaryTraceReader {
+private:
+    std::ifstream file;
+    bool valid = false;
+
+public:
+    /**
+     * Open the file and check its header
+     * @param filename
+     */
+    explicit BinaryTraceReader(const std::string &filename);
+
+    /**
+     * Return true if the file is a binary trace of a version which can be read
+     * @return
+     */
+    bool isValid() const { return valid; };
+
+    /**
+     * Read the next record
+     * @param record
+     * @return false at the end of the trace
+     */
+    bool read(BinaryTraceRecord &record);
+};
@@ -0,0 +1,109 @@
+#ifndef SUPERCOMPUTERSIMULATION_CALENDARQUEUE_H
+#define SUPERCOMPUTERSIMULATION_CALENDARQUEUE_H
+
+#include <vector>
+#include "Simulator.h"
+
+/**
+ * This class implements the event calendar as a calendar queue (R. Brown, 1988).
+ * Events are spread in buckets, each bucket covering a "day" of the calendar of
+ * bucketWidth hours. The buckets are visited in turn as the simulation time advances,
+ * so insertion and removal of the first event cost O(1) in average as long as the
+ * width of a day is adapted to the spacing of the events. The number of buckets and
+ * their width are re-evaluated when the number of events is doubled or halved.
+ *
+ * Unlike the other queues, the calendar queue needs to know the time of the elements:
+ * it can only hold Events and the time of an event shall not be modified while it is
+ * in the queue. Equal events are returned in the same order as the ListQueue would,
+ * ie. the most recently inserted one first.
+ */
+class CalendarQueue : public OrderedSet {
+private:
+    /**
+     * An event of the calendar with its time and its insertion number used to break ties
+     */
+    struct Entry {
+        Comparable *element;
+        double time;
+        unsigned long insertionNumber;
+    };
+
+    /**
+     * Each bucket is sorted so that its last entry is the first to be removed
+     */
+    std::vector<std::vector<Entry>> buckets;
+
+    /**
+     * Duration covered by one bucket
+     */
+    double bucketWidth = 1;
+
+    /**
+     * Index of the day currently visited since the beginning of the simulation.
+     * The bucket of this day is currentDay modulo the number of buckets.
+     */
+    long currentDay = 0;
+
+    /**
+     * Number of events in the calendar
+     */
+    int numberOfEvents = 0;
+
+    /**
+     * Incremented at each insertion
+     */
+    unsigned long insertionCounter = 0;
+
+    /**
+     * Minimal number of buckets, the calendar is never shrunk below this size
+     */
+    static const size_t minimumNumberOfBuckets = 16;
+
+    /**
+     * Number of events used to estimate the bucket width when resizing
+     */
+    static const size_t widthSampleSize = 25;
+
+    /**
+     * Return true if the entry a shall be removed before the entry b
+     */
+    static bool before(const Entry &a, const Entry &b);
+
+    /**
+     * Return the index of the day in which the time falls
+     */
+    long dayOf(double time) const;
+
+    /**
+     * Return the bucket holding the events of the given day
+     */
+    std::vector<Entry> &bucketOf(long day);
+
+    /**
+     * Insert an entry in its bucket without resizing the calendar
+     */
+    void insertEntry(const Entry &entry);
+
+    /**
+     * Change the number of buckets and re-estimate their width from the next events
+     * @param newNumberOfBuckets
+     */
+    void resize(size_t newNumberOfBuckets);
+
+public:
+    CalendarQueue();
+
+    CalendarQueue(const CalendarQueue &queue) = delete;
+
+    CalendarQueue &operator=(const CalendarQueue &queue) = delete;
+
+    void insert(Comparable *x) override;
+
+    Comparable *removeFirst() override;
+
+    Comparable *remove(Comparable *x) override;
+
+    int size() override;
+};
+
+#endif //SUPERCOMPUTERSIMULATION_CALENDARQUEUE_H
@@ -0,0 +1,192 @@
+#ifndef SUPERCOMPUTERSIMULATION_CONSERVATIVEBACKFILLSCHEDULER_H
+#define SUPERCOMPUTERSIMULATION_CONSERVATIVEBACKFILLSCHEDULER_H
+
+#include <unordered_map>
+#include "AbstractScheduler.h"
+#include "AvailabilityProfile.h"
+
+/**
+ * This class derived from Abstract Scheduler and implements conservative backfilling.
+ * Every job gets a reservation when it is submitted : the earliest time at which enough nodes are free
+ * for its whole duration, given the running jobs and the reservations of the jobs submitted before it.
+ * A job can therefore start before jobs with a higher priority, but never delays them.
+ * The week-end cut-off is kept : no reservation lets a job run during the week-end.
+ */
+class ConservativeBackfillScheduler : public AbstractScheduler {
+private:
+    /**
+     * Nodes reserved for a waiting job
+     */
+    struct Reservation {
+        AbstractJob *job;
+        NodeCounts nodes;
+    };
+
+    /**
+     * Free nodes of each class over time, once the running jobs and the reservations are taken into account
+     */
+    AvailabilityProfile profile;
+
+    /**
+     * Reservations of the waiting jobs, by start time
+     */
+    std::multimap<double, Reservation> reservations;
+
+    /**
+     * Reservation of each waiting job which has one
+     */
+    std::unordered_map<const AbstractJob *, std::multimap<double, Reservation>::iterator> reservationOf;
+
+    /**
+     * Number of times reservations were cancelled to be made again, by rebook or replan
+     */
+    unsigned long numberOfRebookings = 0;
+
+    /**
+     * Whether jobs started or checkpointed during the week-end left nodes which the reservations do not use
+     */
+    bool reservationsOutdated = false;
+
+    /**
+     * Reserve nodes for a waiting job at the earliest time it fits without running during the week-end
+     * @param simulator running the current simulation
+     * @param job waiting in a queue
+     */
+    void reserve(AbstractSimulator *simulator, AbstractJob *job);
+
+    /**
+     * Build the profile again from the free and running nodes, and reserve nodes again for every waiting
+     * job by decreasing priority. This is needed when jobs are checkpointed.
+     * @param simulator running the current simulation
+     */
+    void replan(AbstractSimulator *simulator);
+
+    /**
+     * Reserve nodes again for the waiting jobs whose reservation overlaps an interval, in which fewer nodes
+     * are free than when they were reserved. The other reservations are kept.
+     * @param simulator running the current simulation
+     * @param from beginning of the interval
+     * @param until end of the interval
+     */
+    void rebook(AbstractSimulator *simulator, double from, double until);
+
+    /**
+     * Move the time from which the nodes of a job are free in the profile. The reservations overlapping
+     * the hours between both ends are made again.
+     * @param simulator running the current simulation
+     * @param nodes of the job, of each class
+     * @param previousEnd of the job in the profile
+     * @param end of the job
+     */
+    void moveEnd(AbstractSimulator *simulator, const NodeCounts &nodes, double previousEnd, double end);
+
+    /**
+     * Start the jobs whose reservation begins now. A job waiting for its nodes past its reservation ends later
+     * than reserved.
+     * @param simulator running the current simulation
+     */
+    void schedule(AbstractSimulator *simulator);
+
+    /**
+     * Add a free node, free from now on, and schedule
+     * @param simulator running the current simulation
+     * @param nodeClass of the node
+     * @param node to add
+     */
+    void addFreeNodeOfClass(AbstractSimulator *simulator, NodeClass nodeClass, Node *node);
+
+protected:
+    /**
+     * Add all the nodes of a completed job to the free nodes, then schedule once.
+     * The profile already counts them as free from now on.
+     * @param simulator running the current simulation
+     * @param nodes of the completed job
+     */
+    void releaseNodes(AbstractSimulator *simulator, const std::vector<Node *> &nodes) override;
+
+    /**
+     * Start a job outside of the reservations, a huge job or a job selected by the week-end planner : its
+     * reservation is cancelled and its nodes are taken from the profile until it ends. Only the reservations
+     * overlapping it are made again, the others are made again once when the week-end ends.
+     * @param simulator running the current simulation
+     * @param job to start
+     * @param nodes allocated to the job
+     */
+    void startJob(AbstractSimulator *simulator, AbstractJob *job, const std::vector<Node *> &nodes) override;
+
+    /**
+     * Reserve nodes for a checkpointed job. Its nodes stay taken in the profile until the reservations are
+     * made again.
+     * @param simulator running the current simulation
+     * @param job checkpointed
+     */
+    void requeueJob(AbstractSimulator *simulator, AbstractJob *job) override;
+
+    /**
+     * Free the nodes of the job in the profile from its new completion time
+     * @param simulator running the current simulation
+     * @param job running
+     * @param previousTime at which the job was expected to complete
+     */
+    void completionMoved(AbstractSimulator *simulator, AbstractJob *job, double previousTime) override;
+
+    /**
+     * Add the nodes moved to the free nodes in their new class. The profile still counts them in their former
+     * class : it is built again before scheduling.
+     * @param simulator running the current simulation
+     * @param nodes moved, in their new class
+     */
+    void partitionsResized(AbstractSimulator *simulator, const std::vector<Node *> &nodes) override;
+
+    /**
+     * The profile is built again without the reserved nodes, or with the nodes given back
+     * @param simulator running the current simulation
+     */
+    void reservationsChanged(AbstractSimulator *simulator) override {
+        replan(simulator);
+        schedule(simulator);
+    };
+
+public:
+    ConservativeBackfillScheduler() = default;
+
+    //removing the copy constructor
+    ConservativeBackfillScheduler(const ConservativeBackfillScheduler &scheduler) = delete;
+
+    //removing the  equal operator
+    ConservativeBackfillScheduler &operator=(const ConservativeBackfillScheduler &scheduler) = delete;
+
+    void tryToExecuteNextLargeJob(AbstractSimulator *simulator) override;
+
+    void tryToExecuteNextMediumJob(AbstractSimulator *simulator) override;
+
+    void tryToExecuteNextSmallJob(AbstractSimulator *simulator) override;
+
+    void tryToExecuteNextHugeJobs(AbstractSimulator *simulator) override;
+
+    void tryToExecuteNextGpuJob(AbstractSimulator *simulator) override;
+
+    void tryToExecuteNextNonGpuJobShortEnough(AbstractSimulator *simulator) override;
+
+    void addFreeNode(AbstractSimulator *simulator, Node *node) override;
+
+    void addFreeMediumNode(AbstractSimulator *simulator, Node *node) override;
+
+    void addFreeSmallNode(AbstractSimulator *simulator, Node *node) override;
+
+    void addFreeGpuNode(AbstractSimulator *simulator, GpuNode *node) override;
+
+    void insertMediumJob(AbstractSimulator *simulator, MediumJob *job) override;
+
+    void insertSmallJob(AbstractSimulator *simulator, SmallJob *job) override;
+
+    void insertLargeJob(AbstractSimulator *simulator, LargeJob *job) override;
+
+    void insertGpuJob(AbstractSimulator *simulator, GpuJob *job) override;
+
+    void insertHugeJob(AbstractSimulator *simulator, HugeJob *job) override;
+
+    void tryToExecuteNextJobs(AbstractSimulator *pSimulator) override;
+};
+
+#endif //SUPERCOMPUTERSIMULATION_CONSERVATIVEBACKFILLSCHEDULER_H
@@ -0,0 +1,91 @@
+#ifndef SUPERCOMPUTERSIMULATION_EASYBACKFILLSCHEDULER_H
+#define SUPERCOMPUTERSIMULATION_EASYBACKFILLSCHEDULER_H
+
+#include "AbstractScheduler.h"
+
+/**
+ * This class derived from Abstract Scheduler and implements EASY backfilling.
+ * The jobs are started by priority, as with the FIFO scheduler, until the job with the highest priority
+ * does not fit. This job gets a reservation at the earliest time enough running jobs will have completed
+ * (the shadow time), and the jobs behind it are started out of order as long as they do not delay it :
+ * they either complete before the shadow time or only use the nodes it will not need.
+ * The week-end cut-off is kept : no job is started if it could still be running during the week-end.
+ */
+class EasyBackfillScheduler : public AbstractScheduler {
+private:
+    /**
+     * Return how many nodes of the given classes a job would take from the free nodes,
+     * taking them in order of preference
+     * @param job
+     * @param nodeClasses the job may run on
+     * @param reservedClasses the classes of nodes counted
+     * @return
+     */
+    int nodesTakenFrom(AbstractJob *job, const std::vector<NodeClass> &nodeClasses,
+                       const std::vector<NodeClass> &reservedClasses) const;
+
+    /**
+     * Remove a waiting job from its queue and start it on free nodes of the given classes
+     * @param simulator running the current simulation
+     * @param job to start, there must be enough free nodes for it
+     * @param nodeClasses the job may run on
+     */
+    void startWaitingJob(AbstractSimulator *simulator, AbstractJob *job, const std::vector<NodeClass> &nodeClasses);
+
+    /**
+     * Start the next jobs while they fit, then backfill the jobs which do not delay the next job
+     * @param simulator running the current simulation
+     */
+    void schedule(AbstractSimulator *simulator);
+
+protected:
+    /**
+     * Add all the nodes of a completed job to the free nodes, then schedule once
+     * @param simulator running the current simulation
+     * @param nodes of the completed job
+     */
+    void releaseNodes(AbstractSimulator *simulator, const std::vector<Node *> &nodes) override;
+
+public:
+    EasyBackfillScheduler() = default;
+
+    //removing the copy constructor
+    EasyBackfillScheduler(const EasyBackfillScheduler &scheduler) = delete;
+
+    //removing the  equal operator
+    EasyBackfillScheduler &operator=(const EasyBackfillScheduler &scheduler) = delete;
+
+    void tryToExecuteNextLargeJob(AbstractSimulator *simulator) override;
+
+    void tryToExecuteNextMediumJob(AbstractSimulator *simulator) override;
+
+    void tryToExecuteNextSmallJob(AbstractSimulator *simulator) override;
+
+    void tryToExecuteNextHugeJobs(AbstractSimulator *simulator) override;
+
+    void tryToExecuteNextGpuJob(AbstractSimulator *simulator) override;
+
+    void tryToExecuteNextNonGpuJobShortEnough(AbstractSimulator *simulator) override;
+
+    void addFreeNode(AbstractSimulator *simulator, Node *node) override;
+
+    void addFreeMediumNode(AbstractSimulator *simulator, Node *node) override;
+
+    void addFreeSmallNode(AbstractSimulator *simulator, Node *node) override;
+
+    void addFreeGpuNode(AbstractSimulator *simulator, GpuNode *node) override;
+
+    void insertMediumJob(AbstractSimulator *simulator, MediumJob *job) override;
+
+    void insertSmallJob(AbstractSimulator *simulator, SmallJob *job) override;
+
+    void insertLargeJob(AbstractSimulator *simulator, LargeJob *job) override;
+
+    void insertGpuJob(AbstractSimulator *simulator, GpuJob *job) override;
+
+    void insertHugeJob(AbstractSimulator *simulator, HugeJob *job) override;
+
+    void tryToExecuteNextJobs(AbstractSimulator *pSimulator) override;
+};
+
+#endif //SUPERCOMPUTERSIMULATION_EASYBACKFILLSCHEDULER_H
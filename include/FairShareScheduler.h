@@ -0,0 +1,141 @@
+#ifndef SUPERCOMPUTERSIMULATION_FAIRSHARESCHEDULER_H
+#define SUPERCOMPUTERSIMULATION_FAIRSHARESCHEDULER_H
+
+#include <deque>
+#include <set>
+#include "AbstractScheduler.h"
+#include "FairShareUsage.h"
+#include "HPCSimulator.h"
+#include "SchedulerRegistry.h"
+
+/**
+ * This class derived from the FIFO Scheduler and orders the queues by fair-share instead of submission time :
+ * the less node-hours a user and its group or curriculum have recently used, the higher the priority of its
+ * jobs. The usage is charged when a job starts and decays exponentially with time.
+ * Only the oldest waiting job of each user and type of job is in the queues, the others wait behind it.
+ * Since the decay keeps the order of the users, charging a user only changes the priority of the jobs in the
+ * queues of this user and of the other members of its group or curriculum, each in O(log n).
+ */
+class FairShareScheduler : public Scheduler {
+private:
+    /**
+     * Waiting jobs of a user, by type of job : small, medium, large, huge, gpu
+     */
+    struct UserJobs {
+        /**
+         * Job of the user in the queue of each type, the huge jobs are all in their queue
+         */
+        AbstractJob *queued[5] = {nullptr, nullptr, nullptr, nullptr, nullptr};
+        /**
+         * Jobs of the user waiting behind the one in the queue, in order of submission
+         */
+        std::deque<AbstractJob *> held[5];
+        /**
+         * Huge jobs of the user in the queue
+         */
+        std::set<AbstractJob *, JobIdOrder> hugeJobs;
+    };
+
+    std::map<const User *, UserJobs> jobsByUser;
+    /**
+     * Number of non huge jobs waiting behind the jobs in the queues
+     */
+    int numberOfHeldJobs = 0;
+    /**
+     * Users having submitted jobs, by group
+     */
+    std::map<const Group *, std::set<const User *>> groupMembers;
+    /**
+     * Users having submitted jobs, by curriculum
+     */
+    std::map<const Curriculum *, std::set<const User *>> curriculumMembers;
+
+    /**
+     * Give its priority to a submitted job, or hold it if a job of its user and type is queued
+     * @param job
+     * @param time of submission
+     * @return true if the job has to be added to its queue
+     */
+    bool submit(AbstractJob *job, double time);
+
+protected:
+    FairShareUsage usage;
+
+    /**
+     * Return the priority of a job of a user, computed when the job is queued and when the usage of the user
+     * changes. By default the less the usage of the user the higher the priority.
+     * @param job
+     * @param time at which the priority is computed
+     * @return
+     */
+    virtual double priorityOf(AbstractJob *job, double time);
+
+    /**
+     * Compute again the priority of every queued job of a user
+     * @param user
+     * @param time
+     */
+    void updatePriorities(const User *user, double time);
+
+    /**
+     * Compute again the priority of every queued job
+     * @param time
+     */
+    void updateAllPriorities(double time);
+
+    /**
+     * Charge node-hours to a user and update the priorities of the waiting jobs of its account,
+     * or of every user if the usage had to be rebased
+     * @param user
+     * @param nodeHours charged, negative to give back node-hours which have not been used
+     * @param time
+     */
+    void chargeUsage(const User *user, double nodeHours, double time);
+
+    /**
+     * Start a job, charge its node-hours to its user and queue the next job of the user of the same type
+     * @param simulator running the current simulation
+     * @param job to start
+     * @param nodes allocated to the job
+     */
+    void startJob(AbstractSimulator *simulator, AbstractJob *job, const std::vector<Node *> &nodes) override;
+
+    /**
+     * Requeue a checkpointed job as the queued job of its user and type, the job queued until now is held
+     * again. The node-hours charged for the part of the job which did not run are given back.
+     * @param simulator running the current simulation
+     * @param job checkpointed
+     */
+    void requeueJob(AbstractSimulator *simulator, AbstractJob *job) override;
+
+public:
+    /**
+     * @param parameters halfLife of the usage in hours (one week by default), userWeight and accountWeight
+     * the weights of the usage of the user and of its group or curriculum (1 by default)
+     */
+    explicit FairShareScheduler(const SchedulerParameters &parameters);
+
+    //removing the copy constructor
+    FairShareScheduler(const FairShareScheduler &scheduler) = delete;
+
+    //removing the  equal operator
+    FairShareScheduler &operator=(const FairShareScheduler &scheduler) = delete;
+
+    void insertMediumJob(AbstractSimulator *simulator, MediumJob *job) override;
+
+    void insertSmallJob(AbstractSimulator *simulator, SmallJob *job) override;
+
+    void insertLargeJob(AbstractSimulator *simulator, LargeJob *job) override;
+
+    void insertGpuJob(AbstractSimulator *simulator, GpuJob *job) override;
+
+    void insertHugeJob(AbstractSimulator *simulator, HugeJob *job) override;
+
+    /**
+     * Return the total of non-huge job waiting, in the queues or behind them
+     * @return
+     */
+    int totalOfNonHugeJobsWaiting() override;
+};
+
+#endif //SUPERCOMPUTERSIMULATION_FAIRSHARESCHEDULER_H
@@ -0,0 +1,109 @@
+#ifndef SUPERCOMPUTERSIMULATION_FAIRSHAREUSAGE_H
+#define SUPERCOMPUTERSIMULATION_FAIRSHAREUSAGE_H
+
+#include <map>
+
+class User;
+
+class Group;
+
+class Curriculum;
+
+/**
+ * Node-hours used by every user, research group and curriculum, decayed exponentially with time.
+ * The decay is applied lazily : the values are stored multiplied by exp(decayRate * (t - referenceTime))
+ * for a usage charged at time t, so that the values of two users keep the same ratio as time passes.
+ * Comparing the keys of two users therefore never needs a decay to be applied, only charging a user
+ * changes its key. When the stored values grow too large they are all scaled down at once.
+ */
+class FairShareUsage {
+private:
+    /**
+     * ln(2) / half-life of the usage, 0 if the usage never decays
+     */
+    double decayRate;
+    /**
+     * Time at which the stored values are the usage
+     */
+    double referenceTime = 0;
+    /**
+     * Weight of the usage of the user in its key
+     */
+    double userWeight;
+    /**
+     * Weight of the usage of the group or of the curriculum of the user in its key
+     */
+    double accountWeight;
+    std::map<const User *, double> userUsage;
+    std::map<const Group *, double> groupUsage;
+    std::map<const Curriculum *, double> curriculumUsage;
+
+    /**
+     * Return the factor between the usage at a time and the stored values
+     * @param time
+     * @return
+     */
+    double scaleAt(double time) const;
+
+    /**
+     * Return the usage of an owner at a time
+     * @param usage stored values
+     * @param owner
+     * @param time
+     * @return
+     */
+    template<typename T>
+    double usageAt(const std::map<const T *, double> &usage, const T *owner, double time) const {
+        auto value = usage.find(owner);
+        return value == usage.end() ? 0 : value->second / scaleAt(time);
+    }
+
+public:
+    /**
+     * Largest factor between the stored values and the usage
+     */
+    constexpr static double maximumScale = 1e100;
+
+    /**
+     * @param halfLife time after which a usage counts for half, infinite or not positive for no decay
+     * @param userWeight weight of the usage of the user in its key
+     * @param accountWeight weight of the usage of its group or of its curriculum in its key
+     */
+    FairShareUsage(double halfLife, double userWeight, double accountWeight);
+
+    /**
+     * Charge node-hours to a user and to its group or curriculum
+     * @param user
+     * @param nodeHours
+     * @param time of the charge, never before the previous one
+     * @return true if all the stored values have been scaled down, which changes the keys of all the users
+     */
+    bool charge(const User *user, double nodeHours, double time);
+
+    double usage(const User *user, double time) const { return usageAt(userUsage, user, time); };
+
+    double usage(const Group *group, double time) const { return usageAt(groupUsage, group, time); };
+
+    double usage(const Curriculum *curriculum, double time) const {
+        return usageAt(curriculumUsage, curriculum, time);
+    };
+
+    /**
+     * Return the weighted usage of a user and of its group or curriculum, as stored.
+     * The lower the key the higher the priority of the user, the keys of two users compare the same
+     * at any time.
+     * @param user
+     * @return
+     */
+    double key(const User *user) const;
+
+    /**
+     * Return the weighted usage of a user and of its group or curriculum at a time
+     * @param user
+     * @param time
+     * @return
+     */
+    double weightedUsage(const User *user, double time) const { return key(user) / scaleAt(time); };
+};
+
+#endif //SUPERCOMPUTERSIMULATION_FAIRSHAREUSAGE_H
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+class Node;
+
+/**
+ * Classes of nodes, each class has its own set of free nodes in the scheduler
+ */
+enum NodeClass {
+    NormalNodeClass = 0,
+    MediumNodeClass = 1,
+    SmallNodeClass = 2,
+    GpuNodeClass = 3,
+    NumberOfNodeClasses = 4
+};
+
+/**
+ * This class keeps the free nodes of the scheduler, one bitset indexed by node id for each class of nodes.
+ * The number of free nodes of a class is kept up to date, so checking if a job fits costs nothing,
+ * and allocating or releasing k nodes works on whole words of 64 nodes.
+ * The free nodes of a class are allocated by increasing id, or rack by rack when the pool knows the racks of the nodes.
+ */
+class FreeNodePool {
+private:
+    /**
+     * Bitset of the free nodes of each class, bit i of word w is the node of id 64 * w + i
+     */
+    std::vector<uint64_t> freeNodes[NumberOfNodeClasses];
+    /**
+     * Number of free nodes of each class
+     */
+    int numberOfFreeNodes[NumberOfNodeClasses] = {0, 0, 0, 0};
+    /**
+     * Number of nodes of each class, free or not, counted when they are first released in the pool
+     */
+    int classSizes[NumberOfNodeClasses] = {0, 0, 0, 0};
+    /**
+     * Index of the first word of each class which may have a free node
+     */
+    size_t firstWord[NumberOfNodeClasses] = {0, 0, 0, 0};
+    /**
+     * Nodes indexed by id, filled as the nodes are released in the pool
+     */
+    std::vector<Node *> nodesById;
+    /**
+     * Number of consecutive ids in each rack, 0 to allocate the nodes by increasing id whatever their rack
+     */
+    int nodesPerRack = 0;
+
+    /**
+     * Allocate the free nodes of a class with the lowest ids in [first, last), there must be enough of them
+     */
+    void takeInRange(NodeClass nodeClass, size_t first, size_t last, int numberOfNodes, std::vector<Node *> &nodes);
+
+    /**
+     * Allocate free nodes of a class in as few racks as possible : in the rack with the fewest free nodes where
+     * they all fit, otherwise in the rack with the most free nodes first
+     */
+    void takeCompact(NodeClass nodeClass, int numberOfNodes, std::vector<Node *> &nodes);
+
+    template<typename Iterator>
+    int availableIn(Iterator first, Iterator last) const {
+        int total = 0;
+        for (; first != last; ++first) {
+            total += numberOfFreeNodes[*first];
+        }
+        return total;
+    }
+
+    template<typename Iterator>
+    void takeFrom(Iterator first, Iterator last, int numberOfNodes, std::vector<Node *> &nodes) {
+        for (; first != last && numberOfNodes > 0; ++first) {
+            int numberTaken = numberOfNodes < numberOfFreeNodes[*first] ? numberOfNodes : numberOfFreeNodes[*first];
+            take(*first, numberTaken, nodes);
+            numberOfNodes -= numberTaken;
+        }
+    }
+
+public:
+    /**
+     * Return the number of free nodes of a class
+     * @param nodeClass
+     * @return
+     */
+    int available(NodeClass nodeClass) const { return numberOfFreeNodes[nodeClass]; };
+
+    /**
+     * Return the number of free nodes of several classes
+     * @param nodeClasses
+     * @return
+     */
+    int available(std::initializer_list<NodeClass> nodeClasses) const {
+        return availableIn(nodeClasses.begin(), nodeClasses.end());
+    }
+
+    int available(const std::vector<NodeClass> &nodeClasses) const {
+        return availableIn(nodeClasses.begin(), nodeClasses.end());
+    }
+
+    /**
+     * Return the number of nodes of a class, including the nodes allocated to jobs
+     * @param nodeClass
+     * @return
+     */
+    int size(NodeClass nodeClass) const { return classSizes[nodeClass]; };
+
+    /**
+     * Return the number of free nodes of a class with an id in a range
+     * @param nodeClass
+     * @param first lowest id of the range
+     * @param last id following the highest one of the range
+     * @return
+     */
+    int availableInRange(NodeClass nodeClass, size_t first, size_t last) const;
+
+    /**
+     * Allocate the nodes rack by rack, the racks being made of consecutive ids
+     * @param numberOfNodes in each rack, 0 to allocate the nodes by increasing id
+     */
+    void setNodesPerRack(int numberOfNodes) { nodesPerRack = numberOfNodes; };
+
+    /**
+     * Add a free node to the set of its class
+     * @param nodeClass
+     * @param node
+     */
+    void release(NodeClass nodeClass, Node *node);
+
+    /**
+     * Add free nodes to the set of a class
+     * @param nodeClass
+     * @param nodes
+     */
+    void release(NodeClass nodeClass, const std::vector<Node *> &nodes);
+
+    /**
+     * Allocate free nodes of a class, by increasing id or in as few racks as possible
+     * @param nodeClass
+     * @param numberOfNodes to allocate, there must be enough free nodes in the class
+     * @param nodes receiving the allocated nodes
+     */
+    void take(NodeClass nodeClass, int numberOfNodes, std::vector<Node *> &nodes);
+
+    /**
+     * Allocate free nodes, exhausting the classes in the order in which they are passed
+     * @param nodeClasses in order of preference
+     * @param numberOfNodes to allocate, there must be enough free nodes in the classes
+     * @param nodes receiving the allocated nodes
+     */
+    void take(std::initializer_list<NodeClass> nodeClasses, int numberOfNodes, std::vector<Node *> &nodes) {
+        takeFrom(nodeClasses.begin(), nodeClasses.end(), numberOfNodes, nodes);
+    }
+
+    void take(const std::vector<NodeClass> &nodeClasses, int numberOfNodes, std::vector<Node *> &nodes) {
+        takeFrom(nodeClasses.begin(), nodeClasses.end(), numberOfNodes, nodes);
+    }
+
+    /**
+     * Move free nodes from a class to another. The nodes are allocated like by take : they must then be
+     * released in their new class.
+     * @param from class of the nodes, at most its free nodes are moved
+     * @param to new class of the nodes
+     * @param numberOfNodes to move
+     * @param nodes receiving the nodes moved
+     */
+    void reassign(NodeClass from, NodeClass to, int numberOfNodes, std::vector<Node *> &nodes);
+
+    /**
+     * Allocate every free node, whatever its class, with an id in a range
+     * @param first lowest id of the range
+     * @param last id following the highest one of the range
+     * @param nodes receiving the allocated nodes
+     */
+    void takeRange(size_t first, size_t last, std::vector<Node *> &nodes);
+};
@@ -21,6 +21,10 @@ public:
      * ASSUMPTION : every nodes correspond to 16 cores
      */
     static const int TotalNumberOfNodes = 128;
+    /**
+     * Number of cores of every node, small jobs may share a node at the granularity of the cores
+     */
+    static const int coresPerNode = 16;
     /**
      * Number of Nodes accelerated with to GPU dedicated to computations
      * Those are counted as part of the total number of Nodes
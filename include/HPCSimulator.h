@@ -6,6 +6,8 @@
 #include "Group.h"
 #include "Curriculum.h"
 #include "User.h"
+#include "SchedulerRegistry.h"
+#include "ReservationCalendar.h"
 
 class GpuJob;
 
@@ -19,42 +21,188 @@ class HugeJob;
 
 class User;
 
+class AbstractJob;
+
+/**
+ * Order the jobs by id, so that the results do not depend on where the jobs have been allocated in memory
+ */
+struct JobIdOrder {
+    bool operator()(const AbstractJob *a, const AbstractJob *b) const;
+};
+
+/**
+ * Measurements of a simulation, as printed by HPCSimulator::printResults.
+ * The arrays are indexed by type of jobs : small, medium, large, huge, gpu
+ */
+struct SimulationResults {
+    double numberOfWeeks = 0;
+    double jobsPerWeek[5] = {0, 0, 0, 0, 0};
+    double nodeHoursUsed = 0;
+    double nodeHoursUsedByType[5] = {0, 0, 0, 0, 0};
+    double availableNodeHours = 0;
+    double utilizationRatio = 0;
+    double totalUserCost = 0;
+    double averageWaitingTime[5] = {0, 0, 0, 0, 0};
+    double averageTurnaroundTimeRatio = 0;
+    double economicBalance = 0;
+
+    /**
+     * Return the measurements as named values, always in the same order
+     * @return
+     */
+    std::vector<std::pair<std::string, double>> namedValues() const;
+};
+
 class HPCSimulator : public Simulator {
 private:
     /**
      * Holding the list of the users generated from the input file
      */
     std::vector<User *> users;
+    /**
+     * Holding the research groups generated from the input file
+     */
+    std::vector<Group *> groups;
+    /**
+     * Holding the curriculums generated from the input file
+     */
+    std::vector<Curriculum *> curriculums;
     /**
      * Register all the finished gpu jobs
      */
-    std::unordered_set<GpuJob *> finishedGpuJobs;
+    std::set<GpuJob *, JobIdOrder> finishedGpuJobs;
     /**
      * Register all the finished small jobs
      */
-    std::unordered_set<SmallJob *> finishedSmallJobs;
+    std::set<SmallJob *, JobIdOrder> finishedSmallJobs;
     /**
     * Register all the finished medium jobs
     */
-    std::unordered_set<MediumJob *> finishedMediumJobs;
+    std::set<MediumJob *, JobIdOrder> finishedMediumJobs;
     /**
     * Register all the finished large jobs
     */
-    std::unordered_set<LargeJob *> finishedLargeJobs;
+    std::set<LargeJob *, JobIdOrder> finishedLargeJobs;
     /**
      * Register all the finished huge jobs
      */
-    std::unordered_set<HugeJob *> finishedHugeJobs;
+    std::set<HugeJob *, JobIdOrder> finishedHugeJobs;
     /**
     * Register how much budget can be spent by the users generated from the input file
     */
     double initialUsersBudget = 0;
+    /**
+     * Name of the OrderedSet implementation used as event calendar (see createEventQueue)
+     */
+    std::string eventQueueName = "heap";
+    /**
+     * Name of the scheduler of the platform, as registered in the SchedulerRegistry
+     */
+    std::string schedulerName = "fifo";
+    /**
+     * Parameters given to the scheduler when it is created
+     */
+    SchedulerParameters schedulerParameters;
+    /**
+     * Number of consecutive nodes in each rack, 0 if the scenario does not describe the topology
+     */
+    int nodesPerRack = 0;
+    /**
+     * Share of its duration by which a job runs longer for each rack it spans after the first
+     */
+    double communicationPenalty = 0;
+    /**
+     * Whether the nodes of a job are allocated in as few racks as possible
+     */
+    bool compactPlacement = true;
+    /**
+     * Bandwidth of the filesystem, in nodes doing I/O all the time, 0 if the jobs do not compete for it
+     */
+    double filesystemBandwidth = 0;
+    /**
+     * Factor by which the walltime declared by the users exceeds the execution duration of the jobs, 1 if the
+     * scenario declares no walltime
+     */
+    double walltimeOverestimate = 1;
+    /**
+     * Nodes booked in advance by the scenario
+     */
+    std::vector<Reservation> reservations;
+    /**
+     * First error found in the input file, empty if there is none
+     */
+    std::string inputError;
+    /**
+     * Master seed from which every random stream of the simulation is derived
+     */
+    uint64_t seed = Random::stream().nextSeed();
+    /**
+     * Number of jobs created in the simulation, used for giving a unique id to each job
+     */
+    int numberOfJobsCreated = 0;
 
 public:
     HPCSimulator() = default;
 
+    HPCSimulator(const HPCSimulator &simulator) = delete;
+
+    HPCSimulator &operator=(const HPCSimulator &simulator) = delete;
+
+    /**
+     * Delete the users, groups, curriculums and finished jobs of the simulation
+     */
+    ~HPCSimulator();
+
+    /**
+     * Return a new job id, unique in this simulation
+     * @return
+     */
+    int newJobId() { return ++numberOfJobsCreated; };
+
+    /**
+     * Select the implementation of the event calendar used by start()
+     * @param name of the event queue, one accepted by createEventQueue
+     */
+    void setEventQueueName(const std::string &name) { eventQueueName = name; };
+
+    /**
+     * Select the scheduler created by start(), the parameters of the previous scheduler are forgotten
+     * @param name of the scheduler, as registered in the SchedulerRegistry
+     */
+    void setSchedulerName(const std::string &name) {
+        schedulerName = name;
+        schedulerParameters.clear();
+    };
+
+    /**
+     * Set a parameter of the scheduler created by start()
+     * @param name of the parameter
+     * @param value of the parameter
+     */
+    void setSchedulerParameter(const std::string &name, const std::string &value) {
+        schedulerParameters.set(name, value);
+    };
+
+    const std::string &getSchedulerName() const { return schedulerName; };
+
+    const SchedulerParameters &getSchedulerParameters() const { return schedulerParameters; };
+
+    /**
+     * Return the first error found in the input file by initialisation()
+     * @return an empty string if the input file is valid
+     */
+    const std::string &getInputError() const { return inputError; };
+
+    /**
+     * Set the master seed of the simulation. Two simulations started with the same seed
+     * and the same input file give exactly the same results.
+     * @param masterSeed
+     */
+    void setSeed(uint64_t masterSeed) { seed = masterSeed; };
+
     /**
-     * Parse the file for generating Students, Researches, Groups and Curriculum
+     * Parse the file for generating Students, Researches, Groups and Curriculum,
+     * and select the scheduler and describe the racks of the platform if the file has a last section
      * @param filename
      */
     void initialisation(string filename);
@@ -98,10 +246,24 @@ public:
      */
     void registerFinishedHugeJobs(HugeJob *pJob);
 
+    /**
+     * Compute measurements for the simulation
+     * @return the measurements
+     */
+    SimulationResults computeResults();
+
     /**
      * Compute measurements for the simulation and print the results
      */
     void printResults();
 };
 
+/**
+ * Create the event calendar corresponding to the name passed as parameter:
+ * "list" for the ListQueue, "heap" for the HeapQueue, "calendar" for the CalendarQueue.
+ * @param name of the event queue
+ * @return a new event queue or nullptr if the name is unknown
+ */
+OrderedSet *createEventQueue(const std::string &name);
+
 
@@ -0,0 +1,93 @@
+#ifndef SUPERCOMPUTERSIMULATION_HEAPQUEUE_H
+#define SUPERCOMPUTERSIMULATION_HEAPQUEUE_H
+
+#include <vector>
+#include <unordered_map>
+#include "AbstractSimulator.h"
+
+/**
+ * This class implements the event calendar as an indexed binary heap.
+ * Insertion, removal of the first element and removal of an arbitrary element
+ * are done in O(log n), whereas the ListQueue needs O(n) for each of them.
+ * The position of every element in the heap is indexed so that remove(x) does
+ * not have to scan the heap.
+ *
+ * Elements that are equal according to lessThan are returned in the same order
+ * as the ListQueue would, ie. the most recently inserted one first. Both queues
+ * can therefore be swapped without changing the outcome of a simulation.
+ */
+class HeapQueue : public OrderedSet {
+private:
+    /**
+     * An element of the heap with its insertion number used to break ties
+     */
+    struct Entry {
+        Comparable *element;
+        unsigned long insertionNumber;
+    };
+
+    /**
+     * Heap storage, the first element is the smallest one
+     */
+    std::vector<Entry> heap;
+
+    /**
+     * Position of each element in the heap storage
+     */
+    std::unordered_map<Comparable *, size_t> positions;
+
+    /**
+     * Incremented at each insertion
+     */
+    unsigned long insertionCounter = 0;
+
+    /**
+     * Return true if the entry a shall be removed before the entry b
+     */
+    static bool before(const Entry &a, const Entry &b);
+
+    /**
+     * Place the entry at the given position and update the index
+     */
+    void place(size_t position, const Entry &entry);
+
+    /**
+     * Move the entry at the given position up until the heap property is restored
+     */
+    void siftUp(size_t position);
+
+    /**
+     * Move the entry at the given position down until the heap property is restored
+     */
+    void siftDown(size_t position);
+
+    /**
+     * Remove the entry at the given position and return its element
+     */
+    Comparable *removeAt(size_t position);
+
+public:
+    HeapQueue() = default;
+
+    HeapQueue(const HeapQueue &queue) = delete;
+
+    HeapQueue &operator=(const HeapQueue &queue) = delete;
+
+    void insert(Comparable *x) override;
+
+    Comparable *removeFirst() override;
+
+    Comparable *remove(Comparable *x) override;
+
+    /**
+     * Move elements of the heap : when many of them move the elements are changed in place and the heap is
+     * rebuilt in O(n), otherwise each of them is removed and inserted again in O(log n)
+     * @param xs elements in the heap
+     * @param change applied to each element
+     */
+    void update(const std::vector<Comparable *> &xs, const std::function<void(Comparable *)> &change) override;
+
+    int size() override;
+};
+
+#endif //SUPERCOMPUTERSIMULATION_HEAPQUEUE_H
@@ -0,0 +1,88 @@
+#ifndef SUPERCOMPUTERSIMULATION_IOCONTENTION_H
+#define SUPERCOMPUTERSIMULATION_IOCONTENTION_H
+
+#include <map>
+#include <utility>
+#include <vector>
+
+class AbstractJob;
+
+/**
+ * This class models the contention of the running jobs on the bandwidth of the parallel filesystem.
+ * A job with an I/O intensity f spends the share f of its execution on I/O when it runs alone, which takes
+ * f bandwidth units on each of its nodes. When the jobs running ask for more units than the bandwidth of the
+ * filesystem, their I/O is slowed down by the ratio of the demand to the bandwidth, and so is their progress.
+ * The progress of each job is brought up to date each time a job starts or stops, before the rates change.
+ */
+class IoContention {
+private:
+    /**
+     * Progress of a running job doing I/O
+     */
+    struct Progress {
+        AbstractJob *job;
+        /**
+         * Duration of execution left when running alone, at the time of the last update
+         */
+        double workLeft;
+        /**
+         * Duration of execution done per hour at the current contention
+         */
+        double rate;
+    };
+
+    /**
+     * Bandwidth of the filesystem, in units used by a node doing I/O all the time
+     */
+    double bandwidth;
+    /**
+     * Running jobs doing I/O, by job id
+     */
+    std::map<int, Progress> jobs;
+    /**
+     * Bandwidth units asked for by the running jobs
+     */
+    double demand = 0;
+    double lastUpdate = 0;
+
+    /**
+     * Bring the work left of every job up to the time passed as parameter, at their current rates
+     */
+    void advance(double now);
+
+    /**
+     * Compute the rates of the jobs at the current demand
+     * @param now
+     * @param completions receives the jobs whose rate changed, with their new completion time
+     */
+    void updateRates(double now, std::vector<std::pair<AbstractJob *, double>> &completions);
+
+public:
+    explicit IoContention(double bandwidth) : bandwidth(bandwidth) {};
+
+    /**
+     * Return by how much the I/O of the jobs is slowed down
+     * @return 1 while the demand does not exceed the bandwidth
+     */
+    double slowdown() const { return demand > bandwidth ? demand / bandwidth : 1; };
+
+    /**
+     * Start to follow the progress of a job doing I/O
+     * @param job started, its remaining duration is the work it has to do
+     * @param now
+     * @param completions receives the jobs whose rate changed, including the job started, with their new
+     * completion time
+     */
+    void start(AbstractJob *job, double now, std::vector<std::pair<AbstractJob *, double>> &completions);
+
+    /**
+     * Stop to follow the progress of a job, because it completed or was checkpointed
+     * @param job followed
+     * @param now
+     * @param completions receives the jobs whose rate changed, with their new completion time
+     * @return the work done by the job since it started
+     */
+    double stop(AbstractJob *job, double now, std::vector<std::pair<AbstractJob *, double>> &completions);
+};
+
+#endif //SUPERCOMPUTERSIMULATION_IOCONTENTION_H
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include "Simulator.h"
+
+class AbstractJob;
+
+class Node;
+
+class AbstractScheduler;
+
+/**
+ * The end of a job is a single event, whatever the number of nodes the job is running on.
+ * It is created by AbstractScheduler::startJob and owned by the job.
+ */
+class JobCompletion : public Event {
+private:
+    /**
+     * Scheduler which started the job and gets its nodes back
+     */
+    AbstractScheduler *scheduler;
+    /**
+     * Job which is completed by this event
+     */
+    AbstractJob *job;
+    /**
+     * Nodes executing the job, in the order in which they have been allocated
+     */
+    std::vector<Node *> nodes;
+
+public:
+    /**
+     * Create the completion of a job started now on the nodes passed as parameter
+     * @param scheduler which started the job
+     * @param job
+     * @param nodes
+     * @param now time at which the job starts
+     */
+    JobCompletion(AbstractScheduler *scheduler, AbstractJob *job, const std::vector<Node *> &nodes, double now);
+
+    JobCompletion(const JobCompletion &completion) = delete;
+
+    JobCompletion &operator=(const JobCompletion &completion) = delete;
+
+    /**
+     * The job is done. Its I/O stops (see AbstractScheduler::stopIo), it reduces the number of nodes currently used by the job's user,
+     * sets the completion time of the job and registers it as finished once.
+     * Then the nodes are released and given back to the scheduler (see AbstractScheduler::completeJob).
+     * @param simulator
+     */
+    void execute(AbstractSimulator *simulator) override;
+
+    const std::vector<Node *> &getNodes() const { return nodes; };
+
+    /**
+     * Move the completion when the job runs at another speed. The event must be out of the calendar,
+     * see AbstractSimulator::update
+     * @param newTime
+     */
+    void setTime(double newTime) { time = newTime; };
+
+    /**
+     * Print an end of execution message
+     * @param out stream receiving the message
+     */
+    void printMessage(std::ostream &out);
+};
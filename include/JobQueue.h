@@ -0,0 +1,228 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <set>
+
+class AbstractJob;
+
+/**
+ * Queues of jobs taking part in the selection of the next job to run, the huge jobs are not part of it
+ */
+enum JobQueueSlot {
+    MediumJobQueue = 0,
+    LargeJobQueue = 1,
+    SmallJobQueue = 2,
+    GpuJobQueue = 3,
+    NumberOfJobQueueSlots = 4
+};
+
+/**
+ * This class keeps the job with the highest priority among the heads of the job queues.
+ * It is a tournament tree with four leaves, the heads of the medium, large, small and gpu queues:
+ * the non gpu winner is the winner of (medium against large) against small, and the overall winner
+ * is the winner of the non gpu winner against gpu. On equal priorities the first one wins.
+ * The winners are updated when a head changes, so asking for the next job costs nothing.
+ */
+class NextJobIndex {
+private:
+    AbstractJob *heads[NumberOfJobQueueSlots] = {nullptr, nullptr, nullptr, nullptr};
+    AbstractJob *nonGpuWinner = nullptr;
+    AbstractJob *overallWinner = nullptr;
+
+    /**
+     * Return the job with the highest priority, the first one on equal priorities
+     * @param first
+     * @param second
+     * @return nullptr if both are nullptr
+     */
+    static AbstractJob *winner(AbstractJob *first, AbstractJob *second);
+
+public:
+    /**
+     * Set the head of a queue and update the winners
+     * @param slot of the queue
+     * @param head nullptr if the queue is empty
+     */
+    void setHead(JobQueueSlot slot, AbstractJob *head);
+
+    /**
+     * Play the tournament again, to be called when the priorities of the heads have changed
+     */
+    void update();
+
+    /**
+     * Return the non gpu job with the highest priority
+     * @return nullptr if there is no such job
+     */
+    AbstractJob *nextNonGpuJob() const { return nonGpuWinner; };
+
+    /**
+     * Return the job with the highest priority including gpu jobs
+     * @return nullptr if there is no such job
+     */
+    AbstractJob *nextJob() const { return overallWinner; };
+};
+
+/**
+ * A queue of jobs ordered by decreasing priority, the jobs of equal priorities in the order they have been
+ * added, so that with the default priorities it is a FIFO queue. It tells the NextJobIndex of the scheduler
+ * when its head changes. The jobs are also indexed by walltime, which must not change while they wait.
+ * @tparam T type of the jobs
+ */
+template<typename T>
+class JobQueue {
+private:
+    struct HigherPriorityFirst {
+        bool operator()(const T *first, const T *second) const {
+            return first->priority() > second->priority();
+        }
+    };
+
+    std::multiset<T *, HigherPriorityFirst> jobs;
+    /**
+     * The same jobs by walltime
+     */
+    std::multimap<double, T *> jobsByWalltime;
+    /**
+     * Index to update when the head changes, nullptr if the queue is not part of the selection
+     */
+    NextJobIndex *index;
+    JobQueueSlot slot;
+    /**
+     * Head given to the index
+     */
+    T *head = nullptr;
+
+    /**
+     * Give the head to the index if it has changed, or in any case if forced to
+     * @param force when the priority of the head may have changed
+     */
+    void headChanged(bool force = false) {
+        T *newHead = jobs.empty() ? nullptr : *jobs.begin();
+        if (newHead != head || force) {
+            head = newHead;
+            if (index != nullptr) {
+                index->setHead(slot, head);
+            }
+        }
+    }
+
+    void removeFromWalltimeIndex(T *job) {
+        auto range = jobsByWalltime.equal_range(job->getWalltime());
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == job) {
+                jobsByWalltime.erase(it);
+                return;
+            }
+        }
+    }
+
+public:
+    typedef typename std::multiset<T *, HigherPriorityFirst>::iterator iterator;
+
+    explicit JobQueue(NextJobIndex *index = nullptr, JobQueueSlot slot = MediumJobQueue) : index(index),
+                                                                                           slot(slot) {};
+
+    JobQueue(const JobQueue &queue) = delete;
+
+    JobQueue &operator=(const JobQueue &queue) = delete;
+
+    /**
+     * Add a job behind the jobs of higher or equal priority
+     * @param job
+     */
+    void push_back(T *job) {
+        jobs.insert(job);
+        jobsByWalltime.emplace(job->getWalltime(), job);
+        headChanged();
+    }
+
+    void pop_front() {
+        removeFromWalltimeIndex(*jobs.begin());
+        jobs.erase(jobs.begin());
+        headChanged();
+    }
+
+    iterator erase(iterator position) {
+        removeFromWalltimeIndex(*position);
+        iterator next = jobs.erase(position);
+        headChanged();
+        return next;
+    }
+
+    /**
+     * Find a job in the queue
+     * @param job
+     * @return end() if the job is not in the queue
+     */
+    iterator find(T *job) {
+        auto range = jobs.equal_range(job);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (*it == job) {
+                return it;
+            }
+        }
+        return jobs.end();
+    }
+
+    /**
+     * Remove a job from the queue
+     * @param job
+     * @return false if the job is not in the queue
+     */
+    bool remove(T *job) {
+        auto position = find(job);
+        if (position == jobs.end()) {
+            return false;
+        }
+        erase(position);
+        return true;
+    }
+
+    /**
+     * Change the priority of a job of the queue, the job is moved behind the jobs of higher or equal priority
+     * @param job in the queue
+     * @param priority new priority of the job
+     * @return false if the job is not in the queue
+     */
+    bool setPriority(T *job, double priority) {
+        auto position = find(job);
+        if (position == jobs.end()) {
+            return false;
+        }
+        jobs.erase(position);
+        job->setPriority(priority);
+        jobs.insert(job);
+        headChanged(job == head);
+        return true;
+    }
+
+    /**
+     * Return the job with the longest walltime not exceeding a duration, among the jobs needing at most
+     * a number of nodes. The jobs are visited from this walltime down, not in order of priority : the jobs
+     * needing too many nodes are skipped one by one, so a queue of wide jobs is scanned entirely.
+     * @param hours
+     * @param numberOfNodes
+     * @return nullptr if there is no such job
+     */
+    T *longestFitting(double hours, int numberOfNodes) const {
+        for (auto it = jobsByWalltime.upper_bound(hours); it != jobsByWalltime.begin();) {
+            --it;
+            if (it->second->getNumberOfNodes() <= numberOfNodes) {
+                return it->second;
+            }
+        }
+        return nullptr;
+    }
+
+    T *front() const { return *jobs.begin(); };
+
+    bool empty() const { return jobs.empty(); };
+
+    size_t size() const { return jobs.size(); };
+
+    iterator begin() { return jobs.begin(); };
+
+    iterator end() { return jobs.end(); };
+};
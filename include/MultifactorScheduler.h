@@ -0,0 +1,58 @@
+#ifndef SUPERCOMPUTERSIMULATION_MULTIFACTORSCHEDULER_H
+#define SUPERCOMPUTERSIMULATION_MULTIFACTORSCHEDULER_H
+
+#include "FairShareScheduler.h"
+#include "PriorityFormula.h"
+
+/**
+ * This class derived from the FairShareScheduler and orders the queues by a weighted sum of factors :
+ * the age and the size of the job, its type, the fair-share of its user and whether the user is a student
+ * or a researcher (see PriorityFormula). The priority of a job is computed when it is queued, when the usage
+ * of its user or account changes, and for all the queued jobs at most once per recalculation period, for the
+ * decay of the usage to be taken into account.
+ */
+class MultifactorScheduler : public FairShareScheduler {
+private:
+    PriorityFormula formula;
+    /**
+     * Weighted usage at which the fair-share factor is 1/2
+     */
+    double usageScale;
+    /**
+     * Time between two recalculations of all the priorities
+     */
+    double recalculationPeriod;
+    double lastRecalculation = 0;
+
+protected:
+    double priorityOf(AbstractJob *job, double time) override;
+
+    /**
+     * Start a job, then compute all the priorities again if the recalculation period has elapsed
+     * @param simulator running the current simulation
+     * @param job to start
+     * @param nodes allocated to the job
+     */
+    void startJob(AbstractSimulator *simulator, AbstractJob *job, const std::vector<Node *> &nodes) override;
+
+public:
+    /**
+     * Priority used when no priority parameter is given
+     */
+    static const char *const defaultPriority;
+
+    /**
+     * @param parameters priority the expression of the priority, usageScale the usage in node-hours for which
+     * the fair-share factor is 1/2 (1000 by default), recalculationPeriod in hours (24 by default), and the
+     * parameters of the FairShareScheduler
+     */
+    explicit MultifactorScheduler(const SchedulerParameters &parameters);
+
+    //removing the copy constructor
+    MultifactorScheduler(const MultifactorScheduler &scheduler) = delete;
+
+    //removing the  equal operator
+    MultifactorScheduler &operator=(const MultifactorScheduler &scheduler) = delete;
+};
+
+#endif //SUPERCOMPUTERSIMULATION_MULTIFACTORSCHEDULER_H
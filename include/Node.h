@@ -3,7 +3,10 @@
 #include "Simulator.h"
 #include "random.h"
 #include "HPCSimulator.h"
+#include "FreeNodePool.h"
+#include "HPCParameters.h"
 #include <list>
+#include <vector>
 #include <cmath>
 
 class ListQueue;
@@ -12,27 +15,48 @@ class User;
 class AbstractJob;
 class HPCSimulator;
 /**
-* A server that holds a customer for an exponentially distributed amout of time
-* and releases it.
+* A server that holds a job until its JobCompletion event releases it.
 */
-class Node : public Event {
+class Node {
 protected:
     /**
-     * Job currently being executed by the node
+     * Jobs currently being executed by the node, in the order they were assigned, several when jobs share the node
      */
-	AbstractJob* jobBeingExecuted;
+	std::vector<AbstractJob *> jobsBeingExecuted;
+    /**
+     * Number of cores used by the jobs executed by the node
+     */
+    int usedCores = 0;
     /**
      * scheduler (for saying that the node is free)
      */
     AbstractScheduler* scheduler;
-
-public:
     /**
-     * Set jobBeing executed to nullptr
+     * Node id, unique in the simulation
      */
-	Node();
+    int id = 0;
+    /**
+     * Class of the node, the reserved classes are partitions which may be resized by moving free nodes
+     */
+    NodeClass nodeClass = NormalNodeClass;
+
+public:
+	Node() = default;
 	Node(const Node& node) = delete;
 	Node& operator=(const Node& node) = delete;
+	virtual ~Node() = default;
+
+	int getId() const { return id; }
+
+	/**
+	 * Set the node id
+	 * @param nodeId unique in the simulation
+	 * @return this Node
+	 */
+	Node& setId(int nodeId) {
+		id = nodeId;
+		return *this;
+	}
 
 	/**
 	 * Set the scheduler for this node
@@ -41,38 +65,59 @@ public:
 	 */
 	Node& addScheduler(AbstractScheduler* scheduler);
 	/**
-	 *  A node event execute when the job it is executing is done.
-	 *  Therefore it reduce the number of nodes currently use of the job's user by one
-	 *  It sets the completion time of the job
-	 *  It registers the job as finished
-	 *  set jobBeingExecuted to null pointer and tell the scheduler that he is free to execute a new job
-	 * @param simulator
+	 * Return true if the node is not executing a job
+	 * @return
 	 */
-	void execute(AbstractSimulator *simulator);
+	bool isAvailable();
 
 	/**
-	 * Return true if the node is not executing a job
+	 * Return the number of cores no job is using
 	 * @return
 	 */
-	bool isAvailable();
+	int getFreeCores() const { return HPCParameters::coresPerNode - usedCores; }
 
     /**
-     * Set the nex job to execute
-     * @param simulator
+     * Set the job executed by the node, the end of the job is an event of the whole job (see JobCompletion).
+     * The job takes the cores it uses on each node, the simulation is aborted if they are not free.
      * @param job
      */
-	void insert(AbstractSimulator* simulator, AbstractJob* job);
+	void assign(AbstractJob* job);
 
 	/**
-	 * Print an end of execution message
+	 * Give back the cores of a job, the node is available again once no job uses it
+	 * @param job executed by the node
 	 */
-	void printMessage();
+	void release(AbstractJob* job);
 
 	/**
-	 * Tells the scheduler that this normal node is free for getting a new job
+	 * Return the job executed by the node, the last one assigned among those still running when jobs share the node
+	 * @return nullptr if the node is available
+	 */
+	AbstractJob *getJobBeingExecuted() const {
+		return jobsBeingExecuted.empty() ? nullptr : jobsBeingExecuted.back();
+	}
+
+	/**
+	 * Tells the scheduler that this node is free for getting a new job of its class
 	 * @param Simulator
 	 */
 	virtual void addFreeNodeToScheduler(AbstractSimulator *Simulator);
+
+	/**
+	 * Return the class of the node, which tells in which set of free nodes it is kept
+	 * @return
+	 */
+	NodeClass getNodeClass() const { return nodeClass; }
+
+	/**
+	 * Move the node to another class, while it is not free in the scheduler
+	 * @param newClass normal, medium or small
+	 * @return this Node
+	 */
+	Node& setNodeClass(NodeClass newClass) {
+		nodeClass = newClass;
+		return *this;
+	}
 };
 
 /**
@@ -80,11 +125,7 @@ public:
  */
 class ReservedForMediumJobNode : public Node {
 public:
-    /**
-     * Tells the scheduler that this node is free for getting a new  medium job
-     * @param Simulator
-     */
-    void addFreeNodeToScheduler(AbstractSimulator *simulator) override;
+    ReservedForMediumJobNode() { nodeClass = MediumNodeClass; }
 };
 
 
@@ -93,11 +134,7 @@ public:
  */
 class ReservedForSmallJobNode : public Node {
 public:
-    /**
-    * Tells the scheduler that this node is free for getting a new small job
-    * @param Simulator
-    */
-void addFreeNodeToScheduler(AbstractSimulator *simulator) override;
+    ReservedForSmallJobNode() { nodeClass = SmallNodeClass; }
 };
 
 
@@ -106,6 +143,8 @@ void addFreeNodeToScheduler(AbstractSimulator *simulator) override;
  */
 class GpuNode : public Node {
 public:
+    GpuNode() { nodeClass = GpuNodeClass; }
+
     /**
     * Tells the scheduler that this node equipped with gpu is free for getting a new small job
     * @param Simulator
@@ -0,0 +1,59 @@
+#ifndef SUPERCOMPUTERSIMULATION_PARTITIONCONTROLLER_H
+#define SUPERCOMPUTERSIMULATION_PARTITIONCONTROLLER_H
+
+#include "FreeNodePool.h"
+
+/**
+ * This class resizes the partitions of nodes reserved for small and medium jobs. At most once per period,
+ * each partition whose jobs wait less than the large jobs lends its free nodes to the normal nodes, and a
+ * partition whose jobs wait longer than the large jobs takes free normal nodes back. The wait of a queue is the
+ * wait of its next job times the number of jobs queued, so that a long queue weighs more than a single old job. The size of each partition
+ * stays within its bounds.
+ */
+class PartitionController {
+private:
+    /**
+     * Time between two resizings of the partitions
+     */
+    double period;
+    double lastResizing = 0;
+    /**
+     * Fewest and most nodes of each class, only the bounds of the reserved classes are used
+     */
+    int minNodes[NumberOfNodeClasses] = {0, 0, 0, 0};
+    int maxNodes[NumberOfNodeClasses] = {0, 0, 0, 0};
+
+public:
+    /**
+     * @param period in hours between two resizings
+     * @param minSmallNodes fewest nodes reserved for small jobs
+     * @param maxSmallNodes most nodes reserved for small jobs
+     * @param minMediumNodes fewest nodes reserved for medium jobs
+     * @param maxMediumNodes most nodes reserved for medium jobs
+     */
+    PartitionController(double period, int minSmallNodes, int maxSmallNodes, int minMediumNodes, int maxMediumNodes);
+
+    /**
+     * Start a resizing if the period has elapsed since the last one
+     * @param time
+     * @return whether the partitions are to be resized now
+     */
+    bool startResizing(double time);
+
+    /**
+     * Return the number of nodes to move from the normal nodes to a reserved partition
+     * @param partition small or medium class of nodes
+     * @param size of the partition, including the nodes allocated to jobs
+     * @param freeNodes of the partition
+     * @param freeNormalNodes
+     * @param partitionWait time waited by the next job of the partition, 0 if none is waiting
+     * @param partitionJobs number of jobs waiting for the partition
+     * @param largeJobWait time waited by the next large job, 0 if none is waiting
+     * @param largeJobs number of large jobs waiting
+     * @return negative to move nodes from the partition to the normal nodes
+     */
+    int transfer(NodeClass partition, int size, int freeNodes, int freeNormalNodes, double partitionWait,
+                 int partitionJobs, double largeJobWait, int largeJobs) const;
+};
+
+#endif //SUPERCOMPUTERSIMULATION_PARTITIONCONTROLLER_H
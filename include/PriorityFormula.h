@@ -0,0 +1,119 @@
+#ifndef SUPERCOMPUTERSIMULATION_PRIORITYFORMULA_H
+#define SUPERCOMPUTERSIMULATION_PRIORITYFORMULA_H
+
+#include <string>
+
+/**
+ * Factors of the priority of a job, each between 0 and 1 except the age
+ */
+enum PriorityFactor {
+    /**
+     * Time the job has been waiting, in weeks
+     */
+    AgePriorityFactor,
+    /**
+     * Number of nodes of the job over the number of nodes of the platform
+     */
+    SizePriorityFactor,
+    /**
+     * 1 for a user and an account which have used nothing recently, tending to 0 as their usage grows
+     */
+    FairSharePriorityFactor,
+    /**
+     * 1 for the jobs of the type, 0 for the others
+     */
+    SmallPriorityFactor,
+    MediumPriorityFactor,
+    LargePriorityFactor,
+    HugePriorityFactor,
+    GpuPriorityFactor,
+    /**
+     * 1 for the jobs of students, 0 for the others
+     */
+    StudentPriorityFactor,
+    /**
+     * 1 for the jobs of researchers, 0 for the others
+     */
+    ResearcherPriorityFactor,
+    NumberOfPriorityFactors
+};
+
+/**
+ * Kind of user submitting a job, as far as the priority is concerned
+ */
+enum UserKind {
+    OtherUserKind,
+    StudentUserKind,
+    ResearcherUserKind,
+    NumberOfUserKinds
+};
+
+/**
+ * Priority of a job as a weighted sum of factors, written as an expression such as
+ * "1000*age + 500*fairShare + 200*size + 100*gpu - 50*student".
+ * The expression is compiled once into a table of constant terms by type of job and kind of user, and three
+ * coefficients, so that evaluating a priority is a lookup and three multiplications.
+ * The age of every waiting job grows at the same rate, so it only enters the priority by the submission time :
+ * the priorities of two jobs compare the same at any time.
+ */
+class PriorityFormula {
+private:
+    double weights[NumberOfPriorityFactors] = {};
+    /**
+     * Sum of the weighted factors depending only on the type of job and on the kind of user
+     */
+    double constantTerms[5][NumberOfUserKinds] = {};
+    double ageCoefficient = 0;
+    double sizeCoefficient = 0;
+    double fairShareCoefficient = 0;
+
+    /**
+     * Compute the constant terms and the coefficients from the weights
+     */
+    void compile();
+
+public:
+    /**
+     * Names of the factors in the expressions, in the order of PriorityFactor
+     */
+    static const char *const factorNames[NumberOfPriorityFactors];
+
+    /**
+     * Create the formula of the expression passed as parameter
+     * @param expression
+     * @throws std::invalid_argument if the expression is not valid (see parse)
+     */
+    explicit PriorityFormula(const std::string &expression = "");
+
+    /**
+     * Replace the weights by the ones of an expression
+     * @param expression sum of terms written weight*factor, or factor for a weight of 1
+     * @param error set to the reason of the failure
+     * @return false if the expression is not valid, the weights are then unchanged
+     */
+    bool parse(const std::string &expression, std::string &error);
+
+    double getWeight(PriorityFactor factor) const { return weights[factor]; };
+
+    void setWeight(PriorityFactor factor, double weight) {
+        weights[factor] = weight;
+        compile();
+    };
+
+    /**
+     * Return the priority of a job, up to a term common to all the jobs at a given time
+     * @param typeIndex of the job : small, medium, large, huge, gpu
+     * @param userKind of the user of the job
+     * @param submittingTime of the job
+     * @param numberOfNodes of the job
+     * @param fairShare factor of the user of the job
+     * @return
+     */
+    double evaluate(int typeIndex, UserKind userKind, double submittingTime, int numberOfNodes,
+                    double fairShare) const {
+        return constantTerms[typeIndex][userKind] - ageCoefficient * submittingTime +
+               sizeCoefficient * numberOfNodes + fairShareCoefficient * fairShare;
+    };
+};
+
+#endif //SUPERCOMPUTERSIMULATION_PRIORITYFORMULA_H
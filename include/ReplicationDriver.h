@@ -0,0 +1,97 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "HPCSimulator.h"
+
+/**
+ * This class runs independent replications of a simulation in parallel and aggregates their results.
+ * Every replication owns its simulator, scheduler, nodes and users, and draws its random numbers from
+ * a substream of the master seed, so the results only depend on the master seed and not on the
+ * number of threads.
+ */
+class ReplicationDriver {
+private:
+    /**
+     * Path to the file with the scenario, read by every replication
+     */
+    std::string inputFile;
+    /**
+     * Seed from which the seed of each replication is derived
+     */
+    uint64_t masterSeed;
+    /**
+     * Number of replications to run
+     */
+    int numberOfReplications;
+    /**
+     * Number of threads running the replications
+     */
+    int numberOfThreads;
+    /**
+     * Name of the event queue used by every replication (see createEventQueue)
+     */
+    std::string eventQueueName = "heap";
+    /**
+     * Name of the scheduler used by every replication, the one of the input file if empty
+     */
+    std::string schedulerName;
+    /**
+     * Parameters added to the ones of the input file for the scheduler
+     */
+    SchedulerParameters schedulerParameters;
+    /**
+     * Results of every replication, in the order of the replications
+     */
+    std::vector<SimulationResults> results;
+
+    /**
+     * Run one replication and store its results
+     * @param replication number of the replication
+     */
+    void runReplication(int replication);
+
+    /**
+     * Initialise a simulator from the input file, then apply the scheduler selected for the replications
+     * @param simulator
+     */
+    void initialise(HPCSimulator &simulator) const;
+
+public:
+    ReplicationDriver(const std::string &inputFile, uint64_t masterSeed, int numberOfReplications,
+                      int numberOfThreads);
+
+    void setEventQueueName(const std::string &name) { eventQueueName = name; };
+
+    void setSchedulerName(const std::string &name) { schedulerName = name; };
+
+    void setSchedulerParameter(const std::string &name, const std::string &value) {
+        schedulerParameters.set(name, value);
+    };
+
+    /**
+     * Check that the input file is valid and that the scheduler of the replications can be created
+     * @param error set to the reason of the failure
+     * @return
+     */
+    bool checkScheduler(std::string &error) const;
+
+    /**
+     * Run all the replications, on numberOfThreads threads
+     */
+    void run();
+
+    const std::vector<SimulationResults> &getResults() const { return results; };
+
+    /**
+     * Print the mean and the 95% confidence interval of every measurement
+     */
+    void printSummary() const;
+
+    /**
+     * Compute the half width of the 95% confidence interval of the mean of the values
+     * @param values
+     * @return 0 if there is less than two values
+     */
+    static double confidenceHalfWidth(const std::vector<double> &values);
+};
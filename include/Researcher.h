@@ -48,6 +48,8 @@ public:
      */
     void removeFromBudget(double amountToRemove) override;
 
+    Group *getGroup() const override { return group; };
+
 };
 
 
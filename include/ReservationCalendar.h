@@ -0,0 +1,98 @@
+#ifndef SUPERCOMPUTERSIMULATION_RESERVATIONCALENDAR_H
+#define SUPERCOMPUTERSIMULATION_RESERVATIONCALENDAR_H
+
+#include <vector>
+
+/**
+ * Nodes booked in advance for a maintenance window or a training session : no job may run on them from start to end
+ */
+struct Reservation {
+    /**
+     * Hours since the beginning of the simulation at which the nodes are taken
+     */
+    double start;
+    /**
+     * Hours since the beginning of the simulation at which the nodes are given back
+     */
+    double end;
+    /**
+     * Lowest id of the nodes reserved
+     */
+    int firstNode;
+    /**
+     * Highest id of the nodes reserved
+     */
+    int lastNode;
+
+    bool contains(int nodeId) const { return firstNode <= nodeId && nodeId <= lastNode; };
+};
+
+/**
+ * This class keeps the advance reservations of the platform in an interval tree over time.
+ * The reservations are sorted by start in a vector, which is the in-order walk of a balanced binary tree :
+ * the root of a range of reservations is its middle. Each root also keeps the latest end of its range, so
+ * a query skips the subtrees ending before the time window, and the right subtrees starting after it.
+ */
+class ReservationCalendar {
+private:
+    /**
+     * Reservations by increasing start
+     */
+    std::vector<Reservation> reservations;
+    /**
+     * Latest end of the reservations of the subtree rooted at each index
+     */
+    std::vector<double> latestEnd;
+
+    /**
+     * Compute the latest ends of the subtree made of the reservations in [first, last)
+     * @return latest end of the subtree
+     */
+    double build(size_t first, size_t last);
+
+    /**
+     * Add the reservations of the subtree [first, last) overlapping [from, to) to found
+     */
+    void collect(size_t first, size_t last, double from, double to, std::vector<const Reservation *> &found) const;
+
+public:
+    /**
+     * Add a reservation, the tree is built again
+     * @param reservation with a start before its end
+     */
+    void add(const Reservation &reservation);
+
+    /**
+     * Return the reservations by increasing start
+     * @return
+     */
+    const std::vector<Reservation> &getReservations() const { return reservations; };
+
+    /**
+     * Return the reservations overlapping a time window
+     * @param from start of the window
+     * @param to end of the window, excluded
+     * @return reservations starting before to and ending after from, by increasing start
+     */
+    std::vector<const Reservation *> overlapping(double from, double to) const;
+
+    /**
+     * Return whether a node has no reservation during a time window, for instance whether a job fits
+     * before the next reservation on the node
+     * @param nodeId
+     * @param from start of the window
+     * @param to end of the window, excluded
+     * @return
+     */
+    bool isFree(int nodeId, double from, double to) const;
+
+    /**
+     * Return whether a node is reserved at some time
+     * @param nodeId
+     * @param time
+     * @return true if a reservation of the node starts at or before time and ends after it
+     */
+    bool isReservedAt(int nodeId, double time) const;
+};
+
+#endif //SUPERCOMPUTERSIMULATION_RESERVATIONCALENDAR_H
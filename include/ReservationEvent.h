@@ -0,0 +1,53 @@
+#ifndef SUPERCOMPUTERSIMULATION_RESERVATIONEVENT_H
+#define SUPERCOMPUTERSIMULATION_RESERVATIONEVENT_H
+
+#include "Simulator.h"
+#include "AbstractScheduler.h"
+#include "ReservationCalendar.h"
+
+/**
+ * Beginning of an advance reservation : its nodes are taken from the scheduler
+ */
+class ReservationBegin : public Event {
+private:
+    /**
+     * scheduler giving the nodes
+     */
+    AbstractScheduler *scheduler;
+    Reservation reservation;
+
+public:
+    ReservationBegin(AbstractScheduler *scheduler, const Reservation &reservation);
+
+    /**
+     * Executing this event checkpoints the jobs still running on the reserved nodes, with preemption, and takes
+     * the free ones
+     * (see AbstractScheduler::beginReservation)
+     * @param simulator
+     */
+    void execute(AbstractSimulator *simulator) override;
+};
+
+/**
+ * End of an advance reservation : its nodes are given back to the scheduler
+ */
+class ReservationEnd : public Event {
+private:
+    /**
+     * scheduler getting the nodes back
+     */
+    AbstractScheduler *scheduler;
+    Reservation reservation;
+
+public:
+    ReservationEnd(AbstractScheduler *scheduler, const Reservation &reservation);
+
+    /**
+     * Executing this event gives back the nodes no other reservation keeps, then tries to start the jobs waiting
+     * (see AbstractScheduler::endReservation)
+     * @param simulator
+     */
+    void execute(AbstractSimulator *simulator) override;
+};
+
+#endif //SUPERCOMPUTERSIMULATION_RESERVATIONEVENT_H
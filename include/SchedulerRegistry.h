@@ -0,0 +1,133 @@
+#ifndef SUPERCOMPUTERSIMULATION_SCHEDULERREGISTRY_H
+#define SUPERCOMPUTERSIMULATION_SCHEDULERREGISTRY_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+class AbstractScheduler;
+
+/**
+ * Parameters of a scheduler, by name, as read from the input file or the command line
+ */
+class SchedulerParameters {
+private:
+    std::map<std::string, std::string> values;
+
+public:
+    void set(const std::string &name, const std::string &value) { values[name] = value; };
+
+    bool has(const std::string &name) const { return values.count(name) > 0; };
+
+    /**
+     * Return the value of a numerical parameter
+     * @param name of the parameter
+     * @param defaultValue returned if the parameter is not set
+     * @return
+     */
+    double get(const std::string &name, double defaultValue) const;
+
+    /**
+     * Return whether a parameter is set to a number, with nothing written after it
+     * @param name of the parameter
+     * @return
+     */
+    bool isNumber(const std::string &name) const;
+
+    /**
+     * Return the value of a parameter as it was written
+     * @param name of the parameter
+     * @param defaultValue returned if the parameter is not set
+     * @return
+     */
+    std::string getString(const std::string &name, const std::string &defaultValue) const;
+
+    const std::map<std::string, std::string> &getValues() const { return values; };
+
+    void clear() { values.clear(); };
+};
+
+/**
+ * What the registry knows about a scheduler : its name, a one line description, the parameters it
+ * accepts and the function creating it
+ */
+struct SchedulerDescription {
+    std::string name;
+    std::string description;
+    std::vector<std::string> parameterNames;
+
+    AbstractScheduler *(*create)(const SchedulerParameters &parameters);
+
+    /**
+     * Check the values of the parameters, nullptr if any value is accepted
+     */
+    bool (*validate)(const SchedulerParameters &parameters, std::string &error);
+};
+
+/**
+ * Registry of the schedulers which can be selected by name when the simulation starts.
+ * The schedulers of the project are registered from the start, a new scheduler is made available by adding
+ * its description before any simulation runs.
+ */
+class SchedulerRegistry {
+private:
+    static std::vector<SchedulerDescription> &registeredSchedulers();
+
+public:
+    /**
+     * Register a scheduler, replacing the one of the same name if any
+     * @param description of the scheduler
+     */
+    static void add(const SchedulerDescription &description);
+
+    /**
+     * Return the description of a scheduler
+     * @param name of the scheduler
+     * @return nullptr if no scheduler of this name is registered
+     */
+    static const SchedulerDescription *find(const std::string &name);
+
+    /**
+     * Return the descriptions of all the registered schedulers, in order of registration
+     * @return
+     */
+    static const std::vector<SchedulerDescription> &descriptions() { return registeredSchedulers(); };
+
+    /**
+     * Return the parameters accepted by every scheduler : weekendPacking, set to 1 to select the jobs run
+     * during the week-end with a WeekendPlanner, maxSkippedWeekends, the number of week-ends a huge job
+     * can then be left waiting (2 by default), preemption, set to 1 to let the jobs run into the week-end
+     * and checkpoint them for the huge jobs, checkpointOverhead, in hours (0.5 by default), partitionPeriod,
+     * the hours between two resizings of the partitions of reserved nodes by a PartitionController (0, never,
+     * by default), and the bounds of the partitions minSmallNodes, maxSmallNodes, minMediumNodes and
+     * maxMediumNodes (6, 13, 19 and 39 by default)
+     * @return
+     */
+    static const std::vector<std::string> &commonParameterNames();
+
+    /**
+     * Return the parameters whose value is not a number : priority, the formula of the multifactor scheduler
+     * @return
+     */
+    static const std::vector<std::string> &textParameterNames();
+
+    /**
+     * Check that a scheduler is registered and accepts the parameters passed and their values,
+     * the values of all the parameters but the text ones being numbers
+     * @param name of the scheduler
+     * @param parameters given to the scheduler
+     * @param error set to the reason of the failure
+     * @return true if the scheduler can be created
+     */
+    static bool check(const std::string &name, const SchedulerParameters &parameters, std::string &error);
+
+    /**
+     * Create a scheduler
+     * @param name of the scheduler
+     * @param parameters given to the scheduler
+     * @return a new scheduler, or nullptr if check fails
+     */
+    static AbstractScheduler *create(const std::string &name, const SchedulerParameters &parameters);
+};
+
+#endif //SUPERCOMPUTERSIMULATION_SCHEDULERREGISTRY_H
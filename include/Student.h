@@ -45,6 +45,8 @@ public:
 
     Student &operator=(const Student &g) = delete;
 
+    Curriculum *getCurriculum() const override { return curriculum; };
+
 };
 
 
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BinaryTrace.h"
+
+/**
+ * Levels of the trace of a simulation, each level includes the previous ones
+ */
+enum TraceLevel {
+    /**
+     * Nothing is traced
+     */
+    TraceOff = 0,
+    /**
+     * Initialisation of the simulation and weekend boundaries
+     */
+    TraceInfo = 1,
+    /**
+     * Every event : submission and completion of the jobs, time of each event
+     */
+    TraceEvents = 2
+};
+
+/**
+ * Highest level compiled in the program, the traces above are removed by the compiler.
+ * Set with the cmake cache variable of the same name.
+ */
+#ifndef HPC_TRACE_LEVEL
+#define HPC_TRACE_LEVEL 2
+#endif
+
+/**
+ * Trace a message if the level is compiled in and enabled in the tracer of the simulator.
+ * The message is only built when it is traced, e.g. HPC_TRACE(simulator, TraceInfo, "Weekend Start\n");
+ */
+#define HPC_TRACE(simulator, level, message)                                                \
+    do {                                                                                    \
+        if ((level) <= HPC_TRACE_LEVEL && (simulator)->getTracer().isEnabled(level)) {      \
+            (simulator)->getTracer().stream() << message;                                   \
+        }                                                                                   \
+    } while (false)
+
+/**
+ * Write a record in the binary trace of the simulator if it has one and tracing is compiled in.
+ * The record is only built when it is written, e.g. HPC_TRACE_RECORD(simulator, job->traceRecord(RecordJobStart, now));
+ */
+#define HPC_TRACE_RECORD(simulator, traceRecord)                                            \
+    do {                                                                                    \
+        if (HPC_TRACE_LEVEL > TraceOff && (simulator)->getTracer().isRecording()) {         \
+            (simulator)->getTracer().record(traceRecord);                                   \
+        }                                                                                   \
+    } while (false)
+
+/**
+ * Destination of the characters traced
+ */
+class TraceSink {
+public:
+    virtual void write(const char *characters, size_t count) = 0;
+
+    virtual void flush() {}
+
+    virtual ~TraceSink() {}
+};
+
+/**
+ * Write the trace to an output stream (std::cout by default)
+ */
+class StreamTraceSink : public TraceSink {
+private:
+    std::ostream &out;
+public:
+    explicit StreamTraceSink(std::ostream &out = std::cout) : out(out) {};
+
+    void write(const char *characters, size_t count) override;
+
+    void flush() override;
+};
+
+/**
+ * Write the trace to a file
+ */
+class FileTraceSink : public TraceSink {
+private:
+    std::ofstream file;
+public:
+    explicit FileTraceSink(const std::string &filename);
+
+    bool isOpen() const { return file.is_open(); };
+
+    void write(const char *characters, size_t count) override;
+
+    void flush() override;
+};
+
+/**
+ * Keep the last characters of the trace in memory, the oldest ones are overwritten
+ */
+class RingTraceSink : public TraceSink {
+private:
+    std::vector<char> ring;
+    /**
+     * Position where the next character is written
+     */
+    size_t next = 0;
+    bool full = false;
+public:
+    /**
+     * @param capacity number of characters kept
+     */
+    explicit RingTraceSink(size_t capacity);
+
+    void write(const char *characters, size_t count) override;
+
+    /**
+     * Return the characters kept, from the oldest to the newest
+     * @return
+     */
+    std::string contents() const;
+};
+
+/**
+ * Buffer in which the messages are formatted before being written to the sink by large blocks
+ */
+class TraceBuffer : public std::streambuf {
+private:
+    std::vector<char> buffer;
+    TraceSink *sink;
+
+    void writeBuffer();
+
+protected:
+    int_type overflow(int_type character) override;
+
+    int sync() override;
+
+public:
+    TraceBuffer(TraceSink *sink, size_t capacity);
+
+    void setSink(TraceSink *newSink);
+};
+
+/**
+ * This class holds the trace of a simulation. The messages are buffered and written to the sink
+ * when the buffer is full or when the tracer is flushed, never after each line.
+ */
+class Tracer {
+private:
+    TraceLevel level = TraceEvents;
+    /**
+     * Sink owned by the tracer
+     */
+    TraceSink *sink;
+    TraceBuffer buffer;
+    std::ostream out;
+    /**
+     * Binary trace owned by the tracer, nullptr if the records are not written
+     */
+    BinaryTraceWriter *binaryTrace = nullptr;
+
+public:
+    static const size_t bufferSize = 1 << 16;
+
+    Tracer();
+
+    Tracer(const Tracer &tracer) = delete;
+
+    Tracer &operator=(const Tracer &tracer) = delete;
+
+    /**
+     * Flush the trace and delete the sink and the binary trace
+     */
+    ~Tracer();
+
+    bool isEnabled(TraceLevel messageLevel) const { return messageLevel <= level; };
+
+    TraceLevel getLevel() const { return level; };
+
+    void setLevel(TraceLevel newLevel) { level = newLevel; };
+
+    /**
+     * Flush the trace to the current sink and replace it, the tracer takes the ownership of the sink
+     * @param newSink
+     */
+    void setSink(TraceSink *newSink);
+
+    TraceSink *getSink() { return sink; };
+
+    /**
+     * Stream in which the messages are formatted, use HPC_TRACE instead of writing directly
+     * @return
+     */
+    std::ostream &stream() { return out; };
+
+    /**
+     * Set the binary trace receiving the records, the tracer takes the ownership of the writer
+     * @param writer
+     */
+    void setBinaryTrace(BinaryTraceWriter *writer);
+
+    bool isRecording() const { return binaryTrace != nullptr; };
+
+    /**
+     * Write a record in the binary trace, use HPC_TRACE_RECORD instead of calling it directly
+     * @param traceRecord
+     */
+    void record(const BinaryTraceRecord &traceRecord) { binaryTrace->write(traceRecord); };
+
+    /**
+     * Write the buffered messages to the sink and the buffered records to the binary trace
+     */
+    void flush();
+};
+
+/**
+ * Parse the name of a trace level : "off", "info" or "events"
+ * @param name
+ * @param level set if the name is known
+ * @return false if the name is unknown
+ */
+bool parseTraceLevel(const std::string &name, TraceLevel &level);
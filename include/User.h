@@ -4,11 +4,17 @@
 #include <unordered_set>
 #include "AbstractScheduler.h"
 #include "HPCParameters.h"
+#include "random.h"
 /*
 * Generate a stream of jobs for 8.0 time units.
 */
 
 class AbstractScheduler;
+
+class Group;
+
+class Curriculum;
+
 /**
  * User class specify  the behavior of Users.
  * Users events corresponds to a user creating a new job and trying to submit it.
@@ -34,13 +40,9 @@ protected:
      */
     AbstractScheduler *scheduler;
     /**
-     * Static variable used as counter to give a unique id to each User
-     */
-    static int numOfUsers;
-    /**
-     * User unique Id
+     * User unique Id, given by the simulation
      */
-    int userId;
+    int userId = 0;
     /**
      * mean time between to different jobs created by the user
      */
@@ -51,6 +53,40 @@ protected:
      */
     bool permissions[5]={0, 0, 0, 0, 0};
 
+    /**
+     * Random stream for the time between two jobs
+     */
+    RandomStream arrivalStream;
+    /**
+     * Random stream for the type of the jobs
+     */
+    RandomStream jobTypeStream;
+    /**
+     * Random stream for the requirements (duration and number of nodes) of the jobs
+     */
+    RandomStream requirementsStream;
+    /**
+     * Random stream for the number of cores of the jobs sharing their nodes, seeded by seedRandomStreams
+     */
+    RandomStream coresStream{0};
+    /**
+     * Random stream for the range of nodes and the serial fraction of the moldable jobs, seeded by seedRandomStreams
+     */
+    RandomStream scalingStream{0};
+    /**
+     * Random stream for the I/O intensity of the jobs, seeded by seedRandomStreams
+     */
+    RandomStream ioStream{0};
+    /**
+     * True if the time of the first job has been given at the creation of the user
+     */
+    bool firstJobTimeFixed = false;
+    /**
+     * Factor by which the walltime the user declares exceeds the execution duration of its jobs, 1 when the
+     * user declares no walltime
+     */
+    double walltimeOverestimate = 1;
+
 
 public:
     /**
@@ -72,8 +108,11 @@ public:
     int getUserId() const;
 
     /**
-     * set userId and Increment the number of user
+     * Set the user Id, unique in the simulation
+     * @param id
      */
+    void setUserId(int id);
+
     User();
 
     User(double meanTimeBetweenToJobs);
@@ -110,6 +149,18 @@ public:
      */
     virtual void removeFromBudget(double amountToRemove);
 
+    /**
+     * Return the research group of the user
+     * @return nullptr if the user is not a researcher
+     */
+    virtual Group *getGroup() const { return nullptr; };
+
+    /**
+     * Return the curriculum of the user
+     * @return nullptr if the user is not a student
+     */
+    virtual Curriculum *getCurriculum() const { return nullptr; };
+
     /**
      * Decrease the number of job currently used by this user
      * @param numberOfNodes
@@ -118,6 +169,22 @@ public:
         currentlyUsedNumberOfNodes -= numberOfNodes;
     };
 
+    /**
+     * Derive the random streams of the user from the master seed of the simulation, so that
+     * the jobs created by the user only depend on the master seed and on the user number.
+     * The time of the first job is drawn again unless it has been fixed at the creation.
+     * @param masterSeed of the simulation
+     * @param userNumber position of the user in the simulation, the same from one run to the other
+     */
+    void seedRandomStreams(uint64_t masterSeed, uint64_t userNumber);
+
+    /**
+     * Make the user declare for each job a walltime longer than its execution duration, within the maximum
+     * time of its type
+     * @param factor by which the execution duration is multiplied, at least 1
+     */
+    void setWalltimeOverestimate(double factor) { walltimeOverestimate = factor; };
+
     /**
      * Set the permissions of this user.
      */
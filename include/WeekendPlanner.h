@@ -0,0 +1,79 @@
+#ifndef SUPERCOMPUTERSIMULATION_WEEKENDPLANNER_H
+#define SUPERCOMPUTERSIMULATION_WEEKENDPLANNER_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <vector>
+
+class AbstractJob;
+
+/**
+ * This class selects the jobs run during the week-end : the set of huge jobs, completed by shorter jobs
+ * from the other queues, which uses the most node-hours before monday morning on the free nodes.
+ * It is a 0/1 knapsack on the number of nodes. A huge job can be left out of the selection at the beginning
+ * of a limited number of week-ends, it is then started before any other job.
+ */
+class WeekendPlanner {
+private:
+    /**
+     * Number of week-ends a huge job can be left waiting before it has to be started
+     */
+    int maxSkippedWeekends;
+    /**
+     * Number of week-ends each waiting huge job has been left waiting
+     */
+    std::map<const AbstractJob *, int> skippedWeekends;
+
+public:
+    explicit WeekendPlanner(int maxSkippedWeekends) : maxSkippedWeekends(maxSkippedWeekends) {};
+
+    /**
+     * Select the items of largest total value whose total size fits in the capacity.
+     * On equal values the first items are preferred.
+     * @param sizes of the items
+     * @param values of the items
+     * @param capacity
+     * @return the positions of the selected items, in increasing order
+     */
+    static std::vector<size_t> knapsack(const std::vector<int> &sizes, const std::vector<double> &values,
+                                        int capacity);
+
+    /**
+     * Select the jobs to start on the free nodes : the huge jobs left waiting for too many week-ends first, in
+     * order of submission, then the huge jobs and the other jobs ending before monday morning which use the most
+     * node-hours. When a huge job which must start does not fit, nothing else is selected.
+     * @param hugeJobs waiting, in order of submission
+     * @param otherJobs waiting, by decreasing priority
+     * @param numberOfNodes free, the huge jobs may use any of them
+     * @param hoursUntilMonday before which the jobs which are not forced must end
+     * @param fits whether a job may start on the free nodes of its classes and end before their reservations
+     * @return the jobs selected, in the order in which they are started
+     */
+    std::vector<AbstractJob *> select(const std::vector<AbstractJob *> &hugeJobs,
+                                      const std::vector<AbstractJob *> &otherJobs, int numberOfNodes,
+                                      double hoursUntilMonday, const std::function<bool(AbstractJob *)> &fits) const;
+
+    /**
+     * Return whether a huge job has been left waiting for too many week-ends
+     * @param job
+     * @return
+     */
+    bool mustStart(const AbstractJob *job) const;
+
+    /**
+     * Count a week-end during which a huge job has been left waiting
+     * @param job
+     */
+    void skipped(const AbstractJob *job) { skippedWeekends[job]++; };
+
+    /**
+     * Forget a huge job which has started
+     * @param job
+     */
+    void started(const AbstractJob *job) { skippedWeekends.erase(job); };
+
+    int getSkippedWeekends(const AbstractJob *job) const;
+};
+
+#endif //SUPERCOMPUTERSIMULATION_WEEKENDPLANNER_H
@@ -1,22 +1,125 @@
 #pragma once
 
 #include <random>
+#include <cstdint>
+#include <vector>
+
+/**
+ * This class implements the xoshiro256** pseudo random generator of D. Blackman and S. Vigna.
+ * It is much faster than the Mersenne Twister and its state is only 32 bytes long.
+ * It satisfies the requirements of a uniform random bit generator, so it can be used
+ * with the distributions of the standard library.
+ */
+class Xoshiro256StarStar {
+private:
+    uint64_t state[4];
+
+    static uint64_t rotateLeft(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    typedef uint64_t result_type;
+
+    explicit Xoshiro256StarStar(uint64_t seedValue = 0) { seed(seedValue); }
+
+    /**
+     * Initialise the state from a 64 bits seed using splitmix64, as recommended by the authors
+     * @param seedValue
+     */
+    void seed(uint64_t seedValue) {
+        for (uint64_t &word : state) {
+            seedValue += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seedValue;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() {
+        const uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotateLeft(state[3], 45);
+        return result;
+    }
+};
+
+/**
+ * Engine used for every random number of the simulation.
+ * Define HPC_RANDOM_MT19937 (cmake option of the same name) to use the Mersenne Twister instead.
+ */
+#ifdef HPC_RANDOM_MT19937
+typedef std::mt19937_64 RandomEngine;
+#else
+typedef Xoshiro256StarStar RandomEngine;
+#endif
 
 /**
  * This class implements methods for simplifying the generation of random numbers following different distributions
+ * Each stream owns its engine, so that independent parts of the simulation can draw their numbers
+ * in a reproducible way whatever the order in which they are called.
  */
-class Random {
+class RandomStream {
+private:
+    RandomEngine engine;
+
 public:
+/**
+ * Create a stream seeded with the value passed as parameter
+ * @param seed
+ */
+    explicit RandomStream(uint64_t seed) : engine(seed) {};
+
+/**
+ * Return the seed of the substream number streamNumber derived from masterSeed.
+ * Substreams of a same master seed are statistically independent and always the same,
+ * which allows every part of a simulation to have its own reproducible stream.
+ * @param masterSeed
+ * @param streamNumber
+ * @return
+ */
+    static uint64_t substreamSeed(uint64_t masterSeed, uint64_t streamNumber) {
+        uint64_t z = masterSeed ^ ((streamNumber + 1) * 0x9E3779B97F4A7C15ULL);
+        for (int round = 0; round < 2; ++round) {
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            z = z ^ (z >> 31);
+        }
+        return z;
+    }
+
+/**
+ * Seed the stream so that the following draws are reproducible
+ * @param seed
+ */
+    void seed(uint64_t seed) {
+        engine.seed(seed);
+    }
+
+/**
+ * Return a raw 64 bits random number, for instance for seeding an other stream
+ * @return
+ */
+    uint64_t nextSeed() {
+        return engine();
+    }
+
 /**
  * Generate a random number using a exponential distribution with a average number corresponding to mean parameter
  * @param mean
  * @return
  */
-    static double exponential(double mean) {
-        std::random_device rd;
-        std::mt19937 rnd_gen(rd());
+    double exponential(double mean) {
         std::exponential_distribution<> rng(1 / mean);
-        return rng(rnd_gen);
+        return rng(engine);
     }
 /**
  * Generate a random number using a uniform law to generate a number between min and max parameters
@@ -24,11 +127,9 @@ public:
  * @param max
  * @return
  */
-    static double uniformDouble(double min, double max) {
-        std::random_device rd;
-        std::mt19937 rnd(rd());
+    double uniformDouble(double min, double max) {
         std::uniform_real_distribution<double> uni(min, max);
-        return uni(rnd);
+        return uni(engine);
     }
 
 /**
@@ -38,11 +139,9 @@ public:
  * @param stddev
  * @return
  */
-    static double normalDouble(double mean, double stddev) {
-        std::random_device rd;
-        std::mt19937 rnd(rd());
+    double normalDouble(double mean, double stddev) {
         std::normal_distribution<double> norm(mean, stddev);
-        return norm(rnd);
+        return norm(engine);
     }
 /**
  * Generates a random integer following a binomial law of parmeters n and p
@@ -50,11 +149,9 @@ public:
  * @param p
  * @return
  */
-    static int binomialInt(int n, double p) {
-        std::random_device rd;
-        std::mt19937 rnd(rd());
-        std::binomial_distribution<int> bin(n, 0.5);
-        return bin(rnd);
+    int binomialInt(int n, double p) {
+        std::binomial_distribution<int> bin(n, p);
+        return bin(engine);
     }
 /**
  * Generate a random integer using a uniform law to generate a number between min and max parameters
@@ -62,11 +159,52 @@ public:
  * @param max
  * @return
  */
-    static double uniformInt(double min, double max) {
-        std::random_device rd;
-        std::mt19937 rng(rd());    // random-number engine used (Mersenne-Twister in this case)
+    double uniformInt(double min, double max) {
         std::uniform_int_distribution<int> uni(min, max); // guaranteed unbiased //
-        return uni(rng);
+        return uni(engine);
+    }
+
+/**
+ * Generate a random index following the relative weights passed as parameter
+ * @param weights
+ * @return
+ */
+    int discreteInt(const std::vector<int> &weights) {
+        std::discrete_distribution<int> distribution(weights.begin(), weights.end());
+        return distribution(engine);
+    }
+};
+
+/**
+ * This class gives access to one random stream per thread, created and seeded once.
+ * The stream is seeded from the random device unless a seed is given with Random::seed.
+ */
+class Random {
+public:
+/**
+ * Return the stream of the calling thread
+ * @return
+ */
+    static RandomStream &stream() {
+        thread_local RandomStream threadStream(std::random_device{}() * 0x100000000ULL + std::random_device{}());
+        return threadStream;
     }
 
+/**
+ * Seed the stream of the calling thread so that the following draws are reproducible
+ * @param seed
+ */
+    static void seed(uint64_t seed) { stream().seed(seed); }
+
+    static double exponential(double mean) { return stream().exponential(mean); }
+
+    static double uniformDouble(double min, double max) { return stream().uniformDouble(min, max); }
+
+    static double normalDouble(double mean, double stddev) { return stream().normalDouble(mean, stddev); }
+
+    static int binomialInt(int n, double p) { return stream().binomialInt(n, p); }
+
+    static double uniformInt(double min, double max) { return stream().uniformInt(min, max); }
+
+    static int discreteInt(const std::vector<int> &weights) { return stream().discreteInt(weights); }
 };
\ No newline at end of file
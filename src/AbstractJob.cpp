@@ -1,15 +1,9 @@
+#include <algorithm>
 #include "../include/AbstractJob.h"
 #include "../include/User.h"
 #include "../include/random.h"
 #include "../include/HPCParameters.h"
-
-//Initializing the abstract job static counter variable
-int AbstractJob::jobCounter = 0;
-
-
-AbstractJob::AbstractJob() {
-    id = ++jobCounter;
-}
+#include "../include/JobCompletion.h"
 
 //Defining a template for creating a new instance
 template<typename T>
@@ -30,18 +24,23 @@ CreateJobFn create[] =
 const size_t fncount = sizeof(create) / sizeof(*create);
 
 
-AbstractJob *CreateRandomJob(const bool permissions[5]) {
+AbstractJob *CreateRandomJob(const bool permissions[5], RandomStream &stream) {
     std::vector <int> proportionsWithPermissions= {0,0,0,0,0};
     for (int i = 0; i < 5; ++i) {
         if (permissions[i]){
             proportionsWithPermissions[i]=HPCParameters::jobTypeProportions[i];
         }
     }
-    std::random_device randomDevice;
-    std::mt19937 randomGenerator(randomDevice());
-    std::discrete_distribution<int> distribution (proportionsWithPermissions.begin(),proportionsWithPermissions.end());
+    return create[stream.discreteInt(proportionsWithPermissions)](); //forward the call
+}
 
-    return create[ distribution (randomGenerator)](); //forward the call
+AbstractJob::~AbstractJob() {
+    delete completion;
+}
+
+BinaryTraceRecord AbstractJob::traceRecord(TraceRecordKind kind, double time) {
+    return BinaryTraceRecord{time, executionDuration, submittingTime, kind, id, user != nullptr ? user->getUserId() : -1,
+                             getTypeIndex(), numberOfNodes, -1};
 }
 
 void LargeJob::insertIn(AbstractSimulator *simulator, AbstractScheduler *scheduler) {
@@ -65,7 +64,7 @@ void HugeJob::insertIn(AbstractSimulator *simulator, AbstractScheduler *schedule
 }
 
 
-void AbstractJob::generateRandomTime(double minTime, double maxTime) {
+void AbstractJob::generateRandomTime(double minTime, double maxTime, RandomStream &stream) {
     /*We use the fact that 99.7% of the time, a random variable following a normal
      * is not further than three times the standard deviation from the mean value
      * Therefore we set the mean value in the middle of our interval
@@ -74,36 +73,73 @@ void AbstractJob::generateRandomTime(double minTime, double maxTime) {
     double timeMean = 0.5 * (minTime + maxTime);
     double timeStddev = (maxTime - minTime) / 6;
     do {
-        executionDuration = Random::normalDouble(timeMean, timeStddev);
+        executionDuration = stream.normalDouble(timeMean, timeStddev);
     } while (minTime > executionDuration || maxTime < executionDuration);
+    remainingDuration = executionDuration;
+}
+
+void AbstractJob::generateRandomRange(int lowestNumberOfNodes, RandomStream &stream) {
+    minNumberOfNodes = std::max(lowestNumberOfNodes, numberOfNodes / 2);
+    serialFraction = stream.uniformDouble(0, 0.2);
+}
+
+void AbstractJob::generateRandomIoIntensity(RandomStream &stream) {
+    ioIntensity = stream.uniformDouble(0, 0.4);
+}
+
+void AbstractJob::mold(int nodes) {
+    double scaling = getWalltimeOn(nodes) / getWalltime();
+    executionDuration *= scaling;
+    remainingDuration *= scaling;
+    declaredWalltime *= scaling;
+    // the user counted the nodes required when the job was submitted
+    if (user != nullptr) {
+        user->reduceNumberOfCurrentlyUsedNodeBy(numberOfNodes - nodes);
+    }
+    numberOfNodes = nodes;
+    minNumberOfNodes = 0;
 }
 
 //TODO : ASSUMPTION on minimum limits
-void LargeJob::generateRandomRequirements() {
-    generateRandomTime(HPCParameters::mediumMaximumTime, HPCParameters::largeMaximumTime);
+void LargeJob::generateRandomRequirements(RandomStream &stream) {
+    generateRandomTime(HPCParameters::mediumMaximumTime, HPCParameters::largeMaximumTime, stream);
     numberOfNodes = HPCParameters::mediumMaxNumberOfNode +
-                    Random::binomialInt(HPCParameters::largeMaxNumberOfNode - HPCParameters::mediumMaxNumberOfNode, 0.5);
+                    stream.binomialInt(HPCParameters::largeMaxNumberOfNode - HPCParameters::mediumMaxNumberOfNode, 0.5);
 }
 
-void HugeJob::generateRandomRequirements() {
-    generateRandomTime(HPCParameters::largeMaximumTime, HPCParameters::hugeMaximumTime);
+void HugeJob::generateRandomRequirements(RandomStream &stream) {
+    generateRandomTime(HPCParameters::largeMaximumTime, HPCParameters::hugeMaximumTime, stream);
     numberOfNodes = HPCParameters::largeMaxNumberOfNode +
-                    Random::binomialInt(HPCParameters::hugeMaxNumberOfNode - HPCParameters::largeMaxNumberOfNode, 0.5);
+                    stream.binomialInt(HPCParameters::hugeMaxNumberOfNode - HPCParameters::largeMaxNumberOfNode, 0.5);
 }
 
-void MediumJob::generateRandomRequirements() {
-    generateRandomTime(HPCParameters::smallMaximumTime, HPCParameters::mediumMaximumTime);
+void MediumJob::generateRandomRequirements(RandomStream &stream) {
+    generateRandomTime(HPCParameters::smallMaximumTime, HPCParameters::mediumMaximumTime, stream);
     numberOfNodes = HPCParameters::smallMaxNumberOfNode +
-                    Random::binomialInt(HPCParameters::mediumMaxNumberOfNode - HPCParameters::smallMaxNumberOfNode, 0.5);
+                    stream.binomialInt(HPCParameters::mediumMaxNumberOfNode - HPCParameters::smallMaxNumberOfNode, 0.5);
+}
+/* A moldable large job keeps more nodes than a medium job */
+void LargeJob::generateRandomScaling(RandomStream &stream) {
+    generateRandomRange(HPCParameters::mediumMaxNumberOfNode, stream);
 }
-void SmallJob::generateRandomRequirements() {
-    generateRandomTime(0, HPCParameters::smallMaximumTime);
-    numberOfNodes = 1+Random::binomialInt(HPCParameters::smallMaxNumberOfNode - 1, 0.5);
+
+void HugeJob::generateRandomScaling(RandomStream &stream) {
+    generateRandomRange(HPCParameters::largeMaxNumberOfNode, stream);
+}
+
+/* Most small jobs only use a few cores of their node */
+void SmallJob::generateRandomCores(RandomStream &stream) {
+    numberOfCores = 1 + stream.binomialInt(HPCParameters::coresPerNode - 1, 0.25);
+}
+
+void SmallJob::generateRandomRequirements(RandomStream &stream) {
+    generateRandomTime(0, HPCParameters::smallMaximumTime, stream);
+    numberOfNodes = 1+stream.binomialInt(HPCParameters::smallMaxNumberOfNode - 1, 0.5);
 }
 
-void GpuJob::generateRandomRequirements() {
-	generateRandomTime(0, HPCParameters::gpuMaximumTime);
-	numberOfNodes = 1 + Random::binomialInt(HPCParameters::gpuMaxNumberOfNode - 1, 0.5);
+void GpuJob::generateRandomRequirements(RandomStream &stream) {
+	generateRandomTime(0, HPCParameters::gpuMaximumTime, stream);
+	numberOfNodes = 1 + stream.binomialInt(HPCParameters::gpuMaxNumberOfNode - 1, 0.5);
 }
 
 void HugeJob::tryToExecute(AbstractSimulator *simulator, AbstractScheduler *scheduler) {
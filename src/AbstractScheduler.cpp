@@ -1,7 +1,21 @@
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 #include "../include/AbstractScheduler.h"
 #include "../include/User.h"
+#include "../include/JobCompletion.h"
 
+/*
+ * The times are sums of fractions of hours, a job ending right at the week-end cut-off must not be refused
+ * because of a rounding error on the hours left
+ */
+static const double roundingError = 1e-9;
+
+/*
+ * Hours in a week, and from monday 9 AM to the week-end on friday 5 PM
+ */
+static const double numberOfHoursInAWeek = 168;
+static const double numberOfHoursBeforeWeekend = 104;
 
 bool comparingJobsPointersSubmittingTime(AbstractJob *i, AbstractJob *j) { return j->getSubmittingTime() < i->getSubmittingTime(); }
 
@@ -9,19 +23,25 @@ bool comparingJobsPointersSubmittingTime(AbstractJob *i, AbstractJob *j) { retur
  * Assuming that the simulation start at Monday 9 AM.
  */
 bool isDuringWeekend(double time) {
-    const double numberOfHourInTheWeek = 168;
-    const double startingWeekendTime = 104;
-    double mod = fmod(time, numberOfHourInTheWeek);
-    return (mod > startingWeekendTime);
+    double mod = fmod(time, numberOfHoursInAWeek);
+    return (mod > numberOfHoursBeforeWeekend);
+}
+
+double hoursUntilNextWeekend(double time) {
+    return std::max(0.0, numberOfHoursBeforeWeekend - fmod(time, numberOfHoursInAWeek));
+}
+
+double hoursUntilMonday(double time) {
+    return (std::floor(time / numberOfHoursInAWeek) + 1) * numberOfHoursInAWeek - time;
 }
 
 
 AbstractScheduler::AbstractScheduler() {
-    mediumJobs = new std::list<MediumJob *>;
-    smallJobs = new std::list<SmallJob *>;
-    largeJobs = new std::list<LargeJob *>;
-    hugeJobs = new std::list<HugeJob *>;
-    gpuJobs = new std::list<GpuJob *>;
+    mediumJobs = new JobQueue<MediumJob>(&nextJobIndex, MediumJobQueue);
+    smallJobs = new JobQueue<SmallJob>(&nextJobIndex, SmallJobQueue);
+    largeJobs = new JobQueue<LargeJob>(&nextJobIndex, LargeJobQueue);
+    hugeJobs = new JobQueue<HugeJob>();
+    gpuJobs = new JobQueue<GpuJob>(&nextJobIndex, GpuJobQueue);
 
 }
 
@@ -31,35 +51,63 @@ AbstractScheduler::~AbstractScheduler() {
     delete hugeJobs;
     delete smallJobs;
     delete gpuJobs;
+    delete weekendPlanner;
+    delete partitionController;
+    delete ioContention;
+    delete reservationCalendar;
+}
 
+void AbstractScheduler::setWeekendPlanner(WeekendPlanner *planner) {
+    delete weekendPlanner;
+    weekendPlanner = planner;
 }
 
-void Scheduler::addFreeMediumNode(AbstractSimulator *simulator, ReservedForMediumJobNode *node) {
-    this->freeMediumNodes.push(node);
-    //if we are during the week and there is enough time for a medium job we try to tun the next one
-    if (!isDuringWeekend(simulator->now()) && !isDuringWeekend(simulator->now() + HPCParameters::mediumMaximumTime)) {
-        tryToExecuteNextMediumJob(simulator);
-    }
+void AbstractScheduler::setPartitionController(PartitionController *controller) {
+    delete partitionController;
+    partitionController = controller;
 }
 
-void Scheduler::addFreeSmallNode(AbstractSimulator *simulator, ReservedForSmallJobNode *node) {
-    this->freeSmallNodes.push(node);
-    //if we are during the week and there is enough time for a small job we try to tun the next one
-    if (!isDuringWeekend(simulator->now()) && !isDuringWeekend(simulator->now() + HPCParameters::smallMaximumTime)) {
-        tryToExecuteNextSmallJob(simulator);
-    }
+void AbstractScheduler::setTopology(int numberOfNodes, double penalty, bool compactPlacement) {
+    nodesPerRack = numberOfNodes;
+    communicationPenalty = penalty;
+    freeNodePool.setNodesPerRack(compactPlacement ? numberOfNodes : 0);
+}
+
+void AbstractScheduler::setFilesystemBandwidth(double bandwidth) {
+    delete ioContention;
+    ioContention = new IoContention(bandwidth);
+}
+
+void AbstractScheduler::setReservationCalendar(ReservationCalendar *calendar) {
+    delete reservationCalendar;
+    reservationCalendar = calendar;
+}
+
+void AbstractScheduler::enablePreemption(double overhead) {
+    preemption = true;
+    checkpointOverhead = overhead;
+}
+
+void Scheduler::addFreeMediumNode(AbstractSimulator *simulator, Node *node) {
+    freeNodePool.release(MediumNodeClass, node);
+    tryToExecuteNextMediumJob(simulator);
+}
+
+void Scheduler::addFreeSmallNode(AbstractSimulator *simulator, Node *node) {
+    freeNodePool.release(SmallNodeClass, node);
+    tryToExecuteNextSmallJob(simulator);
 }
 
 void Scheduler::addFreeNode(class AbstractSimulator *simulator, class Node *node) {
-    this->freeNodes.push(node);
+    freeNodePool.release(NormalNodeClass, node);
     tryToExecuteNextNonGpuJobShortEnough(simulator);
 
 }
 
 void Scheduler::addFreeGpuNode(AbstractSimulator *simulator, GpuNode *node) {
-    this->freeGpuNodes.push(node);
+    freeNodePool.release(GpuNodeClass, node);
     if (!gpuJobs->empty() && gpuJobs->front() == nextJob()) {
-        if (!isDuringWeekend(simulator->now()) && !isDuringWeekend(simulator->now() + HPCParameters::gpuMaximumTime)) {
+        if (endsBeforeWeekend(gpuJobs->front(), simulator->now())) {
             tryToExecuteNextGpuJob(simulator);
         } else {
             tryToExecuteNextNonGpuJobShortEnough(simulator);
@@ -71,8 +119,7 @@ void Scheduler::addFreeGpuNode(AbstractSimulator *simulator, GpuNode *node) {
 
 
 void Scheduler::insertMediumJob(AbstractSimulator *simulator, MediumJob *job) {
-    if (!isDuringWeekend(simulator->now()) && mediumJobs->empty() &&
-        !isDuringWeekend(simulator->now() + HPCParameters::mediumMaximumTime)) {
+    if (mediumJobs->empty() && endsBeforeWeekend(job, simulator->now())) {
         mediumJobs->push_back(job);
         tryToExecuteNextMediumJob(simulator);
     } else {
@@ -81,8 +128,7 @@ void Scheduler::insertMediumJob(AbstractSimulator *simulator, MediumJob *job) {
 }
 
 void Scheduler::insertSmallJob(AbstractSimulator *simulator, SmallJob *job) {
-    if (!isDuringWeekend(simulator->now()) && smallJobs->empty() &&
-        !isDuringWeekend(simulator->now() + HPCParameters::smallMaximumTime)) {
+    if (smallJobs->empty() && endsBeforeWeekend(job, simulator->now())) {
         smallJobs->push_back(job);
         tryToExecuteNextSmallJob(simulator);
     } else {
@@ -91,8 +137,7 @@ void Scheduler::insertSmallJob(AbstractSimulator *simulator, SmallJob *job) {
 }
 
 void Scheduler::insertGpuJob(AbstractSimulator *simulator, GpuJob *job) {
-    if (!isDuringWeekend(simulator->now()) && gpuJobs->empty() &&
-        !isDuringWeekend(simulator->now() + HPCParameters::gpuMaximumTime)) {
+    if (gpuJobs->empty() && endsBeforeWeekend(job, simulator->now())) {
         gpuJobs->push_back(job);
         tryToExecuteNextGpuJob(simulator);
     } else {
@@ -102,8 +147,7 @@ void Scheduler::insertGpuJob(AbstractSimulator *simulator, GpuJob *job) {
 
 
 void Scheduler::insertLargeJob(class AbstractSimulator *simulator, class LargeJob *job) {
-    if (!isDuringWeekend(simulator->now()) && largeJobs->empty() &&
-        !isDuringWeekend(simulator->now() + HPCParameters::largeMaximumTime)) {
+    if (largeJobs->empty() && endsBeforeWeekend(job, simulator->now())) {
         largeJobs->push_back(job);
         tryToExecuteNextLargeJob(simulator);
     } else {
@@ -115,65 +159,25 @@ void Scheduler::insertHugeJob(AbstractSimulator *simulator, HugeJob *job) {
     hugeJobs->push_back(job);
 }
 
-//TODO TEST THAT
-AbstractJob *Scheduler::nextNonGpuJob() {
-    std::vector<AbstractJob *> nextJobs;
-
-    MediumJob *nextMediumJob;
-    if (!mediumJobs->empty()) {
-        nextJobs.push_back(mediumJobs->front());
-    }
-    if (!largeJobs->empty()) {
-        nextJobs.push_back(largeJobs->front());
-    }
-
-    if (!smallJobs->empty()) {
-        nextJobs.push_back(smallJobs->front());
-    }
-
-    if (nextJobs.empty()) {
-        return nullptr;
-    }
-    // TO-DO :especially this
-    auto nextJobIt = max_element(std::begin(nextJobs), std::end(nextJobs), comparingJobsPointersSubmittingTime);
-    return *nextJobIt;
-}
-
-//TODO TEST ALSO THAT
-AbstractJob *Scheduler::nextJob() {
-    AbstractJob *nextNotGpuJob = nextNonGpuJob();
-    if (!gpuJobs->empty()) {
-        AbstractJob *nextGpuJob = gpuJobs->front();
-        if (nextNotGpuJob == nullptr) {
-            return nextGpuJob;
-        } else {
-            return max(nextGpuJob, nextNotGpuJob, comparingJobsPointersSubmittingTime);
-        }
-    }
-    return nextNonGpuJob();
-}
-
 /*
- * According to priorities
+ * According to priorities, among the jobs ending before the week-end
  */
 void Scheduler::tryToExecuteNextNonGpuJobShortEnough(AbstractSimulator *simulator) {
-    AbstractJob *job;
-    if (!isDuringWeekend(simulator->now()) && !isDuringWeekend(simulator->now() + HPCParameters::largeMaximumTime)) {
-        job = nextNonGpuJob();
-        if (job != nullptr) {
-            job->tryToExecute(simulator, this);
-            return;
-        }
-    } else if (!isDuringWeekend(simulator->now()) &&
-               !isDuringWeekend(simulator->now() + HPCParameters::mediumMaximumTime)) {
-        if (mediumJobs->empty() || (!smallJobs->empty() && *(mediumJobs->front()) < *(smallJobs->front()))) {
-            tryToExecuteNextSmallJob(simulator);
-            return;
-        }
-        tryToExecuteNextMediumJob(simulator);
+    AbstractJob *job = nextNonGpuJob();
+    if (job == nullptr) {
+        return;
+    }
+    if (endsBeforeWeekend(job, simulator->now())) {
+        job->tryToExecute(simulator, this);
         return;
-    } else if (!isDuringWeekend(simulator->now()) && !isDuringWeekend(simulator->now() + HPCParameters::smallMaximumTime)) {
+    }
+    // the next job would run during the week-end, the next medium or small job may still end before
+    bool mediumJobEndsBefore = !mediumJobs->empty() && endsBeforeWeekend(mediumJobs->front(), simulator->now());
+    bool smallJobEndsBefore = !smallJobs->empty() && endsBeforeWeekend(smallJobs->front(), simulator->now());
+    if (smallJobEndsBefore && (!mediumJobEndsBefore || *(mediumJobs->front()) < *(smallJobs->front()))) {
         tryToExecuteNextSmallJob(simulator);
+    } else if (mediumJobEndsBefore) {
+        tryToExecuteNextMediumJob(simulator);
     }
 }
 
@@ -187,27 +191,39 @@ void Scheduler::tryToExecuteNextLargeJob(AbstractSimulator *simulator) {
     LargeJob *nextLargeJob;
     if (!largeJobs->empty()) {
         nextLargeJob = largeJobs->front();
+        if (!endsBeforeWeekend(nextLargeJob, simulator->now())) {
+            return;
+        }
         if (nextLargeJob == nextJob() &&
-            (freeNodes.size() + freeGpuNodes.size()) >= nextLargeJob->getNumberOfNodes()) {
-            for (int i = 0; i < nextLargeJob->getNumberOfNodes(); ++i) {
-                Node *node;
-                if (!freeNodes.empty()) {
-                    node = freeNodes.front();
-                    freeNodes.pop();
-                } else {
-                    node = freeGpuNodes.front();
-                    freeGpuNodes.pop();
-                }
-                node->insert(simulator, nextLargeJob);
-            }
+            freeNodePool.available({NormalNodeClass, GpuNodeClass}) >= nextLargeJob->getNumberOfNodes() &&
+            fitsBeforeReservations(simulator, nextLargeJob, {NormalNodeClass, GpuNodeClass},
+                                   nextLargeJob->getNumberOfNodes())) {
+            std::vector<Node *> nodes;
+            freeNodePool.take({NormalNodeClass, GpuNodeClass}, nextLargeJob->getNumberOfNodes(), nodes);
             largeJobs->pop_front();
-        } else if (nextLargeJob == nextNonGpuJob() && freeNodes.size() >= nextLargeJob->getNumberOfNodes()) {
-            for (int i = 0; i < nextLargeJob->getNumberOfNodes(); ++i) {
-                Node *node = freeNodes.front();
-                freeNodes.pop();
-                node->insert(simulator, nextLargeJob);
-            }
+            startJob(simulator, nextLargeJob, nodes);
+        } else if (nextLargeJob == nextNonGpuJob() &&
+                   freeNodePool.available(NormalNodeClass) >= nextLargeJob->getNumberOfNodes() &&
+                   fitsBeforeReservations(simulator, nextLargeJob, {NormalNodeClass},
+                                          nextLargeJob->getNumberOfNodes())) {
+            std::vector<Node *> nodes;
+            freeNodePool.take(NormalNodeClass, nextLargeJob->getNumberOfNodes(), nodes);
             largeJobs->pop_front();
+            startJob(simulator, nextLargeJob, nodes);
+        } else if (nextLargeJob->isMoldable() && nextLargeJob == nextNonGpuJob()) {
+            // a moldable job starts on the nodes free if it does not complete sooner by waiting for more
+            const std::vector<NodeClass> &nodeClasses = nodeClassesFor(nextLargeJob, nextLargeJob == nextJob());
+            int numberOfNodes = moldedNumberOfNodes(simulator, nextLargeJob, nodeClasses,
+                                                    freeNodePool.available(nodeClasses),
+                                                    preemption ? std::numeric_limits<double>::infinity()
+                                                               : hoursUntilNextWeekend(simulator->now()));
+            if (numberOfNodes > 0 && fitsBeforeReservations(simulator, nextLargeJob, nodeClasses, numberOfNodes)) {
+                std::vector<Node *> nodes;
+                freeNodePool.take(nodeClasses, numberOfNodes, nodes);
+                largeJobs->pop_front();
+                nextLargeJob->mold(numberOfNodes);
+                startJob(simulator, nextLargeJob, nodes);
+            }
         }
     }
 }
@@ -217,49 +233,37 @@ void Scheduler::tryToExecuteNextMediumJob(AbstractSimulator *simulator) {
     AbstractJob *nextMediumJob;
     if (!mediumJobs->empty()) {
         nextMediumJob = mediumJobs->front();
+        if (!endsBeforeWeekend(nextMediumJob, simulator->now())) {
+            return;
+        }
         if (nextMediumJob == nextJob() &&
-            (freeMediumNodes.size() + freeNodes.size() + freeGpuNodes.size()) >=
-            nextMediumJob->getNumberOfNodes()) {
-            for (int i = 0; i < nextMediumJob->getNumberOfNodes(); ++i) {
-                Node *node;
-                if (!freeMediumNodes.empty()) {
-                    node = freeMediumNodes.front();
-                    freeMediumNodes.pop();
-
-                } else if (!freeNodes.empty()) {
-                    node = freeNodes.front();
-                    freeNodes.pop();
-                } else {
-                    node = freeGpuNodes.front();
-                    freeGpuNodes.pop();
-                }
-                node->insert(simulator, nextMediumJob);
-            }
+            freeNodePool.available({MediumNodeClass, NormalNodeClass, GpuNodeClass}) >=
+            nextMediumJob->getNumberOfNodes() &&
+            fitsBeforeReservations(simulator, nextMediumJob, {MediumNodeClass, NormalNodeClass, GpuNodeClass},
+                                   nextMediumJob->getNumberOfNodes())) {
+            std::vector<Node *> nodes;
+            freeNodePool.take({MediumNodeClass, NormalNodeClass, GpuNodeClass},
+                              nextMediumJob->getNumberOfNodes(), nodes);
             mediumJobs->pop_front();
+            startJob(simulator, nextMediumJob, nodes);
             return;
-        } else if ((freeMediumNodes.size() + freeNodes.size()) >= nextMediumJob->getNumberOfNodes() &&
-                   nextMediumJob == nextNonGpuJob()) {
-            for (int i = 0; i < nextMediumJob->getNumberOfNodes(); ++i) {
-                Node *node;
-                if (!freeMediumNodes.empty()) {
-                    node = freeMediumNodes.front();
-                    freeMediumNodes.pop();
-
-                } else {
-                    node = freeNodes.front();
-                    freeNodes.pop();
-                }
-                node->insert(simulator, nextMediumJob);
-            }
+        } else if (freeNodePool.available({MediumNodeClass, NormalNodeClass}) >=
+                   nextMediumJob->getNumberOfNodes() &&
+                   nextMediumJob == nextNonGpuJob() &&
+                   fitsBeforeReservations(simulator, nextMediumJob, {MediumNodeClass, NormalNodeClass},
+                                          nextMediumJob->getNumberOfNodes())) {
+            std::vector<Node *> nodes;
+            freeNodePool.take({MediumNodeClass, NormalNodeClass}, nextMediumJob->getNumberOfNodes(), nodes);
             mediumJobs->pop_front();
+            startJob(simulator, nextMediumJob, nodes);
             return;
-        } else if (freeMediumNodes.size() >= nextMediumJob->getNumberOfNodes()) {
-            for (int i = 0; i < nextMediumJob->getNumberOfNodes(); ++i) {
-                Node *node = freeMediumNodes.front();
-                freeMediumNodes.pop();
-                node->insert(simulator, nextMediumJob);
-            }
+        } else if (freeNodePool.available(MediumNodeClass) >= nextMediumJob->getNumberOfNodes() &&
+                   fitsBeforeReservations(simulator, nextMediumJob, {MediumNodeClass},
+                                          nextMediumJob->getNumberOfNodes())) {
+            std::vector<Node *> nodes;
+            freeNodePool.take(MediumNodeClass, nextMediumJob->getNumberOfNodes(), nodes);
             mediumJobs->pop_front();
+            startJob(simulator, nextMediumJob, nodes);
             return;
         }
     }
@@ -270,13 +274,15 @@ void Scheduler::tryToExecuteNextGpuJob(AbstractSimulator *simulator) {
     AbstractJob *nextGPUJob;
     if (!gpuJobs->empty()) {
         nextGPUJob = gpuJobs->front();
-        if (nextGPUJob == nextJob() && freeGpuNodes.size() >= nextGPUJob->getNumberOfNodes()) {
-            for (int i = 0; i < nextGPUJob->getNumberOfNodes(); ++i) {
-                Node *node = freeGpuNodes.front();
-                freeGpuNodes.pop();
-                node->insert(simulator, nextGPUJob);
-            }
+        if (!endsBeforeWeekend(nextGPUJob, simulator->now())) {
+            return;
+        }
+        if (nextGPUJob == nextJob() && freeNodePool.available(GpuNodeClass) >= nextGPUJob->getNumberOfNodes() &&
+            fitsBeforeReservations(simulator, nextGPUJob, {GpuNodeClass}, nextGPUJob->getNumberOfNodes())) {
+            std::vector<Node *> nodes;
+            freeNodePool.take(GpuNodeClass, nextGPUJob->getNumberOfNodes(), nodes);
             gpuJobs->pop_front();
+            startJob(simulator, nextGPUJob, nodes);
         }
     }
 }
@@ -287,51 +293,45 @@ void Scheduler::tryToExecuteNextSmallJob(AbstractSimulator *simulator) {
     AbstractJob *nextSmallJob;
     if (!smallJobs->empty()) {
         nextSmallJob = smallJobs->front();
+        if (!endsBeforeWeekend(nextSmallJob, simulator->now())) {
+            return;
+        }
+        //the free cores of a node shared by small jobs go first, whatever the priority of the job
+        Node *sharedNode = nextSmallJob->isSharingNodes() ? takeSharedNode(simulator, nextSmallJob) : nullptr;
+        if (sharedNode != nullptr) {
+            smallJobs->pop_front();
+            startJob(simulator, nextSmallJob, {sharedNode});
+            return;
+        }
         //if small job is the overall next job, it can use ressources from freeSmallNode, freeGpuNode, freeNode
         if (nextSmallJob == nextJob() &&
-            (freeSmallNodes.size() + freeNodes.size() + freeGpuNodes.size()) >=
-            nextSmallJob->getNumberOfNodes()) {
-            for (int i = 0; i < nextSmallJob->getNumberOfNodes(); ++i) {
-                Node *node;
-                if (!freeSmallNodes.empty()) {
-                    node = freeSmallNodes.front();
-                    freeSmallNodes.pop();
-
-                } else if (!freeNodes.empty()) {
-                    node = freeNodes.front();
-                    freeNodes.pop();
-                } else {//Gpu nodes are taken as last ressources as they are the more valuable
-                    node = freeGpuNodes.front();
-                    freeGpuNodes.pop();
-                }
-                node->insert(simulator, nextSmallJob);
-            }
+            freeNodePool.available({SmallNodeClass, NormalNodeClass, GpuNodeClass}) >=
+            nextSmallJob->getNumberOfNodes() &&
+            fitsBeforeReservations(simulator, nextSmallJob, {SmallNodeClass, NormalNodeClass, GpuNodeClass},
+                                   nextSmallJob->getNumberOfNodes())) {
+            std::vector<Node *> nodes;
+            freeNodePool.take({SmallNodeClass, NormalNodeClass, GpuNodeClass}, nextSmallJob->getNumberOfNodes(), nodes);
             smallJobs->pop_front();
+            startJob(simulator, nextSmallJob, nodes);
             return;
-            //if it is the next nonGpu node it can use the resources from freeSmallNodes and freeNodes
-        } else if ((freeSmallNodes.size() + freeNodes.size()) >= nextSmallJob->getNumberOfNodes() &&
-                   nextSmallJob == nextNonGpuJob()) {
-            for (int i = 0; i < nextSmallJob->getNumberOfNodes(); ++i) {
-                Node *node;
-                if (!freeSmallNodes.empty()) {
-                    node = freeSmallNodes.front();
-                    freeSmallNodes.pop();
-                } else {
-                    node = freeNodes.front();
-                    freeNodes.pop();
-                }
-                node->insert(simulator, nextSmallJob);
-            }
+            //if it is the next nonGpu node it can use the resources from free small nodes and free normal nodes
+        } else if (freeNodePool.available({SmallNodeClass, NormalNodeClass}) >= nextSmallJob->getNumberOfNodes() &&
+                   nextSmallJob == nextNonGpuJob() &&
+                   fitsBeforeReservations(simulator, nextSmallJob, {SmallNodeClass, NormalNodeClass},
+                                          nextSmallJob->getNumberOfNodes())) {
+            std::vector<Node *> nodes;
+            freeNodePool.take({SmallNodeClass, NormalNodeClass}, nextSmallJob->getNumberOfNodes(), nodes);
             smallJobs->pop_front();
+            startJob(simulator, nextSmallJob, nodes);
             return;
-            //if it is not the next non-gpu job, it can only be run on freeSmallNodes resources
-        } else if (freeSmallNodes.size() >= nextSmallJob->getNumberOfNodes()) {
-            for (int i = 0; i < nextSmallJob->getNumberOfNodes(); ++i) {
-                Node *node = freeSmallNodes.front();
-                freeSmallNodes.pop();
-                node->insert(simulator, nextSmallJob);
-            }
+            //if it is not the next non-gpu job, it can only be run on free small nodes resources
+        } else if (freeNodePool.available(SmallNodeClass) >= nextSmallJob->getNumberOfNodes() &&
+                   fitsBeforeReservations(simulator, nextSmallJob, {SmallNodeClass},
+                                          nextSmallJob->getNumberOfNodes())) {
+            std::vector<Node *> nodes;
+            freeNodePool.take(SmallNodeClass, nextSmallJob->getNumberOfNodes(), nodes);
             smallJobs->pop_front();
+            startJob(simulator, nextSmallJob, nodes);
             return;
         }
     }
@@ -339,42 +339,18 @@ void Scheduler::tryToExecuteNextSmallJob(AbstractSimulator *simulator) {
 }
 
 
+void Scheduler::releaseNodes(AbstractSimulator *simulator, const std::vector<Node *> &nodes) {
+    AbstractScheduler::releaseNodes(simulator, nodes);
+    fillBeforeWeekend(simulator);
+}
+
 /* Try to launch as many huge jobs as possible */
 void Scheduler::tryToExecuteNextHugeJobs(AbstractSimulator *simulator) {
-    int previousHugeQueueSize;
-    do {
-        previousHugeQueueSize = hugeJobs->size();
-        if (!hugeJobs->empty()) {
-            AbstractJob *nextHugeJob = hugeJobs->front();
-            int totalNumberOfNodesAvailable =
-                    freeNodes.size() + freeMediumNodes.size() + freeSmallNodes.size() + freeGpuNodes.size();
-            if (nextHugeJob != nullptr && nextHugeJob->getNumberOfNodes() < totalNumberOfNodesAvailable) {
-                for (int i = 0; i < nextHugeJob->getNumberOfNodes(); ++i) {
-                    Node *node;
-                    if (!freeSmallNodes.empty()) {
-                        node = freeSmallNodes.front();
-                        freeSmallNodes.pop();
-                    } else if (!freeMediumNodes.empty()) {
-                        node = freeMediumNodes.front();
-                        freeMediumNodes.pop();
-                    } else if (!freeNodes.empty()) {
-                        node = freeNodes.front();
-                        freeNodes.pop();
-                    } else {
-                        node = freeGpuNodes.front();
-                        freeGpuNodes.pop();
-                    }
-                    node->insert(simulator, nextHugeJob);
-                }
-                hugeJobs->pop_front();
-            }
-        }
-    } while (previousHugeQueueSize > hugeJobs->size());
+    startHugeJobs(simulator);
 }
 
 /*
- * Do not check for the week-end
- * Normally ran only at the begining of the week
+ * Normally ran only at the begining of the week, when every job ends before the week-end
 */
 void Scheduler::tryToExecuteNextJobs(AbstractSimulator *simulator) {
     int previousNumberOfJobWaiting;
@@ -392,6 +368,694 @@ void Scheduler::tryToExecuteNextJobs(AbstractSimulator *simulator) {
     } while (previousNumberOfJobWaiting > totalOfNonHugeJobsWaiting());
 }
 
+void AbstractScheduler::startJob(AbstractSimulator *simulator, AbstractJob *job,
+                                 const std::vector<Node *> &allocatedNodes) {
+    std::vector<Node *> replacedNodes;
+    bool avoidingReservations = reservationCalendar != nullptr;
+    if (avoidingReservations) {
+        replacedNodes = allocatedNodes;
+        avoidReservations(simulator, job, replacedNodes);
+    }
+    const std::vector<Node *> &nodes = avoidingReservations ? replacedNodes : allocatedNodes;
+    for (auto &node : nodes) {
+        node->assign(job);
+    }
+    job->setStartTime(simulator->now());
+    double plannedCompletionTime = simulator->now() + job->getRemainingDuration();
+    if (communicationPenalty > 0 && nodes.size() > 1) {
+        std::vector<int> racks;
+        for (auto &node : nodes) {
+            racks.push_back(node->getId() / nodesPerRack);
+        }
+        std::sort(racks.begin(), racks.end());
+        long numberOfRacks = std::unique(racks.begin(), racks.end()) - racks.begin();
+        job->slowDown(1 + communicationPenalty * (numberOfRacks - 1));
+    }
+    if (job->isSharingNodes()) {
+        for (auto &node : nodes) {
+            if (node->getFreeCores() > 0) {
+                sharedNodes.emplace(node->getFreeCores(), node);
+            }
+        }
+    }
+    HPC_TRACE_RECORD(simulator, job->traceRecord(RecordJobStart, simulator->now()));
+    delete job->getCompletion();
+    auto *completion = new JobCompletion(this, job, nodes, simulator->now());
+    job->setCompletion(completion);
+    runningJobs.emplace(completion->getTime(), job);
+    simulator->insert(completion);
+    if (completion->getTime() != plannedCompletionTime) {
+        completionMoved(simulator, job, plannedCompletionTime);
+    }
+    if (ioContention != nullptr && job->getIoIntensity() > 0) {
+        std::vector<std::pair<AbstractJob *, double>> completions;
+        ioContention->start(job, simulator->now(), completions);
+        rescheduleCompletions(simulator, completions);
+    }
+}
+
+int AbstractScheduler::availableUntilReserved(NodeClass nodeClass, double from, double to) const {
+    int numberOfNodes = freeNodePool.available(nodeClass);
+    std::vector<const Reservation *> reservations = reservationCalendar->overlapping(from, to);
+    if (reservations.empty() || numberOfNodes == 0) {
+        return numberOfNodes;
+    }
+    // the ranges of the reservations may overlap, each reserved node is counted once
+    std::sort(reservations.begin(), reservations.end(), [](const Reservation *a, const Reservation *b) {
+        return a->firstNode < b->firstNode;
+    });
+    int firstNode = reservations[0]->firstNode;
+    int lastNode = reservations[0]->lastNode;
+    for (const Reservation *reservation : reservations) {
+        if (reservation->firstNode > lastNode + 1) {
+            numberOfNodes -= freeNodePool.availableInRange(nodeClass, firstNode, lastNode + 1);
+            firstNode = reservation->firstNode;
+        }
+        lastNode = std::max(lastNode, reservation->lastNode);
+    }
+    return numberOfNodes - freeNodePool.availableInRange(nodeClass, firstNode, lastNode + 1);
+}
+
+bool AbstractScheduler::fitsBeforeReservationsIn(AbstractSimulator *simulator, AbstractJob *job,
+                                                 const NodeClass *first, const NodeClass *last,
+                                                 int numberOfNodes) const {
+    double now = simulator->now();
+    double end = now + (numberOfNodes == job->getNumberOfNodes() ? job->getWalltime()
+                                                                 : job->getWalltimeOn(numberOfNodes));
+    // the nodes are taken class by class, the reserved ones are then replaced in their class
+    for (; first != last && numberOfNodes > 0; ++first) {
+        int numberTaken = std::min(numberOfNodes, freeNodePool.available(*first));
+        if (availableUntilReserved(*first, now, end) < numberTaken) {
+            return false;
+        }
+        numberOfNodes -= numberTaken;
+    }
+    return true;
+}
+
+void AbstractScheduler::avoidReservations(AbstractSimulator *simulator, AbstractJob *job, std::vector<Node *> &nodes) {
+    double now = simulator->now();
+    double end = now + job->getWalltime();
+    // the free nodes reserved too are put aside until every node has been looked at
+    std::vector<Node *> nodesGivenBack;
+    for (auto &node : nodes) {
+        if (!node->isAvailable() || reservationCalendar->isFree(node->getId(), now, end)) {
+            continue;
+        }
+        NodeClass nodeClass = node->getNodeClass();
+        while (freeNodePool.available(nodeClass) > 0) {
+            std::vector<Node *> candidate;
+            freeNodePool.take(nodeClass, 1, candidate);
+            if (reservationCalendar->isFree(candidate[0]->getId(), now, end)) {
+                nodesGivenBack.push_back(node);
+                node = candidate[0];
+                break;
+            }
+            nodesGivenBack.push_back(candidate[0]);
+        }
+    }
+    for (Node *node : nodesGivenBack) {
+        freeNodePool.release(node->getNodeClass(), node);
+    }
+}
+
+void AbstractScheduler::holdReservedNodes(AbstractSimulator *simulator, std::vector<Node *> &freeNodes) {
+    size_t numberOfFreeNodes = 0;
+    for (Node *node : freeNodes) {
+        if (reservationCalendar->isReservedAt(node->getId(), simulator->now())) {
+            reservedNodes.push_back(node);
+        } else {
+            freeNodes[numberOfFreeNodes++] = node;
+        }
+    }
+    freeNodes.resize(numberOfFreeNodes);
+}
+
+void AbstractScheduler::beginReservation(AbstractSimulator *simulator, const Reservation &reservation) {
+    /* The jobs only start when they end before the reservations of their nodes, those still running ran longer
+     * than their walltime, slowed down. The jobs completing now give their nodes back by themselves.
+     */
+    std::vector<AbstractJob *> preempted;
+    for (auto &running : runningJobs) {
+        if (!preemption || running.first <= simulator->now()) {
+            continue;
+        }
+        for (Node *node : running.second->getCompletion()->getNodes()) {
+            if (reservation.contains(node->getId())) {
+                preempted.push_back(running.second);
+                break;
+            }
+        }
+    }
+    for (AbstractJob *job : preempted) {
+        preempt(simulator, job);
+    }
+    freeNodePool.takeRange(reservation.firstNode, reservation.lastNode + 1, reservedNodes);
+    reservationsChanged(simulator);
+}
+
+void AbstractScheduler::endReservation(AbstractSimulator *simulator, const Reservation &) {
+    size_t numberOfNodesKept = 0;
+    for (Node *node : reservedNodes) {
+        if (reservationCalendar->isReservedAt(node->getId(), simulator->now())) {
+            reservedNodes[numberOfNodesKept++] = node;
+        } else {
+            freeNodePool.release(node->getNodeClass(), node);
+        }
+    }
+    reservedNodes.resize(numberOfNodesKept);
+    reservationsChanged(simulator);
+}
+
+double AbstractScheduler::stopIo(AbstractSimulator *simulator, AbstractJob *job) {
+    double timeRan = simulator->now() - job->getStartTime();
+    if (ioContention == nullptr || job->getIoIntensity() <= 0) {
+        return timeRan;
+    }
+    std::vector<std::pair<AbstractJob *, double>> completions;
+    double workDone = ioContention->stop(job, simulator->now(), completions);
+    job->extendExecution(timeRan - workDone);
+    rescheduleCompletions(simulator, completions);
+    return workDone;
+}
+
+void AbstractScheduler::rescheduleCompletions(AbstractSimulator *simulator,
+                                              const std::vector<std::pair<AbstractJob *, double>> &completions) {
+    std::map<Comparable *, double> newTimes;
+    std::vector<Comparable *> events;
+    std::vector<double> previousTimes;
+    for (auto &completion : completions) {
+        AbstractJob *job = completion.first;
+        auto range = runningJobs.equal_range(job->getCompletion()->getTime());
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == job) {
+                runningJobs.erase(it);
+                break;
+            }
+        }
+        runningJobs.emplace(completion.second, job);
+        previousTimes.push_back(job->getCompletion()->getTime());
+        newTimes[job->getCompletion()] = completion.second;
+        events.push_back(job->getCompletion());
+    }
+    simulator->update(events, [&newTimes](Comparable *event) {
+        static_cast<JobCompletion *>(event)->setTime(newTimes[event]);
+    });
+    for (size_t i = 0; i < completions.size(); ++i) {
+        if (completions[i].second != previousTimes[i]) {
+            completionMoved(simulator, completions[i].first, previousTimes[i]);
+        }
+    }
+}
+
+void AbstractScheduler::completeJob(AbstractSimulator *simulator, AbstractJob *job, const std::vector<Node *> &nodes) {
+    auto range = runningJobs.equal_range(job->getCompletion()->getTime());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == job) {
+            runningJobs.erase(it);
+            break;
+        }
+    }
+    std::vector<Node *> freeNodes;
+    releaseCores(job, nodes, freeNodes);
+    if (reservationCalendar != nullptr) {
+        holdReservedNodes(simulator, freeNodes);
+    }
+    releaseNodes(simulator, freeNodes);
+    if (freeNodes.size() < nodes.size()) {
+        size_t previousNumberOfJobsRunning;
+        do {
+            previousNumberOfJobsRunning = runningJobs.size();
+            tryToExecuteNextSmallJob(simulator);
+        } while (runningJobs.size() > previousNumberOfJobsRunning);
+    }
+    if (partitionController != nullptr) {
+        resizePartitions(simulator);
+    }
+    // the nodes left free by the scheduler during the week-end go to the planner
+    if (weekendPlanner != nullptr && isDuringWeekend(simulator->now())) {
+        packWeekend(simulator, false);
+    }
+}
+
+void AbstractScheduler::releaseCores(AbstractJob *job, const std::vector<Node *> &nodes,
+                                     std::vector<Node *> &freeNodes) {
+    for (Node *node : nodes) {
+        if (job->isSharingNodes()) {
+            // the node is kept by its number of free cores before the release
+            auto range = sharedNodes.equal_range(node->getFreeCores());
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == node) {
+                    sharedNodes.erase(it);
+                    break;
+                }
+            }
+        }
+        node->release(job);
+        if (node->isAvailable()) {
+            freeNodes.push_back(node);
+        } else {
+            sharedNodes.emplace(node->getFreeCores(), node);
+        }
+    }
+}
+
+Node *AbstractScheduler::takeSharedNode(AbstractSimulator *simulator, AbstractJob *job) {
+    auto bestFit = sharedNodes.lower_bound(job->getNumberOfCores());
+    if (reservationCalendar != nullptr) {
+        double now = simulator->now();
+        while (bestFit != sharedNodes.end() &&
+               !reservationCalendar->isFree(bestFit->second->getId(), now, now + job->getWalltime())) {
+            ++bestFit;
+        }
+    }
+    if (bestFit == sharedNodes.end()) {
+        return nullptr;
+    }
+    Node *node = bestFit->second;
+    sharedNodes.erase(bestFit);
+    return node;
+}
+
+void AbstractScheduler::releaseNodes(AbstractSimulator *simulator, const std::vector<Node *> &nodes) {
+    // the nodes are given back last allocated first, the order in which their own events used to run
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+        if (molding) {
+            nodesStillReleased.assign(it + 1, nodes.rend());
+        }
+        (*it)->addFreeNodeToScheduler(simulator);
+    }
+    nodesStillReleased.clear();
+}
+
+void AbstractScheduler::startHugeJobs(AbstractSimulator *simulator) {
+    if (preemption) {
+        preemptForHugeJobs(simulator);
+    }
+    if (weekendPlanner != nullptr) {
+        packWeekend(simulator, true);
+        return;
+    }
+    size_t previousHugeQueueSize;
+    do {
+        previousHugeQueueSize = hugeJobs->size();
+        if (!hugeJobs->empty()) {
+            AbstractJob *nextHugeJob = hugeJobs->front();
+            int totalNumberOfNodesAvailable =
+                    freeNodePool.available({NormalNodeClass, MediumNodeClass, SmallNodeClass, GpuNodeClass});
+            if (nextHugeJob != nullptr && nextHugeJob->getNumberOfNodes() <= totalNumberOfNodesAvailable) {
+                if (!fitsBeforeReservations(simulator, nextHugeJob,
+                                            {SmallNodeClass, MediumNodeClass, NormalNodeClass, GpuNodeClass},
+                                            nextHugeJob->getNumberOfNodes())) {
+                    return;
+                }
+                std::vector<Node *> nodes;
+                freeNodePool.take({SmallNodeClass, MediumNodeClass, NormalNodeClass, GpuNodeClass},
+                                  nextHugeJob->getNumberOfNodes(), nodes);
+                hugeJobs->pop_front();
+                startJob(simulator, nextHugeJob, nodes);
+            } else if (nextHugeJob != nullptr && nextHugeJob->isMoldable()) {
+                // a moldable huge job started on fewer nodes must still end before monday morning
+                int numberOfNodes = moldedNumberOfNodes(
+                        simulator, nextHugeJob, nodeClassesFor(nextHugeJob, true), totalNumberOfNodesAvailable,
+                        hoursUntilMonday(simulator->now()));
+                if (numberOfNodes > 0 &&
+                    fitsBeforeReservations(simulator, nextHugeJob,
+                                           {SmallNodeClass, MediumNodeClass, NormalNodeClass, GpuNodeClass},
+                                           numberOfNodes)) {
+                    std::vector<Node *> nodes;
+                    freeNodePool.take({SmallNodeClass, MediumNodeClass, NormalNodeClass, GpuNodeClass},
+                                      numberOfNodes, nodes);
+                    hugeJobs->pop_front();
+                    nextHugeJob->mold(numberOfNodes);
+                    startJob(simulator, nextHugeJob, nodes);
+                }
+            }
+        }
+    } while (previousHugeQueueSize > hugeJobs->size());
+}
+
+int AbstractScheduler::moldedNumberOfNodes(AbstractSimulator *simulator, AbstractJob *job,
+                                           const std::vector<NodeClass> &nodeClasses, int numberOfNodesFree,
+                                           double hoursLeft) const {
+    // the job completes sooner on more nodes, the free nodes are all taken
+    int numberOfNodes = std::min(numberOfNodesFree, job->getNumberOfNodes());
+    if (numberOfNodes < job->getMinNumberOfNodes() || job->getWalltimeOn(numberOfNodes) > hoursLeft) {
+        return 0;
+    }
+    // the job is tried again when the nodes of a completed job still being given back are free
+    int numberOfNodesAtTime = numberOfNodesFree;
+    for (Node *node : nodesStillReleased) {
+        if (std::find(nodeClasses.begin(), nodeClasses.end(), node->getNodeClass()) != nodeClasses.end()) {
+            numberOfNodesAtTime++;
+        }
+    }
+    if (std::min(numberOfNodesAtTime, job->getNumberOfNodes()) > numberOfNodes) {
+        return 0;
+    }
+    double completionTime = simulator->now() + job->getWalltimeOn(numberOfNodes);
+    for (auto &running : runningJobs) {
+        if (running.first >= completionTime) {
+            break;
+        }
+        for (Node *node : running.second->getCompletion()->getNodes()) {
+            if (std::find(nodeClasses.begin(), nodeClasses.end(), node->getNodeClass()) != nodeClasses.end()) {
+                numberOfNodesAtTime++;
+            }
+        }
+        int numberOfNodesLater = std::min(numberOfNodesAtTime, job->getNumberOfNodes());
+        if (numberOfNodesLater > numberOfNodes && running.first + job->getWalltimeOn(numberOfNodesLater) <
+                                                  completionTime) {
+            return 0;
+        }
+        if (numberOfNodesLater == job->getNumberOfNodes()) {
+            break;
+        }
+    }
+    return numberOfNodes;
+}
+
+int AbstractScheduler::preemptForHugeJobs(AbstractSimulator *simulator) {
+    const std::initializer_list<NodeClass> allNodeClasses = {SmallNodeClass, MediumNodeClass, NormalNodeClass,
+                                                             GpuNodeClass};
+    int freeNodes = freeNodePool.available(allNodeClasses);
+    // the jobs left on each node used by a job which is not huge, a node shared by several jobs is counted once
+    std::map<Node *, int> jobsOnNodes;
+    for (auto &running : runningJobs) {
+        if (running.second->getTypeIndex() != AbstractJob::HugeJobTypeIndex) {
+            for (Node *node : running.second->getCompletion()->getNodes()) {
+                jobsOnNodes[node]++;
+            }
+        }
+    }
+    int nodesAvailable = freeNodes + jobsOnNodes.size();
+    int nodesNeeded = nodesForHugeJobs(simulator, nodesAvailable);
+    std::vector<AbstractJob *> candidates;
+    for (auto it = runningJobs.rbegin(); it != runningJobs.rend() && freeNodes < nodesNeeded; ++it) {
+        if (it->second->getTypeIndex() != AbstractJob::HugeJobTypeIndex && it->first > simulator->now()) {
+            candidates.push_back(it->second);
+            // a node is free once every job on it is checkpointed
+            for (Node *node : it->second->getCompletion()->getNodes()) {
+                if (--jobsOnNodes[node] == 0) {
+                    ++freeNodes;
+                }
+            }
+        }
+    }
+    // a job whose nodes all keep other jobs would be checkpointed for nothing
+    std::vector<AbstractJob *> preempted;
+    for (AbstractJob *job : candidates) {
+        for (Node *node : job->getCompletion()->getNodes()) {
+            if (jobsOnNodes[node] == 0) {
+                preempted.push_back(job);
+                break;
+            }
+        }
+    }
+    for (AbstractJob *job : preempted) {
+        preempt(simulator, job);
+    }
+    return preempted.size();
+}
+
+int AbstractScheduler::nodesForHugeJobs(AbstractSimulator *simulator, int numberOfNodes) {
+    int nodesNeeded = 0;
+    if (weekendPlanner == nullptr) {
+        // same rule as startHugeJobs
+        for (auto it = hugeJobs->begin();
+             it != hugeJobs->end() && (*it)->getNumberOfNodes() <= numberOfNodes - nodesNeeded; ++it) {
+            nodesNeeded += (*it)->getNumberOfNodes();
+        }
+        return nodesNeeded;
+    }
+    // the selection of packWeekend, the other jobs selected take nodes which were free or checkpointed anyway
+    for (AbstractJob *job : selectForWeekend(simulator, numberOfNodes)) {
+        if (job->getTypeIndex() == AbstractJob::HugeJobTypeIndex) {
+            nodesNeeded += job->getNumberOfNodes();
+        }
+    }
+    return nodesNeeded;
+}
+
+std::vector<AbstractJob *> AbstractScheduler::selectForWeekend(AbstractSimulator *simulator, int numberOfNodes) {
+    return weekendPlanner->select(std::vector<AbstractJob *>(hugeJobs->begin(), hugeJobs->end()),
+                                  waitingJobsByPriority(), numberOfNodes, hoursUntilMonday(simulator->now()),
+                                  [this, simulator](AbstractJob *job) { return fitsAtWeekend(simulator, job); });
+}
+
+bool AbstractScheduler::fitsAtWeekend(AbstractSimulator *simulator, AbstractJob *job) const {
+    const std::vector<NodeClass> &nodeClasses = nodeClassesFor(job, true);
+    // a huge job may use every free node, the planner counts them
+    if (job->getTypeIndex() != AbstractJob::HugeJobTypeIndex &&
+        job->getNumberOfNodes() > freeNodePool.available(nodeClasses)) {
+        return false;
+    }
+    return fitsBeforeReservations(simulator, job, nodeClasses, job->getNumberOfNodes());
+}
+
+void AbstractScheduler::preempt(AbstractSimulator *simulator, AbstractJob *job) {
+    JobCompletion *completion = job->getCompletion();
+    simulator->remove(completion);
+    auto range = runningJobs.equal_range(completion->getTime());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == job) {
+            runningJobs.erase(it);
+            break;
+        }
+    }
+    HPC_TRACE(simulator, TraceEvents, "Checkpointed " << job->getId() << " (" << job->getType() << ") at time "
+                                                      << convertTime(simulator->now()) << "\n");
+    job->checkpoint(stopIo(simulator, job), checkpointOverhead);
+    std::vector<Node *> freeNodes;
+    releaseCores(job, completion->getNodes(), freeNodes);
+    if (reservationCalendar != nullptr) {
+        holdReservedNodes(simulator, freeNodes);
+    }
+    for (Node *node : freeNodes) {
+        freeNodePool.release(node->getNodeClass(), node);
+    }
+    requeueJob(simulator, job);
+}
+
+void AbstractScheduler::requeueJob(AbstractSimulator *, AbstractJob *job) {
+    addWaitingJob(job);
+}
+
+int AbstractScheduler::packWeekend(AbstractSimulator *simulator, bool weekendBegins) {
+    const std::initializer_list<NodeClass> allNodeClasses = {SmallNodeClass, MediumNodeClass, NormalNodeClass,
+                                                             GpuNodeClass};
+    int numberOfJobsStarted = 0;
+    for (AbstractJob *job : selectForWeekend(simulator, freeNodePool.available(allNodeClasses))) {
+        bool isHugeJob = job->getTypeIndex() == AbstractJob::HugeJobTypeIndex;
+        // the selection counts all the free nodes, the jobs started before it may have taken the nodes of a job
+        if ((isHugeJob && job->getNumberOfNodes() > freeNodePool.available(allNodeClasses)) ||
+            !fitsAtWeekend(simulator, job)) {
+            if (isHugeJob && weekendPlanner->mustStart(job)) {
+                // nothing else starts until the nodes it needs are free
+                return numberOfJobsStarted;
+            }
+            continue;
+        }
+        std::vector<Node *> nodes;
+        freeNodePool.take(nodeClassesFor(job, true), job->getNumberOfNodes(), nodes);
+        if (isHugeJob) {
+            weekendPlanner->started(job);
+        }
+        removeWaitingJob(job);
+        startJob(simulator, job, nodes);
+        ++numberOfJobsStarted;
+    }
+
+    if (weekendBegins) {
+        for (auto it = hugeJobs->begin(); it != hugeJobs->end(); ++it) {
+            weekendPlanner->skipped(*it);
+        }
+    }
+    return numberOfJobsStarted;
+}
+
+int AbstractScheduler::resizePartitions(AbstractSimulator *simulator) {
+    double now = simulator->now();
+    if (!partitionController->startResizing(now)) {
+        return 0;
+    }
+    double largeJobWait = largeJobs->empty() ? 0 : now - largeJobs->front()->getSubmittingTime();
+    double smallJobWait = smallJobs->empty() ? 0 : now - smallJobs->front()->getSubmittingTime();
+    double mediumJobWait = mediumJobs->empty() ? 0 : now - mediumJobs->front()->getSubmittingTime();
+    std::vector<Node *> nodesMoved;
+    for (NodeClass partition : {SmallNodeClass, MediumNodeClass}) {
+        int numberOfNodes = partitionController->transfer(partition, freeNodePool.size(partition),
+                                                          freeNodePool.available(partition),
+                                                          freeNodePool.available(NormalNodeClass),
+                                                          partition == SmallNodeClass ? smallJobWait : mediumJobWait,
+                                                          (int) (partition == SmallNodeClass ? smallJobs->size()
+                                                                                             : mediumJobs->size()),
+                                                          largeJobWait, (int) largeJobs->size());
+        if (numberOfNodes > 0) {
+            freeNodePool.reassign(NormalNodeClass, partition, numberOfNodes, nodesMoved);
+        } else if (numberOfNodes < 0) {
+            freeNodePool.reassign(partition, NormalNodeClass, -numberOfNodes, nodesMoved);
+        }
+    }
+    if (!nodesMoved.empty()) {
+        HPC_TRACE(simulator, TraceEvents, "Partitions resized to " << freeNodePool.size(SmallNodeClass)
+                                                                   << " small and " << freeNodePool.size(MediumNodeClass)
+                                                                   << " medium nodes at time " << convertTime(now)
+                                                                   << "\n");
+        partitionsResized(simulator, nodesMoved);
+    }
+    return nodesMoved.size();
+}
+
+int AbstractScheduler::fillBeforeWeekend(AbstractSimulator *simulator) {
+    double now = simulator->now();
+    double hoursLeft = hoursUntilNextWeekend(now) + roundingError;
+    if (hoursLeft <= roundingError) {
+        return 0;
+    }
+    int numberOfJobsStarted = 0;
+    // the jobs are started one by one until no job fits in the nodes left
+    for (;;) {
+        bool fillNonGpuNodes = nextNonGpuJob() != nullptr && !endsBeforeWeekend(nextNonGpuJob(), now);
+        bool fillGpuNodes = !gpuJobs->empty() && !endsBeforeWeekend(gpuJobs->front(), now);
+        /* the longest job of each queue ending in time on the nodes it may use as a job which is not the next one,
+         * in the order of nextJob
+         */
+        AbstractJob *candidates[4] = {nullptr, nullptr, nullptr, nullptr};
+        if (fillGpuNodes) {
+            candidates[0] = gpuJobs->longestFitting(hoursLeft, freeNodePool.available(GpuNodeClass));
+        }
+        if (fillNonGpuNodes) {
+            candidates[1] = mediumJobs->longestFitting(hoursLeft, freeNodePool.available({MediumNodeClass,
+                                                                                          NormalNodeClass}));
+            candidates[2] = largeJobs->longestFitting(hoursLeft, freeNodePool.available(NormalNodeClass));
+            candidates[3] = smallJobs->longestFitting(hoursLeft, freeNodePool.available({SmallNodeClass,
+                                                                                         NormalNodeClass}));
+        }
+        AbstractJob *bestJob = nullptr;
+        for (AbstractJob *job : candidates) {
+            if (job != nullptr && (bestJob == nullptr || job->getNumberOfNodes() * job->getWalltime() >
+                                                         bestJob->getNumberOfNodes() * bestJob->getWalltime())) {
+                bestJob = job;
+            }
+        }
+        // the nodes left free are reserved before the longest job ends, shorter ones are tried when nodes are freed
+        if (bestJob == nullptr || !fitsBeforeReservations(simulator, bestJob, nodeClassesFor(bestJob, false),
+                                                          bestJob->getNumberOfNodes())) {
+            return numberOfJobsStarted;
+        }
+        std::vector<Node *> nodes;
+        freeNodePool.take(nodeClassesFor(bestJob, false), bestJob->getNumberOfNodes(), nodes);
+        removeWaitingJob(bestJob);
+        startJob(simulator, bestJob, nodes);
+        ++numberOfJobsStarted;
+    }
+}
+
+const std::vector<NodeClass> &AbstractScheduler::nodeClassesFor(AbstractJob *job, bool isNextJob) {
+    // same rules as the FIFO scheduler, indexed by type of job : small, medium, large, huge, gpu
+    static const std::vector<NodeClass> nextJobClasses[5] = {
+            {SmallNodeClass,  NormalNodeClass, GpuNodeClass},
+            {MediumNodeClass, NormalNodeClass, GpuNodeClass},
+            {NormalNodeClass, GpuNodeClass},
+            {SmallNodeClass,  MediumNodeClass, NormalNodeClass, GpuNodeClass},
+            {GpuNodeClass}};
+    static const std::vector<NodeClass> otherJobClasses[5] = {
+            {SmallNodeClass,  NormalNodeClass},
+            {MediumNodeClass, NormalNodeClass},
+            {NormalNodeClass},
+            {SmallNodeClass,  MediumNodeClass, NormalNodeClass, GpuNodeClass},
+            {GpuNodeClass}};
+    return isNextJob ? nextJobClasses[job->getTypeIndex()] : otherJobClasses[job->getTypeIndex()];
+}
+
+bool AbstractScheduler::endsBeforeWeekend(AbstractJob *job, double time) const {
+    return !isDuringWeekend(time) &&
+           (preemption || job->getWalltime() <= hoursUntilNextWeekend(time) + roundingError);
+}
+
+void AbstractScheduler::addWaitingJob(AbstractJob *job) {
+    switch (job->getTypeIndex()) {
+        case 0:
+            smallJobs->push_back(static_cast<SmallJob *>(job));
+            break;
+        case 1:
+            mediumJobs->push_back(static_cast<MediumJob *>(job));
+            break;
+        case 2:
+            largeJobs->push_back(static_cast<LargeJob *>(job));
+            break;
+        case 3:
+            hugeJobs->push_back(static_cast<HugeJob *>(job));
+            break;
+        default:
+            gpuJobs->push_back(static_cast<GpuJob *>(job));
+    }
+}
+
+void AbstractScheduler::setWaitingJobPriority(AbstractJob *job, double priority) {
+    switch (job->getTypeIndex()) {
+        case 0:
+            smallJobs->setPriority(static_cast<SmallJob *>(job), priority);
+            break;
+        case 1:
+            mediumJobs->setPriority(static_cast<MediumJob *>(job), priority);
+            break;
+        case 2:
+            largeJobs->setPriority(static_cast<LargeJob *>(job), priority);
+            break;
+        case 3:
+            hugeJobs->setPriority(static_cast<HugeJob *>(job), priority);
+            break;
+        default:
+            gpuJobs->setPriority(static_cast<GpuJob *>(job), priority);
+    }
+}
+
+void AbstractScheduler::removeWaitingJob(AbstractJob *job) {
+    switch (job->getTypeIndex()) {
+        case 0:
+            smallJobs->remove(static_cast<SmallJob *>(job));
+            break;
+        case 1:
+            mediumJobs->remove(static_cast<MediumJob *>(job));
+            break;
+        case 2:
+            largeJobs->remove(static_cast<LargeJob *>(job));
+            break;
+        case 3:
+            hugeJobs->remove(static_cast<HugeJob *>(job));
+            break;
+        default:
+            gpuJobs->remove(static_cast<GpuJob *>(job));
+    }
+}
+
+std::vector<AbstractJob *> AbstractScheduler::waitingJobsByPriority(bool withGpuJobs) {
+    auto higherPriorityFirst = [](AbstractJob *a, AbstractJob *b) { return a->priority() > b->priority(); };
+    std::vector<AbstractJob *> jobs;
+    std::vector<AbstractJob *> merged;
+    jobs.reserve(totalOfNonHugeJobsWaiting());
+    merged.reserve(totalOfNonHugeJobsWaiting());
+    if (withGpuJobs) {
+        jobs.insert(jobs.end(), gpuJobs->begin(), gpuJobs->end());
+    }
+    /* the queues are sorted already : they are merged one after the other, the jobs merged first going first
+     * on equal priorities
+     */
+    std::merge(jobs.begin(), jobs.end(), mediumJobs->begin(), mediumJobs->end(), std::back_inserter(merged),
+               higherPriorityFirst);
+    jobs.swap(merged);
+    merged.clear();
+    std::merge(jobs.begin(), jobs.end(), largeJobs->begin(), largeJobs->end(), std::back_inserter(merged),
+               higherPriorityFirst);
+    jobs.swap(merged);
+    merged.clear();
+    std::merge(jobs.begin(), jobs.end(), smallJobs->begin(), smallJobs->end(), std::back_inserter(merged),
+               higherPriorityFirst);
+    return merged;
+}
+
 int AbstractScheduler::totalOfNonHugeJobsWaiting() {
     return smallJobs->size() + mediumJobs->size() + largeJobs->size() + gpuJobs->size();
 }
@@ -1,11 +1,29 @@
 #include "../include/AbstractSimulator.h"
 
-AbstractSimulator::AbstractSimulator()  {}
+AbstractSimulator::AbstractSimulator() : events(nullptr) {}
 
 void AbstractSimulator::insert(AbstractEvent* e) {
 	events->insert(e);
 }
 
+bool AbstractSimulator::remove(AbstractEvent* e) {
+	return events->remove(e) != nullptr;
+}
+
+void AbstractSimulator::update(const std::vector<Comparable*>& e, const std::function<void(Comparable*)>& change) {
+	events->update(e, change);
+}
+
+void OrderedSet::update(const std::vector<Comparable*>& xs, const std::function<void(Comparable*)>& change) {
+	for (auto& x : xs) {
+		remove(x);
+	}
+	for (auto& x : xs) {
+		change(x);
+		insert(x);
+	}
+}
+
 AbstractSimulator::~AbstractSimulator() {
 	delete events;
 }
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "../include/AvailabilityProfile.h"
+
+std::map<double, NodeCounts>::iterator AvailabilityProfile::split(double time) {
+    auto next = steps.upper_bound(time);
+    if (next != steps.begin() && std::prev(next)->first == time) {
+        return std::prev(next);
+    }
+    NodeCounts nodes{};
+    if (next != steps.begin()) {
+        nodes = std::prev(next)->second;
+    }
+    return steps.emplace_hint(next, time, nodes);
+}
+
+void AvailabilityProfile::merge(std::map<double, NodeCounts>::iterator step) {
+    if (step != steps.begin() && std::prev(step)->second == step->second) {
+        steps.erase(step);
+    }
+}
+
+void AvailabilityProfile::add(double from, double until, NodeClass nodeClass, int numberOfNodes) {
+    if (from >= until) {
+        return;
+    }
+    auto first = split(from);
+    auto last = std::isinf(until) ? steps.end() : split(until);
+    for (auto step = first; step != last; ++step) {
+        step->second[nodeClass] += numberOfNodes;
+    }
+    if (last != steps.end()) {
+        merge(last);
+    }
+    merge(first);
+}
+
+void AvailabilityProfile::reserve(double from, double until, const NodeCounts &nodes) {
+    if (from >= until) {
+        return;
+    }
+    auto first = split(from);
+    auto last = split(until);
+    for (auto step = first; step != last; ++step) {
+        for (int nodeClass = 0; nodeClass < NumberOfNodeClasses; ++nodeClass) {
+            step->second[nodeClass] -= nodes[nodeClass];
+        }
+    }
+    merge(last);
+    merge(first);
+}
+
+void AvailabilityProfile::advanceTo(double time) {
+    auto current = steps.upper_bound(time);
+    if (current == steps.begin()) {
+        return;
+    }
+    --current;
+    if (current->first < time) {
+        NodeCounts nodes = current->second;
+        steps.erase(steps.begin(), std::next(current));
+        steps.emplace_hint(steps.begin(), time, nodes);
+    } else {
+        steps.erase(steps.begin(), current);
+    }
+}
+
+double AvailabilityProfile::earliestFit(double from, double duration, int numberOfNodes,
+                                        const std::vector<NodeClass> &nodeClasses, NodeCounts &nodes) const {
+    double start = from;
+    while (true) {
+        auto first = steps.upper_bound(start);
+        if (first == steps.begin()) {
+            // nothing is free before the first step
+            if (first == steps.end()) {
+                return std::numeric_limits<double>::infinity();
+            }
+            start = first->first;
+            continue;
+        }
+        --first;
+
+        /* The nodes free during the whole window are the minimum over its steps. A step with not enough
+         * free nodes in total blocks every window containing it, the next window starts after it.
+         */
+        NodeCounts minimum = first->second;
+        auto blocking = steps.end();
+        for (auto step = first; step != steps.end() && (step == first || step->first < start + duration); ++step) {
+            int total = 0;
+            for (NodeClass nodeClass : nodeClasses) {
+                total += step->second[nodeClass];
+                minimum[nodeClass] = std::min(minimum[nodeClass], step->second[nodeClass]);
+            }
+            if (total < numberOfNodes) {
+                blocking = step;
+                break;
+            }
+        }
+        if (blocking == steps.end()) {
+            nodes.fill(0);
+            int numberOfNodesLeft = numberOfNodes;
+            for (NodeClass nodeClass : nodeClasses) {
+                nodes[nodeClass] = std::max(0, std::min(numberOfNodesLeft, minimum[nodeClass]));
+                numberOfNodesLeft -= nodes[nodeClass];
+            }
+            if (numberOfNodesLeft == 0) {
+                return start;
+            }
+            blocking = first;
+        }
+        auto next = std::next(blocking);
+        if (next == steps.end()) {
+            return std::numeric_limits<double>::infinity();
+        }
+        start = next->first;
+    }
+}
+
+int AvailabilityProfile::freeAt(double time, NodeClass nodeClass) const {
+    auto next = steps.upper_bound(time);
+    if (next == steps.begin()) {
+        return 0;
+    }
+    return std::prev(next)->second[nodeClass];
+}
@@ -0,0 +1,51 @@
+#include <cstring>
+#include "../include/BinaryTrace.h"
+
+static const char traceMagic[8] = {'H', 'P', 'C', 'T', 'R', 'A', 'C', 'E'};
+
+const uint32_t BinaryTraceWriter::version;
+const size_t BinaryTraceWriter::bufferedRecords;
+
+const char *recordKindName(int32_t kind) {
+    static const char *names[] = {"submit", "start", "finish", "node_free", "weekend_begin", "weekend_end"};
+    if (kind < 0 || kind >= (int32_t) (sizeof(names) / sizeof(*names))) {
+        return "unknown";
+    }
+    return names[kind];
+}
+
+BinaryTraceWriter::BinaryTraceWriter(const std::string &filename) : file(filename, std::ios::binary),
+                                                                     buffer(bufferedRecords) {
+    if (file.is_open()) {
+        BinaryTraceHeader header{};
+        std::memcpy(header.magic, traceMagic, sizeof(traceMagic));
+        header.version = version;
+        header.recordSize = sizeof(BinaryTraceRecord);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+}
+
+BinaryTraceWriter::~BinaryTraceWriter() {
+    flush();
+}
+
+void BinaryTraceWriter::flush() {
+    if (numberOfBufferedRecords > 0 && file.is_open()) {
+        file.write(reinterpret_cast<const char *>(buffer.data()),
+                   numberOfBufferedRecords * sizeof(BinaryTraceRecord));
+    }
+    numberOfBufferedRecords = 0;
+    file.flush();
+}
+
+BinaryTraceReader::BinaryTraceReader(const std::string &filename) : file(filename, std::ios::binary) {
+    BinaryTraceHeader header{};
+    if (file.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+        valid = std::memcmp(header.magic, traceMagic, sizeof(traceMagic)) == 0 &&
+                header.version == BinaryTraceWriter::version && header.recordSize == sizeof(BinaryTraceRecord);
+    }
+}
+
+bool BinaryTraceReader::read(BinaryTraceRecord &record) {
+    return valid && file.read(reinterpret_cast<char *>(&record), sizeof(record));
+}
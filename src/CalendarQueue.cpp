@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cmath>
+#include "../include/CalendarQueue.h"
+
+const size_t CalendarQueue::minimumNumberOfBuckets;
+const size_t CalendarQueue::widthSampleSize;
+
+CalendarQueue::CalendarQueue() {
+    buckets.resize(minimumNumberOfBuckets);
+}
+
+bool CalendarQueue::before(const Entry &a, const Entry &b) {
+    if (a.time != b.time) {
+        return a.time < b.time;
+    }
+    // same as the ListQueue: the last inserted comes first
+    return a.insertionNumber > b.insertionNumber;
+}
+
+long CalendarQueue::dayOf(double time) const {
+    return static_cast<long>(std::floor(time / bucketWidth));
+}
+
+std::vector<CalendarQueue::Entry> &CalendarQueue::bucketOf(long day) {
+    long numberOfBuckets = buckets.size();
+    return buckets[((day % numberOfBuckets) + numberOfBuckets) % numberOfBuckets];
+}
+
+void CalendarQueue::insertEntry(const Entry &entry) {
+    std::vector<Entry> &bucket = bucketOf(dayOf(entry.time));
+    // the bucket is kept sorted from the last to the first entry to be removed
+    auto position = std::lower_bound(bucket.begin(), bucket.end(), entry,
+                                     [](const Entry &inBucket, const Entry &inserted) {
+                                         return before(inserted, inBucket);
+                                     });
+    bucket.insert(position, entry);
+}
+
+void CalendarQueue::resize(size_t newNumberOfBuckets) {
+    std::vector<Entry> entries;
+    entries.reserve(numberOfEvents);
+    for (auto &bucket : buckets) {
+        entries.insert(entries.end(), bucket.begin(), bucket.end());
+    }
+
+    /* The width of a day is set to three times the average separation between the next
+     * events, ignoring the separations larger than twice the average (R. Brown, 1988).
+     * Identical timestamps give no information, the previous width is kept in that case.
+     */
+    size_t sampleSize = std::min(widthSampleSize, entries.size());
+    if (sampleSize > 0) {
+        std::partial_sort(entries.begin(), entries.begin() + sampleSize, entries.end(), before);
+    }
+    if (sampleSize > 1) {
+        double averageSeparation = (entries[sampleSize - 1].time - entries[0].time) / (sampleSize - 1);
+        double sumOfSeparations = 0;
+        int numberOfSeparations = 0;
+        for (size_t i = 1; i < sampleSize; ++i) {
+            double separation = entries[i].time - entries[i - 1].time;
+            if (separation <= 2 * averageSeparation) {
+                sumOfSeparations += separation;
+                numberOfSeparations++;
+            }
+        }
+        if (numberOfSeparations > 0 && sumOfSeparations > 0) {
+            bucketWidth = 3 * sumOfSeparations / numberOfSeparations;
+        } else if (averageSeparation > 0) {
+            bucketWidth = 3 * averageSeparation;
+        }
+    }
+
+    buckets.assign(newNumberOfBuckets, std::vector<Entry>());
+    if (!entries.empty()) {
+        currentDay = dayOf(entries[0].time);
+    }
+    for (auto &entry : entries) {
+        insertEntry(entry);
+    }
+}
+
+void CalendarQueue::insert(Comparable *x) {
+    Entry entry{x, static_cast<Event *>(x)->getTime(), insertionCounter++};
+    if (numberOfEvents == 0 || dayOf(entry.time) < currentDay) {
+        currentDay = dayOf(entry.time);
+    }
+    insertEntry(entry);
+    numberOfEvents++;
+    if (numberOfEvents > 2 * (int) buckets.size()) {
+        resize(2 * buckets.size());
+    }
+}
+
+Comparable *CalendarQueue::removeFirst() {
+    if (numberOfEvents == 0) return 0;
+    std::vector<Entry> *bucket = nullptr;
+    // visit the days of the current year until an event of the visited day is found
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        std::vector<Entry> &candidate = bucketOf(currentDay);
+        if (!candidate.empty() && dayOf(candidate.back().time) <= currentDay) {
+            bucket = &candidate;
+            break;
+        }
+        currentDay++;
+    }
+    // no event in the coming year, the next event is searched directly
+    if (bucket == nullptr) {
+        for (auto &candidate : buckets) {
+            if (!candidate.empty() && (bucket == nullptr || before(candidate.back(), bucket->back()))) {
+                bucket = &candidate;
+            }
+        }
+        currentDay = dayOf(bucket->back().time);
+    }
+    Comparable *x = bucket->back().element;
+    bucket->pop_back();
+    numberOfEvents--;
+    if (buckets.size() > minimumNumberOfBuckets && numberOfEvents < (int) buckets.size() / 2) {
+        resize(buckets.size() / 2);
+    }
+    return x;
+}
+
+Comparable *CalendarQueue::remove(Comparable *x) {
+    std::vector<Entry> &bucket = bucketOf(dayOf(static_cast<Event *>(x)->getTime()));
+    for (auto it = bucket.begin(); it != bucket.end(); ++it) {
+        if (it->element == x) {
+            bucket.erase(it);
+            numberOfEvents--;
+            return x;
+        }
+    }
+    return 0;
+}
+
+int CalendarQueue::size() {
+    return numberOfEvents;
+}
@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "../include/ConservativeBackfillScheduler.h"
+#include "../include/JobCompletion.h"
+
+void ConservativeBackfillScheduler::reserve(AbstractSimulator *simulator, AbstractJob *job) {
+    const std::vector<NodeClass> &nodeClasses = nodeClassesFor(job, true);
+    NodeCounts nodes{};
+    double start = profile.earliestFit(simulator->now(), job->getRemainingDuration(), job->getNumberOfNodes(),
+                                       nodeClasses, nodes);
+    // a job which would still run during the week-end waits until the next monday morning
+    while (!std::isinf(start) && !endsBeforeWeekend(job, start)) {
+        start = profile.earliestFit(start + hoursUntilMonday(start), job->getRemainingDuration(), job->getNumberOfNodes(), nodeClasses,
+                                    nodes);
+    }
+    if (std::isinf(start)) {
+        // more nodes than the platform has, the job waits forever as with the other schedulers
+        return;
+    }
+    profile.reserve(start, start + job->getRemainingDuration(), nodes);
+    reservationOf[job] = reservations.emplace(start, Reservation{job, nodes});
+}
+
+void ConservativeBackfillScheduler::replan(AbstractSimulator *simulator) {
+    double now = simulator->now();
+    profile.clear();
+    for (int nodeClass = 0; nodeClass < NumberOfNodeClasses; ++nodeClass) {
+        profile.add(now, std::numeric_limits<double>::infinity(), NodeClass(nodeClass),
+                    freeNodePool.available(NodeClass(nodeClass)));
+    }
+    for (auto &running : runningJobs) {
+        for (Node *node : running.second->getCompletion()->getNodes()) {
+            profile.add(running.first, std::numeric_limits<double>::infinity(), node->getNodeClass(), 1);
+        }
+    }
+    reservations.clear();
+    reservationOf.clear();
+    numberOfRebookings++;
+    reservationsOutdated = false;
+    for (AbstractJob *job : waitingJobsByPriority()) {
+        reserve(simulator, job);
+    }
+}
+
+void ConservativeBackfillScheduler::rebook(AbstractSimulator *simulator, double from, double until) {
+    double now = simulator->now();
+    std::vector<AbstractJob *> jobs;
+    for (auto it = reservations.begin(); it != reservations.end() && it->first <= until;) {
+        double end = it->first + it->second.job->getRemainingDuration();
+        if (end <= from) {
+            ++it;
+            continue;
+        }
+        // the steps before now are forgotten
+        for (int nodeClass = 0; nodeClass < NumberOfNodeClasses; ++nodeClass) {
+            profile.add(std::max(it->first, now), end, NodeClass(nodeClass), it->second.nodes[nodeClass]);
+        }
+        jobs.push_back(it->second.job);
+        reservationOf.erase(it->second.job);
+        it = reservations.erase(it);
+    }
+    if (!jobs.empty()) {
+        numberOfRebookings++;
+    }
+    for (AbstractJob *job : jobs) {
+        reserve(simulator, job);
+    }
+}
+
+void ConservativeBackfillScheduler::moveEnd(AbstractSimulator *simulator, const NodeCounts &nodes,
+                                            double previousEnd, double end) {
+    double now = simulator->now();
+    for (int nodeClass = 0; nodeClass < NumberOfNodeClasses; ++nodeClass) {
+        if (end > previousEnd) {
+            profile.add(std::max(previousEnd, now), end, NodeClass(nodeClass), -nodes[nodeClass]);
+        } else {
+            profile.add(std::max(end, now), previousEnd, NodeClass(nodeClass), nodes[nodeClass]);
+        }
+    }
+    // the reservations after an earlier end move ahead, as no event may start them at their time any more
+    rebook(simulator, std::max(std::min(previousEnd, end), now), std::max(previousEnd, end));
+}
+
+void ConservativeBackfillScheduler::completionMoved(AbstractSimulator *simulator, AbstractJob *job,
+                                                    double previousTime) {
+    NodeCounts nodes{};
+    for (Node *node : job->getCompletion()->getNodes()) {
+        nodes[node->getNodeClass()]++;
+    }
+    moveEnd(simulator, nodes, previousTime, job->getCompletion()->getTime());
+}
+
+void ConservativeBackfillScheduler::startJob(AbstractSimulator *simulator, AbstractJob *job,
+                                             const std::vector<Node *> &nodes) {
+    double now = simulator->now();
+    auto reservation = reservationOf.find(job);
+    if (reservation != reservationOf.end()) {
+        auto it = reservation->second;
+        for (int nodeClass = 0; nodeClass < NumberOfNodeClasses; ++nodeClass) {
+            profile.add(std::max(it->first, now), it->first + job->getRemainingDuration(), NodeClass(nodeClass),
+                        it->second.nodes[nodeClass]);
+        }
+        reservations.erase(it);
+        reservationOf.erase(reservation);
+        reservationsOutdated = true;
+    }
+    NodeCounts nodeCounts{};
+    for (Node *node : nodes) {
+        nodeCounts[node->getNodeClass()]++;
+    }
+    double end = now + job->getRemainingDuration();
+    profile.reserve(now, end, nodeCounts);
+    rebook(simulator, now, end);
+    AbstractScheduler::startJob(simulator, job, nodes);
+}
+
+void ConservativeBackfillScheduler::requeueJob(AbstractSimulator *simulator, AbstractJob *job) {
+    AbstractScheduler::requeueJob(simulator, job);
+    reserve(simulator, job);
+    reservationsOutdated = true;
+}
+
+void ConservativeBackfillScheduler::schedule(AbstractSimulator *simulator) {
+    double now = simulator->now();
+    profile.advanceTo(now);
+    /* Jobs ending at the same time release their nodes one after the other, a reservation starting now
+     * may have to wait for the last of them.
+     */
+    for (auto it = reservations.begin(); it != reservations.end() && it->first <= now;) {
+        const NodeCounts &nodes = it->second.nodes;
+        // the reservations are made for the duration left, as the profile
+        double end = now + it->second.job->getRemainingDuration();
+        bool nodesFree = true;
+        for (int nodeClass = 0; nodeClass < NumberOfNodeClasses; ++nodeClass) {
+            nodesFree = nodesFree && freeNodePool.available(NodeClass(nodeClass)) >= nodes[nodeClass];
+            // the job waits for the reservations of the calendar ending before its nodes
+            nodesFree = nodesFree && (reservationCalendar == nullptr ||
+                                      availableUntilReserved(NodeClass(nodeClass), now, end) >= nodes[nodeClass]);
+        }
+        if (!nodesFree) {
+            ++it;
+            continue;
+        }
+        AbstractJob *job = it->second.job;
+        double reservedEnd = it->first + job->getRemainingDuration();
+        std::vector<Node *> takenNodes;
+        for (int nodeClass = 0; nodeClass < NumberOfNodeClasses; ++nodeClass) {
+            freeNodePool.take(NodeClass(nodeClass), nodes[nodeClass], takenNodes);
+        }
+        NodeCounts reservedNodes = nodes;
+        unsigned long previousRebookings = numberOfRebookings;
+        auto next = reservations.erase(it);
+        reservationOf.erase(job);
+        removeWaitingJob(job);
+        // the nodes of the job are already taken from the profile by its reservation, up to its reserved end
+        if (reservedEnd != now + job->getRemainingDuration()) {
+            moveEnd(simulator, reservedNodes, reservedEnd, now + job->getRemainingDuration());
+        }
+        AbstractScheduler::startJob(simulator, job, takenNodes);
+        // the reservations after it may have been made again, earlier ones included
+        it = numberOfRebookings == previousRebookings ? next : reservations.begin();
+    }
+}
+
+void ConservativeBackfillScheduler::addFreeNodeOfClass(AbstractSimulator *simulator, NodeClass nodeClass,
+                                                       Node *node) {
+    freeNodePool.release(nodeClass, node);
+    profile.add(simulator->now(), std::numeric_limits<double>::infinity(), nodeClass, 1);
+    schedule(simulator);
+}
+
+void ConservativeBackfillScheduler::releaseNodes(AbstractSimulator *simulator, const std::vector<Node *> &nodes) {
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+        freeNodePool.release((*it)->getNodeClass(), *it);
+    }
+    schedule(simulator);
+}
+
+void ConservativeBackfillScheduler::partitionsResized(AbstractSimulator *simulator,
+                                                      const std::vector<Node *> &nodes) {
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+        freeNodePool.release((*it)->getNodeClass(), *it);
+    }
+    replan(simulator);
+    schedule(simulator);
+}
+
+void ConservativeBackfillScheduler::tryToExecuteNextLargeJob(AbstractSimulator *simulator) {
+    schedule(simulator);
+}
+
+void ConservativeBackfillScheduler::tryToExecuteNextMediumJob(AbstractSimulator *simulator) {
+    schedule(simulator);
+}
+
+void ConservativeBackfillScheduler::tryToExecuteNextSmallJob(AbstractSimulator *simulator) {
+    schedule(simulator);
+}
+
+void ConservativeBackfillScheduler::tryToExecuteNextHugeJobs(AbstractSimulator *simulator) {
+    startHugeJobs(simulator);
+}
+
+void ConservativeBackfillScheduler::tryToExecuteNextGpuJob(AbstractSimulator *simulator) {
+    schedule(simulator);
+}
+
+void ConservativeBackfillScheduler::tryToExecuteNextNonGpuJobShortEnough(AbstractSimulator *simulator) {
+    schedule(simulator);
+}
+
+void ConservativeBackfillScheduler::addFreeNode(AbstractSimulator *simulator, Node *node) {
+    addFreeNodeOfClass(simulator, NormalNodeClass, node);
+}
+
+void ConservativeBackfillScheduler::addFreeMediumNode(AbstractSimulator *simulator, Node *node) {
+    addFreeNodeOfClass(simulator, MediumNodeClass, node);
+}
+
+void ConservativeBackfillScheduler::addFreeSmallNode(AbstractSimulator *simulator, Node *node) {
+    addFreeNodeOfClass(simulator, SmallNodeClass, node);
+}
+
+void ConservativeBackfillScheduler::addFreeGpuNode(AbstractSimulator *simulator, GpuNode *node) {
+    addFreeNodeOfClass(simulator, GpuNodeClass, node);
+}
+
+void ConservativeBackfillScheduler::insertMediumJob(AbstractSimulator *simulator, MediumJob *job) {
+    mediumJobs->push_back(job);
+    reserve(simulator, job);
+    schedule(simulator);
+}
+
+void ConservativeBackfillScheduler::insertSmallJob(AbstractSimulator *simulator, SmallJob *job) {
+    smallJobs->push_back(job);
+    reserve(simulator, job);
+    schedule(simulator);
+}
+
+void ConservativeBackfillScheduler::insertLargeJob(AbstractSimulator *simulator, LargeJob *job) {
+    largeJobs->push_back(job);
+    reserve(simulator, job);
+    schedule(simulator);
+}
+
+void ConservativeBackfillScheduler::insertGpuJob(AbstractSimulator *simulator, GpuJob *job) {
+    gpuJobs->push_back(job);
+    reserve(simulator, job);
+    schedule(simulator);
+}
+
+void ConservativeBackfillScheduler::insertHugeJob(AbstractSimulator *, HugeJob *job) {
+    hugeJobs->push_back(job);
+}
+
+void ConservativeBackfillScheduler::tryToExecuteNextJobs(AbstractSimulator *pSimulator) {
+    // at the end of the week-end, the reservations use the nodes left by the jobs started or checkpointed during it
+    if (reservationsOutdated) {
+        replan(pSimulator);
+    }
+    schedule(pSimulator);
+}
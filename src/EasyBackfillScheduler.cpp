@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <limits>
+#include "../include/EasyBackfillScheduler.h"
+#include "../include/JobCompletion.h"
+
+int EasyBackfillScheduler::nodesTakenFrom(AbstractJob *job, const std::vector<NodeClass> &nodeClasses,
+                                          const std::vector<NodeClass> &reservedClasses) const {
+    int numberOfNodesLeft = job->getNumberOfNodes();
+    int numberOfReservedNodes = 0;
+    for (NodeClass nodeClass : nodeClasses) {
+        int numberTaken = std::min(numberOfNodesLeft, freeNodePool.available(nodeClass));
+        if (std::find(reservedClasses.begin(), reservedClasses.end(), nodeClass) != reservedClasses.end()) {
+            numberOfReservedNodes += numberTaken;
+        }
+        numberOfNodesLeft -= numberTaken;
+    }
+    return numberOfReservedNodes;
+}
+
+void EasyBackfillScheduler::startWaitingJob(AbstractSimulator *simulator, AbstractJob *job,
+                                            const std::vector<NodeClass> &nodeClasses) {
+    std::vector<Node *> nodes;
+    freeNodePool.take(nodeClasses, job->getNumberOfNodes(), nodes);
+    removeWaitingJob(job);
+    startJob(simulator, job, nodes);
+}
+
+void EasyBackfillScheduler::schedule(AbstractSimulator *simulator) {
+    double now = simulator->now();
+    if (isDuringWeekend(now)) {
+        return;
+    }
+
+    AbstractJob *next = nextJob();
+    while (next != nullptr && endsBeforeWeekend(next, now) &&
+           freeNodePool.available(nodeClassesFor(next, true)) >= next->getNumberOfNodes() &&
+           fitsBeforeReservations(simulator, next, nodeClassesFor(next, true), next->getNumberOfNodes())) {
+        startWaitingJob(simulator, next, nodeClassesFor(next, true));
+        next = nextJob();
+    }
+    if (next == nullptr) {
+        return;
+    }
+
+    /* The next job is reserved the nodes freed by the running jobs, by order of completion, until there
+     * are enough of them : this is the shadow time. The nodes in excess at the shadow time can be used
+     * by jobs running after it. If the next job cannot start before the week-end, nothing is reserved.
+     */
+    const std::vector<NodeClass> &reservedClasses = nodeClassesFor(next, true);
+    double shadowTime = std::numeric_limits<double>::infinity();
+    int extraNodes = std::numeric_limits<int>::max();
+    if (endsBeforeWeekend(next, now)) {
+        int numberOfNodesAtShadowTime = freeNodePool.available(reservedClasses);
+        extraNodes = 0;
+        for (auto &running : runningJobs) {
+            for (Node *node : running.second->getCompletion()->getNodes()) {
+                if (std::find(reservedClasses.begin(), reservedClasses.end(), node->getNodeClass()) !=
+                    reservedClasses.end()) {
+                    numberOfNodesAtShadowTime++;
+                }
+            }
+            if (numberOfNodesAtShadowTime >= next->getNumberOfNodes()) {
+                shadowTime = running.first;
+                extraNodes = numberOfNodesAtShadowTime - next->getNumberOfNodes();
+                break;
+            }
+        }
+    }
+
+    // the gpu jobs can only be backfilled on free gpu nodes, often none while many gpu jobs are waiting
+    for (AbstractJob *job : waitingJobsByPriority(freeNodePool.available(GpuNodeClass) > 0)) {
+        // no other job fits once every node is taken
+        if (freeNodePool.available({SmallNodeClass, MediumNodeClass, NormalNodeClass, GpuNodeClass}) == 0) {
+            break;
+        }
+        if (job == next || !endsBeforeWeekend(job, now)) {
+            continue;
+        }
+        const std::vector<NodeClass> &nodeClasses = nodeClassesFor(job, false);
+        if (freeNodePool.available(nodeClasses) < job->getNumberOfNodes() ||
+            !fitsBeforeReservations(simulator, job, nodeClasses, job->getNumberOfNodes())) {
+            continue;
+        }
+        if (now + job->getRemainingDuration() > shadowTime) {
+            int numberOfReservedNodes = nodesTakenFrom(job, nodeClasses, reservedClasses);
+            if (numberOfReservedNodes > extraNodes) {
+                continue;
+            }
+            extraNodes -= numberOfReservedNodes;
+        }
+        startWaitingJob(simulator, job, nodeClasses);
+    }
+}
+
+void EasyBackfillScheduler::releaseNodes(AbstractSimulator *simulator, const std::vector<Node *> &nodes) {
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+        freeNodePool.release((*it)->getNodeClass(), *it);
+    }
+    schedule(simulator);
+}
+
+void EasyBackfillScheduler::tryToExecuteNextLargeJob(AbstractSimulator *simulator) {
+    schedule(simulator);
+}
+
+void EasyBackfillScheduler::tryToExecuteNextMediumJob(AbstractSimulator *simulator) {
+    schedule(simulator);
+}
+
+void EasyBackfillScheduler::tryToExecuteNextSmallJob(AbstractSimulator *simulator) {
+    schedule(simulator);
+}
+
+void EasyBackfillScheduler::tryToExecuteNextHugeJobs(AbstractSimulator *simulator) {
+    startHugeJobs(simulator);
+}
+
+void EasyBackfillScheduler::tryToExecuteNextGpuJob(AbstractSimulator *simulator) {
+    schedule(simulator);
+}
+
+void EasyBackfillScheduler::tryToExecuteNextNonGpuJobShortEnough(AbstractSimulator *simulator) {
+    schedule(simulator);
+}
+
+void EasyBackfillScheduler::addFreeNode(AbstractSimulator *simulator, Node *node) {
+    freeNodePool.release(NormalNodeClass, node);
+    schedule(simulator);
+}
+
+void EasyBackfillScheduler::addFreeMediumNode(AbstractSimulator *simulator, Node *node) {
+    freeNodePool.release(MediumNodeClass, node);
+    schedule(simulator);
+}
+
+void EasyBackfillScheduler::addFreeSmallNode(AbstractSimulator *simulator, Node *node) {
+    freeNodePool.release(SmallNodeClass, node);
+    schedule(simulator);
+}
+
+void EasyBackfillScheduler::addFreeGpuNode(AbstractSimulator *simulator, GpuNode *node) {
+    freeNodePool.release(GpuNodeClass, node);
+    schedule(simulator);
+}
+
+void EasyBackfillScheduler::insertMediumJob(AbstractSimulator *simulator, MediumJob *job) {
+    mediumJobs->push_back(job);
+    schedule(simulator);
+}
+
+void EasyBackfillScheduler::insertSmallJob(AbstractSimulator *simulator, SmallJob *job) {
+    smallJobs->push_back(job);
+    schedule(simulator);
+}
+
+void EasyBackfillScheduler::insertLargeJob(AbstractSimulator *simulator, LargeJob *job) {
+    largeJobs->push_back(job);
+    schedule(simulator);
+}
+
+void EasyBackfillScheduler::insertGpuJob(AbstractSimulator *simulator, GpuJob *job) {
+    gpuJobs->push_back(job);
+    schedule(simulator);
+}
+
+void EasyBackfillScheduler::insertHugeJob(AbstractSimulator *, HugeJob *job) {
+    hugeJobs->push_back(job);
+}
+
+void EasyBackfillScheduler::tryToExecuteNextJobs(AbstractSimulator *pSimulator) {
+    schedule(pSimulator);
+}
@@ -0,0 +1,160 @@
+#include "../include/FairShareScheduler.h"
+#include "../include/User.h"
+
+FairShareScheduler::FairShareScheduler(const SchedulerParameters &parameters) :
+        usage(parameters.get("halfLife", 168), parameters.get("userWeight", 1),
+              parameters.get("accountWeight", 1)) {
+}
+
+double FairShareScheduler::priorityOf(AbstractJob *job, double) {
+    return -usage.key(job->getUser());
+}
+
+bool FairShareScheduler::submit(AbstractJob *job, double time) {
+    const User *user = job->getUser();
+    if (user == nullptr) {
+        return true;
+    }
+    UserJobs &jobs = jobsByUser[user];
+    if (user->getGroup() != nullptr) {
+        groupMembers[user->getGroup()].insert(user);
+    }
+    if (user->getCurriculum() != nullptr) {
+        curriculumMembers[user->getCurriculum()].insert(user);
+    }
+    int type = job->getTypeIndex();
+    if (type == AbstractJob::HugeJobTypeIndex) {
+        jobs.hugeJobs.insert(job);
+    } else if (jobs.queued[type] == nullptr) {
+        jobs.queued[type] = job;
+    } else {
+        jobs.held[type].push_back(job);
+        numberOfHeldJobs++;
+        return false;
+    }
+    job->setPriority(priorityOf(job, time));
+    return true;
+}
+
+void FairShareScheduler::updatePriorities(const User *user, double time) {
+    auto jobs = jobsByUser.find(user);
+    if (jobs == jobsByUser.end()) {
+        return;
+    }
+    for (AbstractJob *job : jobs->second.queued) {
+        if (job != nullptr) {
+            setWaitingJobPriority(job, priorityOf(job, time));
+        }
+    }
+    for (AbstractJob *job : jobs->second.hugeJobs) {
+        setWaitingJobPriority(job, priorityOf(job, time));
+    }
+}
+
+void FairShareScheduler::updateAllPriorities(double time) {
+    for (auto &jobsOfUser : jobsByUser) {
+        updatePriorities(jobsOfUser.first, time);
+    }
+}
+
+void FairShareScheduler::chargeUsage(const User *user, double nodeHours, double time) {
+    if (usage.charge(user, nodeHours, time)) {
+        updateAllPriorities(time);
+    } else if (user->getGroup() != nullptr) {
+        for (const User *member : groupMembers[user->getGroup()]) {
+            updatePriorities(member, time);
+        }
+    } else if (user->getCurriculum() != nullptr) {
+        for (const User *member : curriculumMembers[user->getCurriculum()]) {
+            updatePriorities(member, time);
+        }
+    } else {
+        updatePriorities(user, time);
+    }
+}
+
+void FairShareScheduler::startJob(AbstractSimulator *simulator, AbstractJob *job, const std::vector<Node *> &nodes) {
+    AbstractScheduler::startJob(simulator, job, nodes);
+    const User *user = job->getUser();
+    if (user == nullptr) {
+        return;
+    }
+    UserJobs &jobs = jobsByUser[user];
+    int type = job->getTypeIndex();
+    if (type == AbstractJob::HugeJobTypeIndex) {
+        jobs.hugeJobs.erase(job);
+    } else {
+        jobs.queued[type] = nullptr;
+    }
+
+    double now = simulator->now();
+    chargeUsage(user, job->getRemainingDuration() * job->getNodeShare(), now);
+
+    // the job was popped from its queue, the next job of the user takes its place
+    if (type != AbstractJob::HugeJobTypeIndex && !jobs.held[type].empty()) {
+        AbstractJob *next = jobs.held[type].front();
+        jobs.held[type].pop_front();
+        numberOfHeldJobs--;
+        jobs.queued[type] = next;
+        next->setPriority(priorityOf(next, now));
+        addWaitingJob(next);
+    }
+}
+
+void FairShareScheduler::requeueJob(AbstractSimulator *simulator, AbstractJob *job) {
+    const User *user = job->getUser();
+    if (user == nullptr) {
+        AbstractScheduler::requeueJob(simulator, job);
+        return;
+    }
+    double now = simulator->now();
+    UserJobs &jobs = jobsByUser[user];
+    int type = job->getTypeIndex();
+    if (type == AbstractJob::HugeJobTypeIndex) {
+        jobs.hugeJobs.insert(job);
+    } else {
+        if (jobs.queued[type] != nullptr) {
+            removeWaitingJob(jobs.queued[type]);
+            jobs.held[type].push_front(jobs.queued[type]);
+            numberOfHeldJobs++;
+        }
+        jobs.queued[type] = job;
+    }
+    job->setPriority(priorityOf(job, now));
+    AbstractScheduler::requeueJob(simulator, job);
+    chargeUsage(user, -(job->getRemainingDuration() - checkpointOverhead) * job->getNodeShare(), now);
+}
+
+int FairShareScheduler::totalOfNonHugeJobsWaiting() {
+    return Scheduler::totalOfNonHugeJobsWaiting() + numberOfHeldJobs;
+}
+
+void FairShareScheduler::insertMediumJob(AbstractSimulator *simulator, MediumJob *job) {
+    if (submit(job, simulator->now())) {
+        Scheduler::insertMediumJob(simulator, job);
+    }
+}
+
+void FairShareScheduler::insertSmallJob(AbstractSimulator *simulator, SmallJob *job) {
+    if (submit(job, simulator->now())) {
+        Scheduler::insertSmallJob(simulator, job);
+    }
+}
+
+void FairShareScheduler::insertLargeJob(AbstractSimulator *simulator, LargeJob *job) {
+    if (submit(job, simulator->now())) {
+        Scheduler::insertLargeJob(simulator, job);
+    }
+}
+
+void FairShareScheduler::insertGpuJob(AbstractSimulator *simulator, GpuJob *job) {
+    if (submit(job, simulator->now())) {
+        Scheduler::insertGpuJob(simulator, job);
+    }
+}
+
+void FairShareScheduler::insertHugeJob(AbstractSimulator *simulator, HugeJob *job) {
+    if (submit(job, simulator->now())) {
+        Scheduler::insertHugeJob(simulator, job);
+    }
+}
@@ -0,0 +1,58 @@
+#include <cmath>
+#include "../include/FairShareUsage.h"
+#include "../include/User.h"
+
+constexpr double FairShareUsage::maximumScale;
+
+FairShareUsage::FairShareUsage(double halfLife, double userWeight, double accountWeight) :
+        decayRate(halfLife > 0 && !std::isinf(halfLife) ? std::log(2.0) / halfLife : 0),
+        userWeight(userWeight), accountWeight(accountWeight) {
+}
+
+double FairShareUsage::scaleAt(double time) const {
+    return std::exp(decayRate * (time - referenceTime));
+}
+
+bool FairShareUsage::charge(const User *user, double nodeHours, double time) {
+    bool rescaled = false;
+    double scale = scaleAt(time);
+    if (scale > maximumScale) {
+        for (auto &usage : userUsage) {
+            usage.second /= scale;
+        }
+        for (auto &usage : groupUsage) {
+            usage.second /= scale;
+        }
+        for (auto &usage : curriculumUsage) {
+            usage.second /= scale;
+        }
+        referenceTime = time;
+        scale = 1;
+        rescaled = true;
+    }
+    userUsage[user] += nodeHours * scale;
+    if (user->getGroup() != nullptr) {
+        groupUsage[user->getGroup()] += nodeHours * scale;
+    }
+    if (user->getCurriculum() != nullptr) {
+        curriculumUsage[user->getCurriculum()] += nodeHours * scale;
+    }
+    return rescaled;
+}
+
+double FairShareUsage::key(const User *user) const {
+    double key = 0;
+    auto value = userUsage.find(user);
+    if (value != userUsage.end()) {
+        key += userWeight * value->second;
+    }
+    auto groupValue = groupUsage.find(user->getGroup());
+    if (user->getGroup() != nullptr && groupValue != groupUsage.end()) {
+        key += accountWeight * groupValue->second;
+    }
+    auto curriculumValue = curriculumUsage.find(user->getCurriculum());
+    if (user->getCurriculum() != nullptr && curriculumValue != curriculumUsage.end()) {
+        key += accountWeight * curriculumValue->second;
+    }
+    return key;
+}
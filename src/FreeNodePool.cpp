@@ -0,0 +1,149 @@
+#include <algorithm>
+#include "../include/FreeNodePool.h"
+#include "../include/Node.h"
+
+void FreeNodePool::release(NodeClass nodeClass, Node *node) {
+    size_t id = node->getId();
+    size_t word = id / 64;
+    if (id >= nodesById.size()) {
+        nodesById.resize(id + 1, nullptr);
+    }
+    if (nodesById[id] == nullptr) {
+        classSizes[nodeClass]++;
+    }
+    nodesById[id] = node;
+    std::vector<uint64_t> &words = freeNodes[nodeClass];
+    if (word >= words.size()) {
+        words.resize(word + 1, 0);
+    }
+    uint64_t bit = uint64_t(1) << (id % 64);
+    if ((words[word] & bit) == 0) {
+        words[word] |= bit;
+        numberOfFreeNodes[nodeClass]++;
+    }
+    firstWord[nodeClass] = std::min(firstWord[nodeClass], word);
+}
+
+void FreeNodePool::release(NodeClass nodeClass, const std::vector<Node *> &nodes) {
+    for (auto &node : nodes) {
+        release(nodeClass, node);
+    }
+}
+
+void FreeNodePool::take(NodeClass nodeClass, int numberOfNodes, std::vector<Node *> &nodes) {
+    if (nodesPerRack > 0) {
+        takeCompact(nodeClass, numberOfNodes, nodes);
+        return;
+    }
+    std::vector<uint64_t> &words = freeNodes[nodeClass];
+    size_t word = firstWord[nodeClass];
+    while (numberOfNodes > 0 && word < words.size()) {
+        uint64_t taken = words[word];
+        int numberTaken = __builtin_popcountll(taken);
+        if (numberTaken > numberOfNodes) {
+            // only the lowest bits are taken: clear them one by one from a copy and keep the difference
+            uint64_t notTaken = taken;
+            for (int i = 0; i < numberOfNodes; ++i) {
+                notTaken &= notTaken - 1;
+            }
+            taken ^= notTaken;
+            numberTaken = numberOfNodes;
+        }
+        words[word] &= ~taken;
+        numberOfFreeNodes[nodeClass] -= numberTaken;
+        numberOfNodes -= numberTaken;
+        while (taken != 0) {
+            nodes.push_back(nodesById[64 * word + __builtin_ctzll(taken)]);
+            taken &= taken - 1;
+        }
+        if (words[word] == 0) {
+            word++;
+        }
+    }
+    firstWord[nodeClass] = word;
+}
+
+void FreeNodePool::reassign(NodeClass from, NodeClass to, int numberOfNodes, std::vector<Node *> &nodes) {
+    size_t first = nodes.size();
+    take(from, numberOfNodes, nodes);
+    for (size_t i = first; i < nodes.size(); ++i) {
+        nodes[i]->setNodeClass(to);
+    }
+    // fewer nodes than asked may be free
+    int numberOfNodesMoved = nodes.size() - first;
+    classSizes[from] -= numberOfNodesMoved;
+    classSizes[to] += numberOfNodesMoved;
+}
+
+void FreeNodePool::takeRange(size_t first, size_t last, std::vector<Node *> &nodes) {
+    for (int nodeClass = 0; nodeClass < NumberOfNodeClasses; ++nodeClass) {
+        takeInRange(NodeClass(nodeClass), first, last, availableInRange(NodeClass(nodeClass), first, last), nodes);
+    }
+}
+
+int FreeNodePool::availableInRange(NodeClass nodeClass, size_t first, size_t last) const {
+    const std::vector<uint64_t> &words = freeNodes[nodeClass];
+    int total = 0;
+    for (size_t word = first / 64; word < words.size() && 64 * word < last; ++word) {
+        uint64_t bits = words[word];
+        if (64 * word < first) {
+            bits &= ~uint64_t(0) << (first % 64);
+        }
+        if (64 * (word + 1) > last) {
+            bits &= (uint64_t(1) << (last % 64)) - 1;
+        }
+        total += __builtin_popcountll(bits);
+    }
+    return total;
+}
+
+void FreeNodePool::takeInRange(NodeClass nodeClass, size_t first, size_t last, int numberOfNodes,
+                               std::vector<Node *> &nodes) {
+    std::vector<uint64_t> &words = freeNodes[nodeClass];
+    for (size_t word = first / 64; numberOfNodes > 0 && word < words.size() && 64 * word < last; ++word) {
+        uint64_t bits = words[word];
+        if (64 * word < first) {
+            bits &= ~uint64_t(0) << (first % 64);
+        }
+        if (64 * (word + 1) > last) {
+            bits &= (uint64_t(1) << (last % 64)) - 1;
+        }
+        while (bits != 0 && numberOfNodes > 0) {
+            uint64_t lowest = bits & (~bits + 1);
+            words[word] &= ~lowest;
+            bits &= ~lowest;
+            nodes.push_back(nodesById[64 * word + __builtin_ctzll(lowest)]);
+            numberOfFreeNodes[nodeClass]--;
+            numberOfNodes--;
+        }
+    }
+}
+
+void FreeNodePool::takeCompact(NodeClass nodeClass, int numberOfNodes, std::vector<Node *> &nodes) {
+    size_t numberOfRacks = (nodesById.size() + nodesPerRack - 1) / nodesPerRack;
+    if (numberOfRacks == 0) {
+        return;
+    }
+    std::vector<int> freeInRack(numberOfRacks);
+    for (size_t rack = 0; rack < numberOfRacks; ++rack) {
+        freeInRack[rack] = availableInRange(nodeClass, rack * nodesPerRack, (rack + 1) * nodesPerRack);
+    }
+    while (numberOfNodes > 0) {
+        size_t best = numberOfRacks;
+        for (size_t rack = 0; rack < numberOfRacks; ++rack) {
+            if (freeInRack[rack] >= numberOfNodes && (best == numberOfRacks || freeInRack[rack] < freeInRack[best])) {
+                best = rack;
+            }
+        }
+        if (best == numberOfRacks) {
+            best = std::max_element(freeInRack.begin(), freeInRack.end()) - freeInRack.begin();
+        }
+        int numberTaken = std::min(numberOfNodes, freeInRack[best]);
+        if (numberTaken == 0) {
+            return;
+        }
+        takeInRange(nodeClass, best * nodesPerRack, (best + 1) * nodesPerRack, numberTaken, nodes);
+        freeInRack[best] -= numberTaken;
+        numberOfNodes -= numberTaken;
+    }
+}
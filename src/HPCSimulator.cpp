@@ -1,23 +1,67 @@
 #include "../include/HPCSimulator.h"
 #include "../include/AbstractScheduler.h"
+#include "../include/SchedulerRegistry.h"
 #include "../include/User.h"
 #include "../include/Student.h"
 #include "../include/Researcher.h"
 #include "../include/weekendEvent.h"
+#include "../include/ReservationEvent.h"
 #include "../include/Group.h"
 #include "../include/ListQueue.h"
+#include "../include/HeapQueue.h"
+#include "../include/CalendarQueue.h"
 #include <cmath>
 #include <fstream>
+#include <sstream>
+
+OrderedSet *createEventQueue(const std::string &name) {
+    if (name == "list") {
+        return new ListQueue();
+    }
+    if (name == "heap") {
+        return new HeapQueue();
+    }
+    if (name == "calendar") {
+        return new CalendarQueue();
+    }
+    return nullptr;
+}
 
 void HPCSimulator::start() {
-    AbstractScheduler *scheduler = new Scheduler();
-    events = new ListQueue();
+    std::string error;
+    if (!SchedulerRegistry::check(schedulerName, schedulerParameters, error)) {
+        cout << error << "\n";
+        return;
+    }
+    AbstractScheduler *scheduler = SchedulerRegistry::create(schedulerName, schedulerParameters);
+    if (nodesPerRack > 0) {
+        scheduler->setTopology(nodesPerRack, communicationPenalty, compactPlacement);
+    }
+    if (filesystemBandwidth > 0) {
+        scheduler->setFilesystemBandwidth(filesystemBandwidth);
+    }
+    delete events;
+    events = createEventQueue(eventQueueName);
 
     auto *weekendBegin = new WeekendBegin(scheduler);
     auto *weekendEnd = new WeekendEnd(scheduler);
     insert(weekendBegin);
     insert(weekendEnd);
 
+    std::vector<Event *> reservationEvents;
+    if (!reservations.empty()) {
+        auto *calendar = new ReservationCalendar();
+        for (auto &reservation : reservations) {
+            calendar->add(reservation);
+            reservationEvents.push_back(new ReservationBegin(scheduler, reservation));
+            reservationEvents.push_back(new ReservationEnd(scheduler, reservation));
+        }
+        scheduler->setReservationCalendar(calendar);
+        for (auto &event : reservationEvents) {
+            insert(event);
+        }
+    }
+
     /* Create the generator, queue, and simulator */
     /* Connect them together. */
     int numberOfNodesAdded = 0;
@@ -38,39 +82,72 @@ void HPCSimulator::start() {
         nodes.push_back(new Node());
         numberOfNodesAdded++;
     }
+    int nodeId = 0;
     for (auto &node : nodes) {
-        scheduler->addFreeNode(this, node);
+        node->setId(nodeId++);
         node->addScheduler(scheduler);
+        node->addFreeNodeToScheduler(this);
     }
 
-    cout << numberOfNodesAdded << "nodes added to the scheduler \n";
+    HPC_TRACE(this, TraceInfo, numberOfNodesAdded << "nodes added to the scheduler \n");
 
 
-    for (User *user : users) {
-        user->addScheduler(scheduler);
-        insert(user);
+    for (int i = 0; i < users.size(); ++i) {
+        users[i]->seedRandomStreams(seed, i);
+        users[i]->addScheduler(scheduler);
+        users[i]->setWalltimeOverestimate(walltimeOverestimate);
+        insert(users[i]);
     }
-    cout << users.size() << " users inserted in the timeline \n";
+    HPC_TRACE(this, TraceInfo, users.size() << " users inserted in the timeline \n");
     doAllEvents();
+    tracer.flush();
 
     // free the memory, note that events is freed in the base class destructor
-    for (int i = 0; i < nodes.size(); ++i) {
-        Node *node = nodes.back();
-        nodes.pop_back();
+    for (auto &node : nodes) {
         delete node;
     }
-    for (int i = 0; i < users.size(); ++i) {
-        User *user = users.back();
-        users.pop_back();
+    for (auto &user : users) {
         delete user;
     }
+    users.clear();
     delete weekendBegin;
     delete weekendEnd;
+    for (auto &event : reservationEvents) {
+        delete event;
+    }
+    delete scheduler;
+
+}
 
+HPCSimulator::~HPCSimulator() {
+    for (auto &user : users) {
+        delete user;
+    }
+    for (auto &group : groups) {
+        delete group;
+    }
+    for (auto &curriculum : curriculums) {
+        delete curriculum;
+    }
+    for (auto &job : finishedSmallJobs) {
+        delete job;
+    }
+    for (auto &job : finishedMediumJobs) {
+        delete job;
+    }
+    for (auto &job : finishedLargeJobs) {
+        delete job;
+    }
+    for (auto &job : finishedHugeJobs) {
+        delete job;
+    }
+    for (auto &job : finishedGpuJobs) {
+        delete job;
+    }
 }
 
 void HPCSimulator::initialisation(string filename) {
-    cout << "Initialising simulation from file \n";
+    HPC_TRACE(this, TraceInfo, "Initialising simulation from file \n");
     std::ifstream inputStream(filename);
     std::string line = "";
     getline(inputStream, line);
@@ -90,6 +167,7 @@ void HPCSimulator::initialisation(string filename) {
             //budget line:
             commonBudget = std::stod(line.substr(line.find(' ') + 1, line.size() - 1));
             auto *group = new Group(commonBudget);
+            groups.push_back(group);
             initialUsersBudget += commonBudget;
 
             // permission line :
@@ -133,13 +211,15 @@ void HPCSimulator::initialisation(string filename) {
                 }
                 researcher->setPermission(permissions[0], permissions[1], permissions[2], permissions[3],
                                           permissions[4]);
+                researcher->setUserId(users.size() + 1);
                 users.push_back(researcher);
             }
 
 
-            cout << " Group : " << commonBudget << ',' << permissions[0] << permissions[1] << permissions[2]
-                 << permissions[3] << permissions[4] << ',' << averageTimeBetweenJobs << "," << numberOfResearchers
-                 << "\n";
+            HPC_TRACE(this, TraceInfo,
+                      " Group : " << commonBudget << ',' << permissions[0] << permissions[1] << permissions[2]
+                                  << permissions[3] << permissions[4] << ',' << averageTimeBetweenJobs << ","
+                                  << numberOfResearchers << "\n");
             getline(inputStream, line);
         }
     }
@@ -166,6 +246,7 @@ void HPCSimulator::initialisation(string filename) {
             instantanousCap = std::stoi(line.substr(line.find(' ') + 1, line.size() - 1));
 
             auto *curriculum = new Curriculum(cummulativeCap, instantanousCap);
+            curriculums.push_back(curriculum);
 
             // permission line :
             getline(inputStream, line);
@@ -186,16 +267,89 @@ void HPCSimulator::initialisation(string filename) {
             for (int j = 0; j < numberOfStudents; ++j) {
                 Student *student = new Student(curriculum, averageTimeBetweenJobs);
                 student->setPermission(permissions[0], permissions[1], permissions[2], permissions[3], permissions[4]);
+                student->setUserId(users.size() + 1);
                 users.push_back(student);
             }
 
-            cout << " Curriculum : " << cummulativeCap << "," << instantanousCap << ',' << permissions[0]
-                 << permissions[1] << permissions[2]
-                 << permissions[3] << permissions[4] << ',' << averageTimeBetweenJobs << "," << numberOfStudents
-                 << "\n";
+            HPC_TRACE(this, TraceInfo,
+                      " Curriculum : " << cummulativeCap << "," << instantanousCap << ',' << permissions[0]
+                                       << permissions[1] << permissions[2] << permissions[3] << permissions[4] << ','
+                                       << averageTimeBetweenJobs << "," << numberOfStudents << "\n");
             getline(inputStream, line);
         }
     }
+    //Optional scheduler section, only the first invalid line is reported
+    auto invalidLine = [this, &line](const std::string &what) {
+        if (inputError.empty()) {
+            inputError = what + " : " + line.substr(0, line.find_last_not_of(" \t\r") + 1);
+        }
+    };
+    while (getline(inputStream, line)) {
+        std::istringstream words(line);
+        std::string keyword;
+        if (!(words >> keyword) || keyword[0] == '#') {
+            continue;
+        }
+        if (keyword == "Scheduler") {
+            std::string name;
+            words >> name;
+            setSchedulerName(name);
+        } else if (keyword == "SchedulerParameter") {
+            // the value is the rest of the line, it may contain spaces
+            std::string name, value;
+            words >> name >> std::ws;
+            getline(words, value);
+            value.erase(value.find_last_not_of(" \t\r") + 1);
+            setSchedulerParameter(name, value);
+        } else if (keyword == "NodesPerRack") {
+            if (!(words >> nodesPerRack) || nodesPerRack <= 0) {
+                nodesPerRack = 0;
+                invalidLine("Invalid number of nodes per rack");
+            }
+        } else if (keyword == "CommunicationPenalty") {
+            if (!(words >> communicationPenalty) || communicationPenalty < 0) {
+                communicationPenalty = 0;
+                invalidLine("Invalid communication penalty");
+            }
+        } else if (keyword == "CompactPlacement") {
+            // 0 or 1
+            if (!(words >> compactPlacement)) {
+                compactPlacement = true;
+                invalidLine("Invalid compact placement");
+            }
+        } else if (keyword == "FilesystemBandwidth") {
+            if (!(words >> filesystemBandwidth) || filesystemBandwidth <= 0) {
+                filesystemBandwidth = 0;
+                invalidLine("Invalid filesystem bandwidth");
+            }
+        } else if (keyword == "WalltimeOverestimate") {
+            if (!(words >> walltimeOverestimate) || walltimeOverestimate < 1) {
+                walltimeOverestimate = 1;
+                invalidLine("Invalid walltime overestimate");
+            }
+        } else if (keyword == "Reservation") {
+            Reservation reservation{};
+            if (words >> reservation.start >> reservation.end >> reservation.firstNode >> reservation.lastNode &&
+                reservation.start < reservation.end && 0 <= reservation.firstNode &&
+                reservation.firstNode <= reservation.lastNode &&
+                reservation.lastNode < HPCParameters::TotalNumberOfNodes) {
+                reservations.push_back(reservation);
+            } else {
+                invalidLine("Invalid reservation");
+            }
+        } else {
+            invalidLine("Unknown keyword");
+        }
+        HPC_TRACE(this, TraceInfo, " " << line << "\n");
+    }
+    if (communicationPenalty > 0 && nodesPerRack == 0 && inputError.empty()) {
+        inputError = "A communication penalty requires the number of nodes per rack";
+    }
+    tracer.flush();
+}
+
+bool JobIdOrder::operator()(const AbstractJob *a, const AbstractJob *b) const {
+    return a->getId() < b->getId();
 }
 
 void HPCSimulator::registerFinishedGpuJobs(GpuJob *pJob) {
@@ -218,106 +372,125 @@ void HPCSimulator::registerFinishedHugeJobs(HugeJob *pJob) {
     finishedHugeJobs.insert(pJob);
 }
 
-void HPCSimulator::printResults() {
+/**
+ * Add the measurements of a category of finished jobs
+ */
+template<typename T>
+static void measureFinishedJobs(const std::set<T *, JobIdOrder> &finishedJobs, double &nodeHoursUsed,
+                                double &averageWaitingTime, std::vector<double> &turnaroudTimeRatio) {
+    for (auto &job: finishedJobs) {
+        nodeHoursUsed += job->getNodeHours();
+        averageWaitingTime += (job->getCompletionTime() - job->getSubmittingTime() - job->getExecutionDuration());
+        turnaroudTimeRatio.push_back(
+                (job->getCompletionTime() - job->getSubmittingTime()) / job->getExecutionDuration());
+    }
+    averageWaitingTime = averageWaitingTime / finishedJobs.size();
+}
+
+SimulationResults HPCSimulator::computeResults() {
+    SimulationResults results;
     int numberOfHoursInAWeek = 168;
     double numberOfWeeks = floor(time / numberOfHoursInAWeek);
-    double nodeHoursUsed = 0, nodeHoursUsedBySmall = 0, nodeHoursUsedByMedium = 0, nodeHoursUsedByLarge = 0, nodeHoursUsedByHuge = 0, nodeHoursUsedByGpu = 0;
-    double averageWaitingTimeSmall = 0, averageWaitingTimeMedium = 0, averageWaitingTimeLarge = 0, averageWaitingTimeHuge = 0, averageWaitingTimeGpu = 0;
     std::vector<double> turnaroudTimeRatio;
-    double averageTurnaroundTimeRatio = 0;
     double opertationCost = HPCParameters::overallOperationCostPerHour * (numberOfWeeks * numberOfHoursInAWeek);
 
-    cout << "\nThe simulation ran for : " << numberOfWeeks << " weeks \n";
-    cout << "==============THROUGHPUT==============\n";
-    cout << "In average, " << finishedSmallJobs.size() / numberOfWeeks << " small jobs ran per weeks \n";
-    cout << "In average, " << finishedMediumJobs.size() / numberOfWeeks << " medium jobs ran per weeks \n";
-    cout << "In average, " << finishedLargeJobs.size() / numberOfWeeks << " large jobs ran per weeks \n";
-    cout << "In average, " << finishedHugeJobs.size() / numberOfWeeks << " huge jobs ran per weeks \n";
-    cout << "In average, " << finishedGpuJobs.size() / numberOfWeeks << " gpu jobs ran per weeks \n";
-
-    for (auto &job: finishedSmallJobs) {
-        nodeHoursUsedBySmall += job->getExecutionDuration()*job->getNumberOfNodes();
-        averageWaitingTimeSmall += (job->getCompletionTime() - job->getSubmittingTime() - job->getExecutionDuration());
-        turnaroudTimeRatio.push_back(
-                (job->getCompletionTime() - job->getSubmittingTime()) / job->getExecutionDuration());
-    }
-    averageWaitingTimeSmall = averageWaitingTimeSmall / finishedSmallJobs.size();
-    for (auto &job: finishedMediumJobs) {
-        nodeHoursUsedByMedium += job->getExecutionDuration()*job->getNumberOfNodes();
-        averageWaitingTimeMedium += (job->getCompletionTime() - job->getSubmittingTime() - job->getExecutionDuration());
-        turnaroudTimeRatio.push_back(
-                (job->getCompletionTime() - job->getSubmittingTime()) / job->getExecutionDuration());
+    results.numberOfWeeks = numberOfWeeks;
+    results.jobsPerWeek[0] = finishedSmallJobs.size() / numberOfWeeks;
+    results.jobsPerWeek[1] = finishedMediumJobs.size() / numberOfWeeks;
+    results.jobsPerWeek[2] = finishedLargeJobs.size() / numberOfWeeks;
+    results.jobsPerWeek[3] = finishedHugeJobs.size() / numberOfWeeks;
+    results.jobsPerWeek[4] = finishedGpuJobs.size() / numberOfWeeks;
+
+    measureFinishedJobs(finishedSmallJobs, results.nodeHoursUsedByType[0], results.averageWaitingTime[0],
+                        turnaroudTimeRatio);
+    measureFinishedJobs(finishedMediumJobs, results.nodeHoursUsedByType[1], results.averageWaitingTime[1],
+                        turnaroudTimeRatio);
+    measureFinishedJobs(finishedLargeJobs, results.nodeHoursUsedByType[2], results.averageWaitingTime[2],
+                        turnaroudTimeRatio);
+    measureFinishedJobs(finishedHugeJobs, results.nodeHoursUsedByType[3], results.averageWaitingTime[3],
+                        turnaroudTimeRatio);
+    measureFinishedJobs(finishedGpuJobs, results.nodeHoursUsedByType[4], results.averageWaitingTime[4],
+                        turnaroudTimeRatio);
+
+    results.nodeHoursUsed = results.nodeHoursUsedByType[4] + results.nodeHoursUsedByType[3] +
+                            results.nodeHoursUsedByType[2] + results.nodeHoursUsedByType[1] +
+                            results.nodeHoursUsedByType[0];
+    results.availableNodeHours = initialUsersBudget;
+    results.utilizationRatio = results.nodeHoursUsed / (numberOfHoursInAWeek * numberOfWeeks);
+
+    for (auto &ratio : turnaroudTimeRatio) {
+        results.averageTurnaroundTimeRatio += ratio;
     }
-    averageWaitingTimeMedium = averageWaitingTimeMedium / finishedMediumJobs.size();
-    for (auto &job: finishedLargeJobs) {
-        nodeHoursUsedByLarge += job->getExecutionDuration()*job->getNumberOfNodes();
-        averageWaitingTimeLarge += (job->getCompletionTime() - job->getSubmittingTime() - job->getExecutionDuration());
-        turnaroudTimeRatio.push_back(
-                (job->getCompletionTime() - job->getSubmittingTime()) / job->getExecutionDuration());
+    results.averageTurnaroundTimeRatio = results.averageTurnaroundTimeRatio / turnaroudTimeRatio.size();
+
+    results.totalUserCost = results.nodeHoursUsed * HPCParameters::costOneHourOneNode +
+                            (results.nodeHoursUsedByType[4] *
+                             (HPCParameters::costOneHourOneGPUNode - HPCParameters::costOneHourOneNode));
+    results.economicBalance = results.totalUserCost - opertationCost;
+    return results;
+}
+
+std::vector<std::pair<std::string, double>> SimulationResults::namedValues() const {
+    const std::string types[5] = {"small", "medium", "large", "huge", "gpu"};
+    std::vector<std::pair<std::string, double>> values;
+    for (int i = 0; i < 5; ++i) {
+        values.emplace_back(types[i] + " jobs per week", jobsPerWeek[i]);
     }
-    averageWaitingTimeLarge = averageWaitingTimeLarge / finishedLargeJobs.size();
-    for (auto &job: finishedHugeJobs) {
-        nodeHoursUsedByHuge += job->getExecutionDuration()*job->getNumberOfNodes();
-        averageWaitingTimeHuge += (job->getCompletionTime() - job->getSubmittingTime() - job->getExecutionDuration());
-        turnaroudTimeRatio.push_back(
-                (job->getCompletionTime() - job->getSubmittingTime()) / job->getExecutionDuration());
+    values.emplace_back("node-hours used", nodeHoursUsed);
+    for (int i = 0; i < 5; ++i) {
+        values.emplace_back("node-hours used by " + types[i] + " jobs", nodeHoursUsedByType[i]);
     }
-    averageWaitingTimeHuge = averageWaitingTimeHuge / finishedHugeJobs.size();
-    for (auto &job: finishedGpuJobs) {
-        nodeHoursUsedByGpu += job->getExecutionDuration()*job->getNumberOfNodes();
-        averageWaitingTimeGpu += (job->getCompletionTime() - job->getSubmittingTime() - job->getExecutionDuration());
-        turnaroudTimeRatio.push_back(
-                (job->getCompletionTime() - job->getSubmittingTime()) / job->getExecutionDuration());
+    values.emplace_back("utilization ratio", utilizationRatio);
+    values.emplace_back("price paid by users", totalUserCost);
+    for (int i = 0; i < 5; ++i) {
+        values.emplace_back("average waiting time of " + types[i] + " jobs", averageWaitingTime[i]);
     }
-    averageWaitingTimeGpu = averageWaitingTimeGpu / finishedGpuJobs.size();
+    values.emplace_back("average turnaround time ratio", averageTurnaroundTimeRatio);
+    values.emplace_back("economic balance", economicBalance);
+    return values;
+}
 
-    nodeHoursUsed = nodeHoursUsedByGpu + nodeHoursUsedByHuge + nodeHoursUsedByLarge + nodeHoursUsedByMedium +
-                    nodeHoursUsedBySmall;
+void HPCSimulator::printResults() {
+    SimulationResults results = computeResults();
 
-    for (auto &ratio : turnaroudTimeRatio) {
-        averageTurnaroundTimeRatio += ratio;
-    }
-    averageTurnaroundTimeRatio = averageTurnaroundTimeRatio / turnaroudTimeRatio.size();
+    cout << "\nThe simulation ran for : " << results.numberOfWeeks << " weeks \n";
+    cout << "==============THROUGHPUT==============\n";
+    cout << "In average, " << results.jobsPerWeek[0] << " small jobs ran per weeks \n";
+    cout << "In average, " << results.jobsPerWeek[1] << " medium jobs ran per weeks \n";
+    cout << "In average, " << results.jobsPerWeek[2] << " large jobs ran per weeks \n";
+    cout << "In average, " << results.jobsPerWeek[3] << " huge jobs ran per weeks \n";
+    cout << "In average, " << results.jobsPerWeek[4] << " gpu jobs ran per weeks \n";
 
     cout << "\n============NODE-HOURS USED============\n";
-    cout << nodeHoursUsed << " node-hours have been used on " << initialUsersBudget << " available\n"
-         << nodeHoursUsedBySmall << " for small jobs \n"
-         << nodeHoursUsedByMedium << " for medium jobs \n"
-         << nodeHoursUsedByLarge << " for large jobs \n"
-         << nodeHoursUsedByHuge << " for huge jobs \n"
-         << nodeHoursUsedByGpu << " for Gpu jobs \n"
-         << " The utilization ratio is " << nodeHoursUsed / (numberOfHoursInAWeek * numberOfWeeks) << "\n"
+    cout << results.nodeHoursUsed << " node-hours have been used on " << results.availableNodeHours << " available\n"
+         << results.nodeHoursUsedByType[0] << " for small jobs \n"
+         << results.nodeHoursUsedByType[1] << " for medium jobs \n"
+         << results.nodeHoursUsedByType[2] << " for large jobs \n"
+         << results.nodeHoursUsedByType[3] << " for huge jobs \n"
+         << results.nodeHoursUsedByType[4] << " for Gpu jobs \n"
+         << " The utilization ratio is " << results.utilizationRatio << "\n"
          << "'(number of node-hours used / number of node-hours available on the HPC)";
 
 
     cout << "\n================ COSTS ================\n";
-    double totalUserCost = nodeHoursUsed * HPCParameters::costOneHourOneNode + (nodeHoursUsedByGpu *
-                                                                                (HPCParameters::costOneHourOneGPUNode -
-                                                                                 HPCParameters::costOneHourOneNode));
-    cout << "Resulting price paid by users :" << totalUserCost << "\n"
-         << nodeHoursUsedBySmall * HPCParameters::costOneHourOneNode << " for small jobs \n"
-         << nodeHoursUsedByMedium * HPCParameters::costOneHourOneNode << " for medium jobs \n"
-         << nodeHoursUsedByLarge * HPCParameters::costOneHourOneNode << " for large jobs \n"
-         << nodeHoursUsedByHuge * HPCParameters::costOneHourOneNode << " for huge jobs \n"
-         << nodeHoursUsedByGpu * HPCParameters::costOneHourOneGPUNode << " for Gpu jobs \n";
+    cout << "Resulting price paid by users :" << results.totalUserCost << "\n"
+         << results.nodeHoursUsedByType[0] * HPCParameters::costOneHourOneNode << " for small jobs \n"
+         << results.nodeHoursUsedByType[1] * HPCParameters::costOneHourOneNode << " for medium jobs \n"
+         << results.nodeHoursUsedByType[2] * HPCParameters::costOneHourOneNode << " for large jobs \n"
+         << results.nodeHoursUsedByType[3] * HPCParameters::costOneHourOneNode << " for huge jobs \n"
+         << results.nodeHoursUsedByType[4] * HPCParameters::costOneHourOneGPUNode << " for Gpu jobs \n";
 
 
     cout << "\n============ WAITING TIME ============\n"
          << "Average waiting time in queue : \n"
-         << averageWaitingTimeSmall << " for small jobs \n"
-         << averageWaitingTimeMedium << " for medium jobs \n"
-         << averageWaitingTimeLarge << " for large jobs \n"
-         << averageWaitingTimeHuge << " for huge jobs \n"
-         << averageWaitingTimeGpu << " for Gpu jobs \n";
-    cout << "Average turnaround time ratio : " << averageTurnaroundTimeRatio << "\n";
+         << results.averageWaitingTime[0] << " for small jobs \n"
+         << results.averageWaitingTime[1] << " for medium jobs \n"
+         << results.averageWaitingTime[2] << " for large jobs \n"
+         << results.averageWaitingTime[3] << " for huge jobs \n"
+         << results.averageWaitingTime[4] << " for Gpu jobs \n";
+    cout << "Average turnaround time ratio : " << results.averageTurnaroundTimeRatio << "\n";
 
 
     cout << "\n=========== ECONOMIC BALANCE ==========\n";
-    cout << "Economic balance of the center : " << totalUserCost - opertationCost << "\n";
+    cout << "Economic balance of the center : " << results.economicBalance << "\n";
 }
-
-
-
-
-	
-
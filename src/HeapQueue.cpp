@@ -0,0 +1,104 @@
+#include <cmath>
+#include "../include/HeapQueue.h"
+
+bool HeapQueue::before(const Entry &a, const Entry &b) {
+    if (a.element->lessThan(b.element)) {
+        return true;
+    }
+    if (b.element->lessThan(a.element)) {
+        return false;
+    }
+    // same as the ListQueue: the last inserted comes first
+    return a.insertionNumber > b.insertionNumber;
+}
+
+void HeapQueue::place(size_t position, const Entry &entry) {
+    heap[position] = entry;
+    positions[entry.element] = position;
+}
+
+void HeapQueue::siftUp(size_t position) {
+    Entry entry = heap[position];
+    while (position > 0) {
+        size_t parent = (position - 1) / 2;
+        if (!before(entry, heap[parent])) {
+            break;
+        }
+        place(position, heap[parent]);
+        position = parent;
+    }
+    place(position, entry);
+}
+
+void HeapQueue::siftDown(size_t position) {
+    Entry entry = heap[position];
+    size_t heapSize = heap.size();
+    while (true) {
+        size_t child = 2 * position + 1;
+        if (child >= heapSize) {
+            break;
+        }
+        if (child + 1 < heapSize && before(heap[child + 1], heap[child])) {
+            child++;
+        }
+        if (!before(heap[child], entry)) {
+            break;
+        }
+        place(position, heap[child]);
+        position = child;
+    }
+    place(position, entry);
+}
+
+Comparable *HeapQueue::removeAt(size_t position) {
+    Comparable *x = heap[position].element;
+    positions.erase(x);
+    Entry last = heap.back();
+    heap.pop_back();
+    if (position < heap.size()) {
+        place(position, last);
+        // the moved entry can go either up or down depending on where it was taken from
+        if (position > 0 && before(last, heap[(position - 1) / 2])) {
+            siftUp(position);
+        } else {
+            siftDown(position);
+        }
+    }
+    return x;
+}
+
+void HeapQueue::insert(Comparable *x) {
+    heap.push_back(Entry{x, insertionCounter++});
+    siftUp(heap.size() - 1);
+}
+
+Comparable *HeapQueue::removeFirst() {
+    if (heap.empty()) return 0;
+    return removeAt(0);
+}
+
+Comparable *HeapQueue::remove(Comparable *x) {
+    auto it = positions.find(x);
+    if (it == positions.end()) return 0;
+    return removeAt(it->second);
+}
+
+void HeapQueue::update(const std::vector<Comparable *> &xs, const std::function<void(Comparable *)> &change) {
+    if (xs.size() * std::log2(heap.size() + 1) < heap.size()) {
+        OrderedSet::update(xs, change);
+        return;
+    }
+    // the elements get new insertion numbers, in the order in which they are passed, as if inserted again
+    for (auto &x : xs) {
+        Entry &entry = heap[positions.at(x)];
+        change(x);
+        entry.insertionNumber = insertionCounter++;
+    }
+    for (size_t position = heap.size() / 2; position-- > 0;) {
+        siftDown(position);
+    }
+}
+
+int HeapQueue::size() {
+    return heap.size();
+}
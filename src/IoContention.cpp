@@ -0,0 +1,44 @@
+#include <algorithm>
+#include "../include/IoContention.h"
+#include "../include/AbstractJob.h"
+
+void IoContention::advance(double now) {
+    for (auto &running : jobs) {
+        running.second.workLeft -= (now - lastUpdate) * running.second.rate;
+    }
+    lastUpdate = now;
+}
+
+void IoContention::updateRates(double now, std::vector<std::pair<AbstractJob *, double>> &completions) {
+    for (auto &running : jobs) {
+        Progress &progress = running.second;
+        double ioIntensity = progress.job->getIoIntensity();
+        double rate = 1 / (1 - ioIntensity + ioIntensity * slowdown());
+        if (rate != progress.rate) {
+            progress.rate = rate;
+            completions.emplace_back(progress.job, now + std::max(0.0, progress.workLeft) / rate);
+        }
+    }
+}
+
+void IoContention::start(AbstractJob *job, double now, std::vector<std::pair<AbstractJob *, double>> &completions) {
+    advance(now);
+    // the rate is unknown until the contention is computed again, the job is then always rescheduled
+    jobs[job->getId()] = Progress{job, job->getRemainingDuration(), 0};
+    demand += job->getIoIntensity() * job->getNumberOfNodes();
+    updateRates(now, completions);
+}
+
+double IoContention::stop(AbstractJob *job, double now, std::vector<std::pair<AbstractJob *, double>> &completions) {
+    advance(now);
+    auto it = jobs.find(job->getId());
+    double workDone = job->getRemainingDuration() - it->second.workLeft;
+    jobs.erase(it);
+    demand -= job->getIoIntensity() * job->getNumberOfNodes();
+    if (jobs.empty()) {
+        // no rounding error is kept once the filesystem is idle
+        demand = 0;
+    }
+    updateRates(now, completions);
+    return workDone;
+}
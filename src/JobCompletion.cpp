@@ -0,0 +1,40 @@
+#include "../include/JobCompletion.h"
+#include "../include/AbstractJob.h"
+#include "../include/Node.h"
+#include "../include/User.h"
+#include "../include/AbstractScheduler.h"
+
+JobCompletion::JobCompletion(AbstractScheduler *scheduler, AbstractJob *job, const std::vector<Node *> &nodes,
+                             double now) : Event(now + job->getRemainingDuration()), scheduler(scheduler), job(job),
+                                           nodes(nodes) {
+}
+
+void JobCompletion::execute(AbstractSimulator *simulator) {
+    Event::execute(simulator);
+    scheduler->stopIo(simulator, job);
+    if (HPC_TRACE_LEVEL >= TraceEvents && simulator->getTracer().isEnabled(TraceEvents)) {
+        printMessage(simulator->getTracer().stream());
+    }
+    job->getUser()->reduceNumberOfCurrentlyUsedNodeBy(nodes.size());
+    job->setCompletionTime(simulator->now());
+    HPC_TRACE_RECORD(simulator, job->traceRecord(RecordJobFinish, simulator->now()));
+    if (HPC_TRACE_LEVEL > TraceOff && simulator->getTracer().isRecording()) {
+        for (auto &node : nodes) {
+            BinaryTraceRecord record = job->traceRecord(RecordNodeFree, simulator->now());
+            record.nodeId = node->getId();
+            simulator->getTracer().record(record);
+        }
+    }
+    job->registerAsFinishedJob(dynamic_cast<HPCSimulator *>(simulator));
+    scheduler->completeJob(simulator, job, nodes);
+}
+
+void JobCompletion::printMessage(std::ostream &out) {
+    out << "Finished executing " << job->getId() << " (" << job->getType() << ") at time " << convertTime(time)
+        << " on " << nodes.size() << " nodes\n";
+    out << "Execution duration was " << convertTime(job->getExecutionDuration()) << "\n";
+    out << "Job waiting time " << convertTime(time - job->getSubmittingTime()) << "\n";
+    out << "Job waiting time in queue "
+        << convertTime(time - job->getExecutionDuration() - job->getSubmittingTime())
+        << "\n";
+}
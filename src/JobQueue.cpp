@@ -0,0 +1,22 @@
+#include "../include/JobQueue.h"
+#include "../include/AbstractJob.h"
+
+AbstractJob *NextJobIndex::winner(AbstractJob *first, AbstractJob *second) {
+    if (first == nullptr) {
+        return second;
+    }
+    if (second != nullptr && second->priority() > first->priority()) {
+        return second;
+    }
+    return first;
+}
+
+void NextJobIndex::setHead(JobQueueSlot slot, AbstractJob *head) {
+    heads[slot] = head;
+    update();
+}
+
+void NextJobIndex::update() {
+    nonGpuWinner = winner(winner(heads[MediumJobQueue], heads[LargeJobQueue]), heads[SmallJobQueue]);
+    overallWinner = winner(heads[GpuJobQueue], nonGpuWinner);
+}
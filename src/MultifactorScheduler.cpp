@@ -0,0 +1,32 @@
+#include "../include/MultifactorScheduler.h"
+#include "../include/User.h"
+
+const char *const MultifactorScheduler::defaultPriority = "1000*age + 1000*fairShare";
+
+MultifactorScheduler::MultifactorScheduler(const SchedulerParameters &parameters) :
+        FairShareScheduler(parameters),
+        formula(parameters.getString("priority", defaultPriority)),
+        usageScale(parameters.get("usageScale", 1000)),
+        recalculationPeriod(parameters.get("recalculationPeriod", 24)) {
+}
+
+double MultifactorScheduler::priorityOf(AbstractJob *job, double time) {
+    const User *user = job->getUser();
+    UserKind userKind = OtherUserKind;
+    if (user->getCurriculum() != nullptr) {
+        userKind = StudentUserKind;
+    } else if (user->getGroup() != nullptr) {
+        userKind = ResearcherUserKind;
+    }
+    double fairShare = 1 / (1 + usage.weightedUsage(user, time) / usageScale);
+    return formula.evaluate(job->getTypeIndex(), userKind, job->getSubmittingTime(), job->getNumberOfNodes(),
+                            fairShare);
+}
+
+void MultifactorScheduler::startJob(AbstractSimulator *simulator, AbstractJob *job, const std::vector<Node *> &nodes) {
+    FairShareScheduler::startJob(simulator, job, nodes);
+    if (simulator->now() - lastRecalculation >= recalculationPeriod) {
+        lastRecalculation = simulator->now();
+        updateAllPriorities(simulator->now());
+    }
+}
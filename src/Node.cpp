@@ -1,5 +1,8 @@
 #include "../include/Node.h"
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <iostream>
 #include "../include/AbstractScheduler.h"
 #include "../include/User.h"
 #include "../include/AbstractJob.h"
@@ -10,10 +13,6 @@
 
 
 
-Node::Node() : Event() {
-    jobBeingExecuted = nullptr;
-}
-
 Node &Node::addScheduler(AbstractScheduler *scheduler) {
     this->scheduler = scheduler;
     return *this;
@@ -21,25 +20,23 @@ Node &Node::addScheduler(AbstractScheduler *scheduler) {
 
 
 
-void Node::execute(AbstractSimulator *HPCsimulator) {
-    Event::execute(HPCsimulator);
-    printMessage();
-    (jobBeingExecuted->getUser())->reduceNumberOfCurrentlyUsedNodeBy(1);
-    jobBeingExecuted->setCompletionTime(HPCsimulator->now());
-    jobBeingExecuted->registerAsFinishedJob(dynamic_cast<HPCSimulator *>(HPCsimulator));
-    jobBeingExecuted = nullptr;
-    addFreeNodeToScheduler(HPCsimulator);
+void Node::release(AbstractJob *job) {
+    usedCores -= job->getNumberOfCores();
+    jobsBeingExecuted.erase(std::remove(jobsBeingExecuted.begin(), jobsBeingExecuted.end(), job),
+                            jobsBeingExecuted.end());
 }
 
 void Node::addFreeNodeToScheduler(AbstractSimulator * simulator) {
-    scheduler->addFreeNode(simulator, this);
-}
-void ReservedForSmallJobNode::addFreeNodeToScheduler(AbstractSimulator *simulator) {
-    scheduler->addFreeSmallNode(simulator,this);
-}
-
-void ReservedForMediumJobNode::addFreeNodeToScheduler(AbstractSimulator * simulator) {
-    scheduler->addFreeMediumNode(simulator, this);
+    switch (nodeClass) {
+        case SmallNodeClass:
+            scheduler->addFreeSmallNode(simulator, this);
+            break;
+        case MediumNodeClass:
+            scheduler->addFreeMediumNode(simulator, this);
+            break;
+        default:
+            scheduler->addFreeNode(simulator, this);
+    }
 }
 
 void GpuNode::addFreeNodeToScheduler(AbstractSimulator *simulator) {
@@ -47,31 +44,17 @@ void GpuNode::addFreeNodeToScheduler(AbstractSimulator *simulator) {
 }
 
 bool Node::isAvailable() {
-    return (jobBeingExecuted == 0);
+    return (usedCores == 0);
 }
 
 
-/**
-* Start a customer's service.  The simulator must be passed in
-* as a parameter so that this can  schedule the time
-* when this server will be done with the customer.
-*/
-void Node::insert(AbstractSimulator *simulator, AbstractJob *job) {
-    if (jobBeingExecuted != nullptr) {
-        /* Should never reach here */
-        std::cout << "Error: I am busy serving someone else" << "\n";
+void Node::assign(AbstractJob *job) {
+    if (usedCores + job->getNumberOfCores() > HPCParameters::coresPerNode) {
+        // a scheduler gave the node to two jobs, the results of the simulation would be wrong
+        std::cerr << "Error: node " << id << " assigned to job " << job->getId() << " while serving "
+                  << getJobBeingExecuted()->getId() << "\n";
+        std::abort();
     }
-    jobBeingExecuted = job;
-    // service time is set at average 15 patients per hour
-    time = simulator->now() + job->getExecutionDuration() ;//Random::exponential(15)
-    simulator->insert(this);
-}
-
-void Node::printMessage() {
-    std::cout << "Finished executing " << jobBeingExecuted->getId() << " (" <<jobBeingExecuted->getType()<<") at time " << convertTime(time) << "\n";
-    std::cout << "Execution duration was " << convertTime(jobBeingExecuted->getExecutionDuration()) << "\n";
-    std::cout << "Job waiting time " << convertTime(time - jobBeingExecuted->getSubmittingTime()) << "\n";
-    std::cout << "Job waiting time in queue "
-              << convertTime(time - jobBeingExecuted->getExecutionDuration() - jobBeingExecuted->getSubmittingTime())
-              << "\n";
+    usedCores += job->getNumberOfCores();
+    jobsBeingExecuted.push_back(job);
 }
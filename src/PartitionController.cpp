@@ -0,0 +1,33 @@
+#include <algorithm>
+#include "../include/PartitionController.h"
+
+PartitionController::PartitionController(double period, int minSmallNodes, int maxSmallNodes, int minMediumNodes,
+                                         int maxMediumNodes) : period(period) {
+    minNodes[SmallNodeClass] = minSmallNodes;
+    maxNodes[SmallNodeClass] = maxSmallNodes;
+    minNodes[MediumNodeClass] = minMediumNodes;
+    maxNodes[MediumNodeClass] = maxMediumNodes;
+}
+
+bool PartitionController::startResizing(double time) {
+    if (time - lastResizing < period) {
+        return false;
+    }
+    lastResizing = time;
+    return true;
+}
+
+int PartitionController::transfer(NodeClass partition, int size, int freeNodes, int freeNormalNodes,
+                                  double partitionWait, int partitionJobs, double largeJobWait,
+                                  int largeJobs) const {
+    double partitionPressure = partitionWait * partitionJobs;
+    double largeJobPressure = largeJobWait * largeJobs;
+    if (largeJobPressure > partitionPressure) {
+        // the free nodes of the partition are lent to the large jobs
+        return -std::max(0, std::min(freeNodes, size - minNodes[partition]));
+    }
+    if (partitionPressure > largeJobPressure) {
+        return std::max(0, std::min(freeNormalNodes, maxNodes[partition] - size));
+    }
+    return 0;
+}
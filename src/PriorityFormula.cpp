@@ -0,0 +1,92 @@
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+#include "../include/PriorityFormula.h"
+#include "../include/HPCParameters.h"
+
+const char *const PriorityFormula::factorNames[NumberOfPriorityFactors] = {
+        "age", "size", "fairShare", "small", "medium", "large", "huge", "gpu", "student", "researcher"};
+
+PriorityFormula::PriorityFormula(const std::string &expression) {
+    std::string error;
+    if (!parse(expression, error)) {
+        throw std::invalid_argument(error);
+    }
+}
+
+bool PriorityFormula::parse(const std::string &expression, std::string &error) {
+    double parsedWeights[NumberOfPriorityFactors] = {};
+    size_t position = 0;
+    auto skipSpaces = [&]() {
+        while (position < expression.size() && std::isspace((unsigned char) expression[position])) {
+            position++;
+        }
+    };
+    skipSpaces();
+    bool firstTerm = true;
+    while (position < expression.size()) {
+        double sign = 1;
+        if (expression[position] == '+' || expression[position] == '-') {
+            sign = expression[position] == '-' ? -1 : 1;
+            position++;
+            skipSpaces();
+        } else if (!firstTerm) {
+            error = "Expected + or - in the priority at : " + expression.substr(position);
+            return false;
+        }
+        firstTerm = false;
+
+        double weight = 1;
+        const char *start = expression.c_str() + position;
+        char *end;
+        double number = std::strtod(start, &end);
+        if (end != start) {
+            weight = number;
+            position += end - start;
+            skipSpaces();
+            if (position >= expression.size() || expression[position] != '*') {
+                error = "Expected * after the weight in the priority at : " + expression.substr(position);
+                return false;
+            }
+            position++;
+            skipSpaces();
+        }
+
+        size_t nameStart = position;
+        while (position < expression.size() && std::isalpha((unsigned char) expression[position])) {
+            position++;
+        }
+        std::string name = expression.substr(nameStart, position - nameStart);
+        int factor = 0;
+        while (factor < NumberOfPriorityFactors && name != factorNames[factor]) {
+            factor++;
+        }
+        if (factor == NumberOfPriorityFactors) {
+            error = "Unknown priority factor : " + name;
+            return false;
+        }
+        parsedWeights[factor] += sign * weight;
+        skipSpaces();
+    }
+    for (int factor = 0; factor < NumberOfPriorityFactors; ++factor) {
+        weights[factor] = parsedWeights[factor];
+    }
+    compile();
+    return true;
+}
+
+void PriorityFormula::compile() {
+    const double numberOfHoursInAWeek = 168;
+    const PriorityFactor typeFactors[5] = {SmallPriorityFactor, MediumPriorityFactor, LargePriorityFactor,
+                                           HugePriorityFactor, GpuPriorityFactor};
+    const double userKindTerms[NumberOfUserKinds] = {0, weights[StudentPriorityFactor],
+                                                     weights[ResearcherPriorityFactor]};
+    for (int type = 0; type < 5; ++type) {
+        for (int userKind = 0; userKind < NumberOfUserKinds; ++userKind) {
+            constantTerms[type][userKind] = weights[typeFactors[type]] + userKindTerms[userKind];
+        }
+    }
+    ageCoefficient = weights[AgePriorityFactor] / numberOfHoursInAWeek;
+    sizeCoefficient = weights[SizePriorityFactor] / HPCParameters::TotalNumberOfNodes;
+    fairShareCoefficient = weights[FairSharePriorityFactor];
+}
@@ -0,0 +1,123 @@
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include "../include/ReplicationDriver.h"
+
+ReplicationDriver::ReplicationDriver(const std::string &inputFile, uint64_t masterSeed, int numberOfReplications,
+                                     int numberOfThreads) : inputFile(inputFile), masterSeed(masterSeed),
+                                                            numberOfReplications(numberOfReplications),
+                                                            numberOfThreads(numberOfThreads) {
+}
+
+void ReplicationDriver::runReplication(int replication) {
+    HPCSimulator simulator;
+    simulator.getTracer().setLevel(TraceOff);
+    simulator.setEventQueueName(eventQueueName);
+    simulator.setSeed(RandomStream::substreamSeed(masterSeed, replication));
+    initialise(simulator);
+    simulator.start();
+    results[replication] = simulator.computeResults();
+}
+
+void ReplicationDriver::initialise(HPCSimulator &simulator) const {
+    simulator.initialisation(inputFile);
+    if (!schedulerName.empty()) {
+        simulator.setSchedulerName(schedulerName);
+    }
+    for (auto &parameter : schedulerParameters.getValues()) {
+        simulator.setSchedulerParameter(parameter.first, parameter.second);
+    }
+}
+
+bool ReplicationDriver::checkScheduler(std::string &error) const {
+    HPCSimulator simulator;
+    simulator.getTracer().setLevel(TraceOff);
+    initialise(simulator);
+    if (!simulator.getInputError().empty()) {
+        error = simulator.getInputError();
+        return false;
+    }
+    return SchedulerRegistry::check(simulator.getSchedulerName(), simulator.getSchedulerParameters(), error);
+}
+
+void ReplicationDriver::run() {
+    results.assign(numberOfReplications, SimulationResults());
+    std::atomic<int> nextReplication(0);
+    auto worker = [this, &nextReplication]() {
+        for (int replication = nextReplication++; replication < numberOfReplications;
+             replication = nextReplication++) {
+            runReplication(replication);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < numberOfThreads && i < numberOfReplications; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+double ReplicationDriver::confidenceHalfWidth(const std::vector<double> &values) {
+    size_t n = values.size();
+    if (n < 2) {
+        return 0;
+    }
+    // two-sided 97.5% quantiles of the Student distribution for 1 to 30 degrees of freedom
+    static const double studentQuantiles[30] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+                                                2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101,
+                                                2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052,
+                                                2.048, 2.045, 2.042};
+    double mean = 0;
+    for (auto &value : values) {
+        mean += value;
+    }
+    mean = mean / n;
+    double sumOfSquares = 0;
+    for (auto &value : values) {
+        sumOfSquares += (value - mean) * (value - mean);
+    }
+    double standardDeviation = std::sqrt(sumOfSquares / (n - 1));
+    double quantile = n - 1 <= 30 ? studentQuantiles[n - 2] : 1.96;
+    return quantile * standardDeviation / std::sqrt((double) n);
+}
+
+void ReplicationDriver::printSummary() const {
+    std::cout << "\n========== " << numberOfReplications << " REPLICATIONS ==========\n"
+              << "mean +/- half width of the 95% confidence interval \n";
+    if (results.empty()) {
+        return;
+    }
+    std::vector<std::pair<std::string, double>> names = results[0].namedValues();
+    std::vector<std::vector<double>> values(names.size());
+    for (auto &result : results) {
+        std::vector<std::pair<std::string, double>> namedValues = result.namedValues();
+        for (size_t i = 0; i < namedValues.size(); ++i) {
+            // a measurement is undefined when no job of its type finished during the replication
+            if (!std::isnan(namedValues[i].second)) {
+                values[i].push_back(namedValues[i].second);
+            }
+        }
+    }
+    for (size_t i = 0; i < names.size(); ++i) {
+        double mean = 0;
+        for (auto &value : values[i]) {
+            mean += value;
+        }
+        mean = mean / values[i].size();
+        std::cout << names[i].first << " : " << mean << " +/- ";
+        // a single value gives no interval, not an exact one
+        if (values[i].size() < 2) {
+            std::cout << "n/a";
+        } else {
+            std::cout << confidenceHalfWidth(values[i]);
+        }
+        if ((int) values[i].size() < numberOfReplications) {
+            std::cout << " (over " << values[i].size() << " replications)";
+        }
+        std::cout << "\n";
+    }
+}
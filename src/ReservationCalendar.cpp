@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "../include/ReservationCalendar.h"
+
+double ReservationCalendar::build(size_t first, size_t last) {
+    if (first >= last) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    size_t middle = first + (last - first) / 2;
+    latestEnd[middle] = std::max({reservations[middle].end, build(first, middle), build(middle + 1, last)});
+    return latestEnd[middle];
+}
+
+void ReservationCalendar::collect(size_t first, size_t last, double from, double to,
+                                  std::vector<const Reservation *> &found) const {
+    if (first >= last) {
+        return;
+    }
+    size_t middle = first + (last - first) / 2;
+    if (latestEnd[middle] <= from) {
+        return;
+    }
+    collect(first, middle, from, to, found);
+    // the reservations on the right start even later than the middle one
+    if (reservations[middle].start >= to) {
+        return;
+    }
+    if (reservations[middle].end > from) {
+        found.push_back(&reservations[middle]);
+    }
+    collect(middle + 1, last, from, to, found);
+}
+
+void ReservationCalendar::add(const Reservation &reservation) {
+    auto position = std::upper_bound(reservations.begin(), reservations.end(), reservation,
+                                     [](const Reservation &a, const Reservation &b) { return a.start < b.start; });
+    reservations.insert(position, reservation);
+    latestEnd.resize(reservations.size());
+    build(0, reservations.size());
+}
+
+std::vector<const Reservation *> ReservationCalendar::overlapping(double from, double to) const {
+    std::vector<const Reservation *> found;
+    collect(0, reservations.size(), from, to, found);
+    return found;
+}
+
+bool ReservationCalendar::isFree(int nodeId, double from, double to) const {
+    for (const Reservation *reservation : overlapping(from, to)) {
+        if (reservation->contains(nodeId)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ReservationCalendar::isReservedAt(int nodeId, double time) const {
+    // the smallest window starting at time
+    return !isFree(nodeId, time, std::nextafter(time, std::numeric_limits<double>::infinity()));
+}
@@ -0,0 +1,23 @@
+#include "../include/ReservationEvent.h"
+
+ReservationBegin::ReservationBegin(AbstractScheduler *scheduler, const Reservation &reservation)
+        : Event(reservation.start), scheduler(scheduler), reservation(reservation) {
+}
+
+void ReservationBegin::execute(AbstractSimulator *simulator) {
+    Event::execute(simulator);
+    HPC_TRACE(simulator, TraceInfo, "Reservation of nodes " << reservation.firstNode << " to " << reservation.lastNode
+                                                            << " begins at time " << convertTime(time) << "\n");
+    scheduler->beginReservation(simulator, reservation);
+}
+
+ReservationEnd::ReservationEnd(AbstractScheduler *scheduler, const Reservation &reservation)
+        : Event(reservation.end), scheduler(scheduler), reservation(reservation) {
+}
+
+void ReservationEnd::execute(AbstractSimulator *simulator) {
+    Event::execute(simulator);
+    HPC_TRACE(simulator, TraceInfo, "Reservation of nodes " << reservation.firstNode << " to " << reservation.lastNode
+                                                            << " ends at time " << convertTime(time) << "\n");
+    scheduler->endReservation(simulator, reservation);
+}
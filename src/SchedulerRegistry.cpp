@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <cstdlib>
+#include "../include/SchedulerRegistry.h"
+#include "../include/AbstractScheduler.h"
+#include "../include/EasyBackfillScheduler.h"
+#include "../include/ConservativeBackfillScheduler.h"
+#include "../include/FairShareScheduler.h"
+#include "../include/MultifactorScheduler.h"
+
+double SchedulerParameters::get(const std::string &name, double defaultValue) const {
+    auto value = values.find(name);
+    return value == values.end() ? defaultValue : std::strtod(value->second.c_str(), nullptr);
+}
+
+bool SchedulerParameters::isNumber(const std::string &name) const {
+    auto value = values.find(name);
+    if (value == values.end()) {
+        return false;
+    }
+    const char *start = value->second.c_str();
+    char *end;
+    std::strtod(start, &end);
+    return end != start && *end == '\0';
+}
+
+std::string SchedulerParameters::getString(const std::string &name, const std::string &defaultValue) const {
+    auto value = values.find(name);
+    return value == values.end() ? defaultValue : value->second;
+}
+
+std::vector<SchedulerDescription> &SchedulerRegistry::registeredSchedulers() {
+    static std::vector<SchedulerDescription> schedulers = {
+            {"fifo",         "first in first out, by priority",
+                    {"coreSharing", "moldableJobs"},
+                    [](const SchedulerParameters &) -> AbstractScheduler * { return new Scheduler(); },
+                    nullptr},
+            {"easy",         "EASY backfilling : jobs start early when they do not delay the next job",
+                    {},
+                    [](const SchedulerParameters &) -> AbstractScheduler * { return new EasyBackfillScheduler(); },
+                    nullptr},
+            {"conservative", "conservative backfilling : every job is reserved nodes when submitted",
+                    {},
+                    [](const SchedulerParameters &) -> AbstractScheduler * {
+                        return new ConservativeBackfillScheduler();
+                    },
+                    nullptr},
+            {"fairshare",    "first in first out, by decayed node-hours used by the user and its group or curriculum",
+                    {"halfLife", "userWeight", "accountWeight", "coreSharing", "moldableJobs"},
+                    [](const SchedulerParameters &parameters) -> AbstractScheduler * {
+                        return new FairShareScheduler(parameters);
+                    },
+                    nullptr},
+            {"multifactor",  "first in first out, by a weighted sum of the age, size, type, fair-share and user of the jobs",
+                    {"priority", "usageScale", "recalculationPeriod", "halfLife", "userWeight", "accountWeight",
+                     "coreSharing", "moldableJobs"},
+                    [](const SchedulerParameters &parameters) -> AbstractScheduler * {
+                        return new MultifactorScheduler(parameters);
+                    },
+                    [](const SchedulerParameters &parameters, std::string &error) {
+                        // the fair-share factor divides the usage by the scale
+                        if (parameters.get("usageScale", 1000) <= 0) {
+                            error = "The usageScale parameter must be positive";
+                            return false;
+                        }
+                        if (parameters.get("recalculationPeriod", 24) < 0) {
+                            error = "The recalculationPeriod parameter can not be negative";
+                            return false;
+                        }
+                        PriorityFormula formula;
+                        return formula.parse(parameters.getString("priority", MultifactorScheduler::defaultPriority),
+                                             error);
+                    }}};
+    return schedulers;
+}
+
+void SchedulerRegistry::add(const SchedulerDescription &description) {
+    std::vector<SchedulerDescription> &schedulers = registeredSchedulers();
+    for (auto &scheduler : schedulers) {
+        if (scheduler.name == description.name) {
+            scheduler = description;
+            return;
+        }
+    }
+    schedulers.push_back(description);
+}
+
+const SchedulerDescription *SchedulerRegistry::find(const std::string &name) {
+    for (auto &scheduler : registeredSchedulers()) {
+        if (scheduler.name == name) {
+            return &scheduler;
+        }
+    }
+    return nullptr;
+}
+
+const std::vector<std::string> &SchedulerRegistry::commonParameterNames() {
+    static const std::vector<std::string> names = {"weekendPacking", "maxSkippedWeekends", "preemption",
+                                                       "checkpointOverhead", "partitionPeriod", "minSmallNodes",
+                                                       "maxSmallNodes", "minMediumNodes", "maxMediumNodes"};
+    return names;
+}
+
+const std::vector<std::string> &SchedulerRegistry::textParameterNames() {
+    static const std::vector<std::string> names = {"priority"};
+    return names;
+}
+
+bool SchedulerRegistry::check(const std::string &name, const SchedulerParameters &parameters, std::string &error) {
+    const SchedulerDescription *description = find(name);
+    if (description == nullptr) {
+        error = "Unknown scheduler : " + name;
+        return false;
+    }
+    const std::vector<std::string> &commonNames = commonParameterNames();
+    const std::vector<std::string> &textNames = textParameterNames();
+    for (auto &parameter : parameters.getValues()) {
+        if (std::find(description->parameterNames.begin(), description->parameterNames.end(), parameter.first) ==
+            description->parameterNames.end() &&
+            std::find(commonNames.begin(), commonNames.end(), parameter.first) == commonNames.end()) {
+            error = "Unknown parameter of the " + name + " scheduler : " + parameter.first;
+            return false;
+        }
+        if (std::find(textNames.begin(), textNames.end(), parameter.first) == textNames.end() &&
+            !parameters.isNumber(parameter.first)) {
+            error = "Invalid value of parameter " + parameter.first;
+            return false;
+        }
+    }
+    if (parameters.get("maxSkippedWeekends", 0) < 0) {
+        error = "The maxSkippedWeekends parameter can not be negative";
+        return false;
+    }
+    if (parameters.get("checkpointOverhead", 0) < 0) {
+        error = "The checkpointOverhead parameter can not be negative";
+        return false;
+    }
+    if (parameters.get("partitionPeriod", 0) < 0) {
+        error = "The partitionPeriod parameter can not be negative";
+        return false;
+    }
+    if (parameters.get("minSmallNodes", 6) < 0 ||
+        parameters.get("minSmallNodes", 6) > parameters.get("maxSmallNodes", 13) ||
+        parameters.get("minMediumNodes", 19) < 0 ||
+        parameters.get("minMediumNodes", 19) > parameters.get("maxMediumNodes", 39)) {
+        error = "The bounds of the partitions can not be negative and the minimums can not exceed the maximums";
+        return false;
+    }
+    return description->validate == nullptr || description->validate(parameters, error);
+}
+
+AbstractScheduler *SchedulerRegistry::create(const std::string &name, const SchedulerParameters &parameters) {
+    std::string error;
+    if (!check(name, parameters, error)) {
+        return nullptr;
+    }
+    AbstractScheduler *scheduler = find(name)->create(parameters);
+    if (parameters.get("weekendPacking", 0) != 0) {
+        scheduler->setWeekendPlanner(new WeekendPlanner((int) parameters.get("maxSkippedWeekends", 2)));
+    }
+    if (parameters.get("coreSharing", 0) != 0) {
+        scheduler->enableCoreSharing();
+    }
+    if (parameters.get("moldableJobs", 0) != 0) {
+        scheduler->enableMolding();
+    }
+    if (parameters.get("partitionPeriod", 0) > 0) {
+        scheduler->setPartitionController(new PartitionController(
+                parameters.get("partitionPeriod", 0),
+                (int) parameters.get("minSmallNodes", 6), (int) parameters.get("maxSmallNodes", 13),
+                (int) parameters.get("minMediumNodes", 19), (int) parameters.get("maxMediumNodes", 39)));
+    }
+    if (parameters.get("preemption", 0) != 0) {
+        scheduler->enablePreemption(parameters.get("checkpointOverhead", 0.5));
+    }
+    return scheduler;
+}
@@ -10,7 +10,7 @@ bool Event::lessThan(Comparable* y) {
 
 void Event::execute(AbstractSimulator* simulator) 
 { 
-	std::cout << std::endl <<"Time is " << convertTime(simulator->now()) << "\n";
+	HPC_TRACE(simulator, TraceEvents, "\nTime is " << convertTime(simulator->now()) << "\n");
 }
 
 double Event::getTime() { return time; }
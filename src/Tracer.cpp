@@ -0,0 +1,122 @@
+#include "../include/Tracer.h"
+
+void StreamTraceSink::write(const char *characters, size_t count) {
+    out.write(characters, count);
+}
+
+void StreamTraceSink::flush() {
+    out.flush();
+}
+
+FileTraceSink::FileTraceSink(const std::string &filename) : file(filename, std::ios::binary) {
+}
+
+void FileTraceSink::write(const char *characters, size_t count) {
+    file.write(characters, count);
+}
+
+void FileTraceSink::flush() {
+    file.flush();
+}
+
+RingTraceSink::RingTraceSink(size_t capacity) : ring(capacity) {
+}
+
+void RingTraceSink::write(const char *characters, size_t count) {
+    if (ring.empty()) {
+        return;
+    }
+    // only the last characters can be kept
+    if (count >= ring.size()) {
+        characters += count - ring.size();
+        count = ring.size();
+    }
+    for (size_t i = 0; i < count; ++i) {
+        ring[next] = characters[i];
+        next++;
+        if (next == ring.size()) {
+            next = 0;
+            full = true;
+        }
+    }
+}
+
+std::string RingTraceSink::contents() const {
+    if (!full) {
+        return std::string(ring.begin(), ring.begin() + next);
+    }
+    return std::string(ring.begin() + next, ring.end()) + std::string(ring.begin(), ring.begin() + next);
+}
+
+TraceBuffer::TraceBuffer(TraceSink *sink, size_t capacity) : buffer(capacity), sink(sink) {
+    setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+void TraceBuffer::writeBuffer() {
+    if (pptr() > pbase()) {
+        sink->write(pbase(), pptr() - pbase());
+    }
+    setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+TraceBuffer::int_type TraceBuffer::overflow(int_type character) {
+    writeBuffer();
+    if (!traits_type::eq_int_type(character, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(character);
+        pbump(1);
+    }
+    return traits_type::not_eof(character);
+}
+
+int TraceBuffer::sync() {
+    writeBuffer();
+    sink->flush();
+    return 0;
+}
+
+void TraceBuffer::setSink(TraceSink *newSink) {
+    sync();
+    sink = newSink;
+}
+
+const size_t Tracer::bufferSize;
+
+Tracer::Tracer() : sink(new StreamTraceSink()), buffer(sink, bufferSize), out(&buffer) {
+}
+
+Tracer::~Tracer() {
+    flush();
+    delete sink;
+    delete binaryTrace;
+}
+
+void Tracer::setSink(TraceSink *newSink) {
+    buffer.setSink(newSink);
+    delete sink;
+    sink = newSink;
+}
+
+void Tracer::setBinaryTrace(BinaryTraceWriter *writer) {
+    delete binaryTrace;
+    binaryTrace = writer;
+}
+
+void Tracer::flush() {
+    out.flush();
+    if (binaryTrace != nullptr) {
+        binaryTrace->flush();
+    }
+}
+
+bool parseTraceLevel(const std::string &name, TraceLevel &level) {
+    if (name == "off") {
+        level = TraceOff;
+    } else if (name == "info") {
+        level = TraceInfo;
+    } else if (name == "events") {
+        level = TraceEvents;
+    } else {
+        return false;
+    }
+    return true;
+}
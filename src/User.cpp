@@ -1,70 +1,93 @@
+#include <algorithm>
 #include "../include/User.h"
 
-User::User() {
-    time = Random::exponential(meanTimeToNextJob);
-    userId = ++numOfUsers;
+User::User() : arrivalStream(Random::stream().nextSeed()), jobTypeStream(Random::stream().nextSeed()),
+               requirementsStream(Random::stream().nextSeed()) {
+    time = arrivalStream.exponential(meanTimeToNextJob);
 }
 
-User::User(double meanTimeBetweenTwoJobs) : meanTimeToNextJob(meanTimeBetweenTwoJobs) {
-    time = Random::exponential(meanTimeToNextJob);
-    userId = ++numOfUsers;
+User::User(double meanTimeBetweenTwoJobs) : meanTimeToNextJob(meanTimeBetweenTwoJobs),
+                                            arrivalStream(Random::stream().nextSeed()),
+                                            jobTypeStream(Random::stream().nextSeed()),
+                                            requirementsStream(Random::stream().nextSeed()) {
+    time = arrivalStream.exponential(meanTimeToNextJob);
 }
 
 User::User(double meanTimeBetweenToJobs, double firstJobTime) : meanTimeToNextJob(meanTimeBetweenToJobs),
-                                                                Event(firstJobTime) {
-    userId = ++numOfUsers;
+                                                                Event(firstJobTime),
+                                                                arrivalStream(Random::stream().nextSeed()),
+                                                                jobTypeStream(Random::stream().nextSeed()),
+                                                                requirementsStream(Random::stream().nextSeed()),
+                                                                firstJobTimeFixed(true) {
 }
 
-int User::numOfUsers = 0;
-
 /**
 Inspired by Generator
  A user is generating Jobs for the HPC
 */
 void User::execute(AbstractSimulator *simulator) {
     Event::execute(simulator);
-    AbstractJob *job = CreateRandomJob(permissions);
-    job->generateRandomRequirements();
+    AbstractJob *job = CreateRandomJob(permissions, jobTypeStream);
+    job->setId(dynamic_cast<HPCSimulator *>(simulator)->newJobId());
+    job->generateRandomRequirements(requirementsStream);
+    if (walltimeOverestimate > 1) {
+        job->setDeclaredWalltime(std::min(job->getExecutionDuration() * walltimeOverestimate, job->maxTime()));
+    }
+    if (scheduler->isSharingCores()) {
+        job->generateRandomCores(coresStream);
+    }
+    if (scheduler->isMoldingJobs()) {
+        job->generateRandomScaling(scalingStream);
+    }
+    if (scheduler->isModelingIo()) {
+        job->generateRandomIoIntensity(ioStream);
+    }
     if (currentlyUsedNumberOfNodes + job->getNumberOfNodes() <= instantaneousMaxNumberOfNodes) {
         // keep the simulator going until next planned job is too large
         //TODO assumption + GPU NODES
+        // the jobs sharing their nodes pay for the core-hours they use
         double jobCost;
         if (job->isGpuJob()) {
-            jobCost = job->getExecutionDuration() * HPCParameters::costOneHourOneGPUNode * job->getNumberOfNodes();
+            jobCost = job->getNodeHours() * HPCParameters::costOneHourOneGPUNode;
         } else {
-            jobCost = job->getExecutionDuration() * HPCParameters::costOneHourOneNode * job->getNumberOfNodes();
+            jobCost = job->getNodeHours() * HPCParameters::costOneHourOneNode;
         }
 
         if (budgetLeft() - jobCost >= 0) {
             job->setSubmittingTime(time);
             job->setUser(this);
+            HPC_TRACE_RECORD(simulator, job->traceRecord(RecordJobSubmit, time));
             job->insertIn(simulator, scheduler);// insert the job int the scheduler
 
             removeFromBudget(jobCost);
-            time += Random::exponential(meanTimeToNextJob);
+            time += arrivalStream.exponential(meanTimeToNextJob);
             simulator->insert(this);
             currentlyUsedNumberOfNodes += job->getNumberOfNodes();
 
-            std::cout << job->getType() << "job " << job->getId() << " submitted at time " << convertTime(time)
-                      << " by User " << userId
-                      << "\n";
-            std::cout << "Job " << job->getId() << " requires " << job->getNumberOfNodes() << " nodes\n";
-            std::cout << "User " << userId << " is using " << currentlyUsedNumberOfNodes << " out of "
-                      << instantaneousMaxNumberOfNodes << "\n"
-                      << " Budget left " << convertTime(budgetLeft()) << "\n";
+            HPC_TRACE(simulator, TraceEvents,
+                      job->getType() << "job " << job->getId() << " submitted at time " << convertTime(time)
+                                     << " by User " << userId << "\n"
+                                     << "Job " << job->getId() << " requires " << job->getNumberOfNodes()
+                                     << " nodes\n"
+                                     << "User " << userId << " is using " << currentlyUsedNumberOfNodes << " out of "
+                                     << instantaneousMaxNumberOfNodes << "\n"
+                                     << " Budget left " << convertTime(budgetLeft()) << "\n");
         } else {
-            std::cout << "User " << userId << " has not enough budget left for is next job. Budget left : "
-                      << budgetLeft() << " / Next Job : " << convertTime(job->getExecutionDuration()) << " on "
-                      << job->getNumberOfNodes()
-                      << " Nodes \n";
+            HPC_TRACE(simulator, TraceEvents,
+                      "User " << userId << " has not enough budget left for is next job. Budget left : "
+                              << budgetLeft() << " / Next Job : " << convertTime(job->getExecutionDuration())
+                              << " on " << job->getNumberOfNodes() << " Nodes \n");
+            delete job;
         }
     } else {
-        time += Random::exponential(12);
-        std::cout << "User " << userId << " has not enough instantaneous nodes for this job. \n"
-                  << "User will try to submit an other job at :" << convertTime(time) << ". \n"
-                  << "New Nodes required : " << job->getNumberOfNodes() << "/ currently used nodes :"
-                  << currentlyUsedNumberOfNodes << "/ max :" << instantaneousMaxNumberOfNodes << "\n"
-                  << " Budget left " << convertTime(budgetLeft()) << "\n";;
+        time += arrivalStream.exponential(12);
+        HPC_TRACE(simulator, TraceEvents,
+                  "User " << userId << " has not enough instantaneous nodes for this job. \n"
+                          << "User will try to submit an other job at :" << convertTime(time) << ". \n"
+                          << "New Nodes required : " << job->getNumberOfNodes() << "/ currently used nodes :"
+                          << currentlyUsedNumberOfNodes << "/ max :" << instantaneousMaxNumberOfNodes << "\n"
+                          << " Budget left " << convertTime(budgetLeft()) << "\n");
+        delete job;
 
         simulator->insert(this);
     }
@@ -79,6 +102,10 @@ int User::getUserId() const {
     return userId;
 }
 
+void User::setUserId(int id) {
+    userId = id;
+}
+
 void User::removeFromBudget(double amountToRemove) {
     budget -= amountToRemove;
 }
@@ -91,6 +118,19 @@ void User::setMeanTimeToNextJob(double meanTimeToNextJob) {
     User::meanTimeToNextJob = meanTimeToNextJob;
 }
 
+void User::seedRandomStreams(uint64_t masterSeed, uint64_t userNumber) {
+    uint64_t userSeed = RandomStream::substreamSeed(masterSeed, userNumber);
+    arrivalStream.seed(RandomStream::substreamSeed(userSeed, 0));
+    jobTypeStream.seed(RandomStream::substreamSeed(userSeed, 1));
+    requirementsStream.seed(RandomStream::substreamSeed(userSeed, 2));
+    coresStream.seed(RandomStream::substreamSeed(userSeed, 3));
+    scalingStream.seed(RandomStream::substreamSeed(userSeed, 4));
+    ioStream.seed(RandomStream::substreamSeed(userSeed, 5));
+    if (!firstJobTimeFixed) {
+        time = arrivalStream.exponential(meanTimeToNextJob);
+    }
+}
+
 void User::setPermission(bool small, bool medium, bool large, bool huge, bool gpu) {
     permissions[0] = small;
     permissions[1] = medium;
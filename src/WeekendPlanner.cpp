@@ -0,0 +1,98 @@
+#include <algorithm>
+#include "../include/WeekendPlanner.h"
+#include "../include/AbstractJob.h"
+
+std::vector<size_t> WeekendPlanner::knapsack(const std::vector<int> &sizes, const std::vector<double> &values,
+                                             int capacity) {
+    /* No more than capacity / size items of a given size can be selected, and then the most valuable ones.
+     * Only these items are kept, which bounds their number by the capacity whatever the number of candidates.
+     */
+    std::vector<size_t> items;
+    for (size_t item = 0; item < sizes.size(); ++item) {
+        if (sizes[item] <= capacity) {
+            items.push_back(item);
+        }
+    }
+    std::stable_sort(items.begin(), items.end(), [&sizes, &values](size_t i, size_t j) {
+        return sizes[i] < sizes[j] || (sizes[i] == sizes[j] && values[i] > values[j]);
+    });
+    std::vector<size_t> kept;
+    for (size_t first = 0, last; first < items.size(); first = last) {
+        int size = sizes[items[first]];
+        for (last = first; last < items.size() && sizes[items[last]] == size; ++last) {
+        }
+        size_t numberKept = size == 0 ? last - first : std::min(last - first, (size_t) (capacity / size));
+        kept.insert(kept.end(), items.begin() + first, items.begin() + first + numberKept);
+    }
+    std::sort(kept.begin(), kept.end());
+
+    std::vector<double> bestValue(capacity + 1, 0);
+    // taken[k * (capacity + 1) + c] : kept item k is part of the best selection of the items up to k for a capacity c
+    std::vector<bool> taken(kept.size() * (capacity + 1), false);
+    for (size_t k = 0; k < kept.size(); ++k) {
+        int size = sizes[kept[k]];
+        for (int c = capacity; c >= size; --c) {
+            if (bestValue[c - size] + values[kept[k]] > bestValue[c]) {
+                bestValue[c] = bestValue[c - size] + values[kept[k]];
+                taken[k * (capacity + 1) + c] = true;
+            }
+        }
+    }
+    std::vector<size_t> selection;
+    int c = capacity;
+    for (size_t k = kept.size(); k-- > 0;) {
+        if (taken[k * (capacity + 1) + c]) {
+            selection.push_back(kept[k]);
+            c -= sizes[kept[k]];
+        }
+    }
+    std::reverse(selection.begin(), selection.end());
+    return selection;
+}
+
+std::vector<AbstractJob *> WeekendPlanner::select(const std::vector<AbstractJob *> &hugeJobs,
+                                                  const std::vector<AbstractJob *> &otherJobs, int numberOfNodes,
+                                                  double hoursUntilMonday,
+                                                  const std::function<bool(AbstractJob *)> &fits) const {
+    std::vector<AbstractJob *> selection;
+    for (AbstractJob *job : hugeJobs) {
+        if (!mustStart(job)) {
+            continue;
+        }
+        if (job->getNumberOfNodes() > numberOfNodes || !fits(job)) {
+            // nothing else starts until the nodes it needs are free
+            return selection;
+        }
+        selection.push_back(job);
+        numberOfNodes -= job->getNumberOfNodes();
+    }
+
+    // the huge jobs are candidates before the other jobs
+    std::vector<AbstractJob *> candidates;
+    std::vector<int> sizes;
+    std::vector<double> nodeHours;
+    for (const std::vector<AbstractJob *> *jobs : {&hugeJobs, &otherJobs}) {
+        for (AbstractJob *job : *jobs) {
+            if ((jobs == &hugeJobs && mustStart(job)) || job->getWalltime() > hoursUntilMonday ||
+                job->getNumberOfNodes() > numberOfNodes || !fits(job)) {
+                continue;
+            }
+            candidates.push_back(job);
+            sizes.push_back(job->getNumberOfNodes());
+            nodeHours.push_back(job->getNumberOfNodes() * job->getWalltime());
+        }
+    }
+    for (size_t selected : knapsack(sizes, nodeHours, numberOfNodes)) {
+        selection.push_back(candidates[selected]);
+    }
+    return selection;
+}
+
+bool WeekendPlanner::mustStart(const AbstractJob *job) const {
+    return getSkippedWeekends(job) >= maxSkippedWeekends;
+}
+
+int WeekendPlanner::getSkippedWeekends(const AbstractJob *job) const {
+    auto skipped = skippedWeekends.find(job);
+    return skipped == skippedWeekends.end() ? 0 : skipped->second;
+}
@@ -1,17 +1,215 @@
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
 #include "../include/HPCSimulator.h"
+#include "../include/ReplicationDriver.h"
+#include "../include/random.h"
+
+/*
+ * Read a number of the command line made of digits only, at most maximum
+ */
+static bool parseNumber(const std::string &text, unsigned long long maximum, unsigned long long &value) {
+    if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    errno = 0;
+    value = std::strtoull(text.c_str(), nullptr, 10);
+    return errno == 0 && value <= maximum;
+}
 
 int main(int argc, char *argv[]) {
-    if (argc != 2) {
+    if (argc < 2) {
         cout << "You should provide the simulation programm with one argument : \n"
-                   <<"the path to the file with the scenario \n";
+                   <<"the path to the file with the scenario \n"
+                   <<"Options : \n"
+                   <<"  --event-queue list|heap|calendar   implementation of the event calendar (default heap)\n"
+                   <<"  --scheduler NAME                   scheduler of the platform (default fifo, or the one of the file)\n"
+                   <<"  --scheduler-param NAME=VALUE       parameter of the scheduler\n"
+                   <<"  --seed N                           seed of the random numbers, for reproducible runs\n"
+                   <<"  --replications N                   run N independent replications and print their statistics\n"
+                   <<"  --threads N                        number of threads running the replications (default all cores)\n"
+                   <<"  --trace-level off|info|events      what the simulation traces (default events)\n"
+                   <<"  --trace-file PATH                  write the trace to a file instead of the standard output\n"
+                   <<"  --trace-ring N                     keep only the last N characters of the trace and print them at the end\n"
+                   <<"  --binary-trace PATH                write the submission, start and end of the jobs in a binary file\n"
+                   <<"Schedulers : \n";
+        for (auto &description : SchedulerRegistry::descriptions()) {
+            cout << "  " << description.name << " : " << description.description << "\n";
+        }
         return 1;
     }
+    std::string eventQueueName = "heap";
+    std::string schedulerName;
+    std::vector<std::pair<std::string, std::string>> schedulerParameters;
+    bool seeded = false;
+    uint64_t seed = 0;
+    int replications = 0;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    TraceLevel traceLevel = TraceEvents;
+    std::string traceFile;
+    size_t traceRing = 0;
+    std::string binaryTraceFile;
+    std::string traceOption;
+    for (int i = 2; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--event-queue" && i + 1 < argc) {
+            eventQueueName = argv[++i];
+            OrderedSet *eventQueue = createEventQueue(eventQueueName);
+            if (eventQueue == nullptr) {
+                cout << "Unknown event queue : " << eventQueueName << "\n";
+                return 1;
+            }
+            delete eventQueue;
+        } else if (option == "--scheduler" && i + 1 < argc) {
+            schedulerName = argv[++i];
+            if (SchedulerRegistry::find(schedulerName) == nullptr) {
+                cout << "Unknown scheduler : " << schedulerName << "\n";
+                return 1;
+            }
+        } else if (option == "--scheduler-param" && i + 1 < argc) {
+            std::string parameter = argv[++i];
+            size_t equal = parameter.find('=');
+            if (equal == std::string::npos) {
+                cout << "A scheduler parameter is written NAME=VALUE : " << parameter << "\n";
+                return 1;
+            }
+            schedulerParameters.emplace_back(parameter.substr(0, equal), parameter.substr(equal + 1));
+        } else if (option == "--seed" && i + 1 < argc) {
+            unsigned long long value;
+            if (!parseNumber(argv[++i], ULLONG_MAX, value)) {
+                cout << "Invalid seed : " << argv[i] << "\n";
+                return 1;
+            }
+            seeded = true;
+            seed = value;
+            Random::seed(seed);
+        } else if (option == "--replications" && i + 1 < argc) {
+            unsigned long long value;
+            if (!parseNumber(argv[++i], INT_MAX, value) || value == 0) {
+                cout << "Invalid number of replications : " << argv[i] << "\n";
+                return 1;
+            }
+            replications = (int) value;
+        } else if (option == "--threads" && i + 1 < argc) {
+            unsigned long long value;
+            if (!parseNumber(argv[++i], INT_MAX, value) || value == 0) {
+                cout << "Invalid number of threads : " << argv[i] << "\n";
+                return 1;
+            }
+            threads = (int) value;
+        } else if (option == "--trace-level" && i + 1 < argc) {
+            std::string levelName = argv[++i];
+            if (!parseTraceLevel(levelName, traceLevel)) {
+                cout << "Unknown trace level : " << levelName << "\n";
+                return 1;
+            }
+            if (traceLevel != TraceOff) {
+                traceOption = option;
+            }
+        } else if (option == "--trace-file" && i + 1 < argc) {
+            traceOption = option;
+            traceFile = argv[++i];
+        } else if (option == "--trace-ring" && i + 1 < argc) {
+            traceOption = option;
+            unsigned long long value;
+            if (!parseNumber(argv[++i], SIZE_MAX, value) || value == 0) {
+                cout << "Invalid size of the trace ring : " << argv[i] << "\n";
+                return 1;
+            }
+            traceRing = value;
+        } else if (option == "--binary-trace" && i + 1 < argc) {
+            traceOption = option;
+            binaryTraceFile = argv[++i];
+        } else {
+            cout << "Unknown option : " << option << "\n";
+            return 1;
+        }
+    }
+    if (!std::ifstream(argv[1])) {
+        cout << "Unable to open the scenario file : " << argv[1] << "\n";
+        return 1;
+    }
+    if (replications > 0) {
+        // the replications run without tracing
+        if (!traceOption.empty()) {
+            cout << "The option " << traceOption << " can not be used with --replications\n";
+            return 1;
+        }
+        if (!seeded) {
+            seed = Random::stream().nextSeed();
+        }
+        cout << " Running " << replications << " replications on " << threads << " threads with master seed "
+             << seed << std::endl;
+        ReplicationDriver driver(argv[1], seed, replications, threads);
+        driver.setEventQueueName(eventQueueName);
+        driver.setSchedulerName(schedulerName);
+        for (auto &parameter : schedulerParameters) {
+            driver.setSchedulerParameter(parameter.first, parameter.second);
+        }
+        std::string error;
+        if (!driver.checkScheduler(error)) {
+            cout << error << "\n";
+            return 1;
+        }
+        driver.run();
+        driver.printSummary();
+        return 0;
+    }
     cout << " HPC simulator initialisation" << std::endl;
     HPCSimulator hpcSimulator;
-    hpcSimulator.initialisation("../data/InputDataExample.txt");
+    hpcSimulator.setEventQueueName(eventQueueName);
+    hpcSimulator.getTracer().setLevel(traceLevel);
+    RingTraceSink *ringSink = nullptr;
+    if (traceRing > 0) {
+        ringSink = new RingTraceSink(traceRing);
+        hpcSimulator.getTracer().setSink(ringSink);
+    } else if (!traceFile.empty()) {
+        auto *fileSink = new FileTraceSink(traceFile);
+        if (!fileSink->isOpen()) {
+            cout << "Unable to open the trace file : " << traceFile << "\n";
+            delete fileSink;
+            return 1;
+        }
+        hpcSimulator.getTracer().setSink(fileSink);
+    }
+    if (!binaryTraceFile.empty()) {
+        auto *binaryTrace = new BinaryTraceWriter(binaryTraceFile);
+        if (!binaryTrace->isOpen()) {
+            cout << "Unable to open the binary trace file : " << binaryTraceFile << "\n";
+            delete binaryTrace;
+            return 1;
+        }
+        hpcSimulator.getTracer().setBinaryTrace(binaryTrace);
+    }
+    if (seeded) {
+        hpcSimulator.setSeed(seed);
+    }
+    hpcSimulator.initialisation(argv[1]);
+    if (!hpcSimulator.getInputError().empty()) {
+        cout << hpcSimulator.getInputError() << "\n";
+        return 1;
+    }
+    if (!schedulerName.empty()) {
+        hpcSimulator.setSchedulerName(schedulerName);
+    }
+    for (auto &parameter : schedulerParameters) {
+        hpcSimulator.setSchedulerParameter(parameter.first, parameter.second);
+    }
+    std::string error;
+    if (!SchedulerRegistry::check(hpcSimulator.getSchedulerName(), hpcSimulator.getSchedulerParameters(), error)) {
+        cout << error << "\n";
+        return 1;
+    }
     cout << " Starting" << std::endl;
     hpcSimulator.start();
     hpcSimulator.printResults();
+    if (ringSink != nullptr) {
+        cout << "\n============= END OF TRACE =============\n" << ringSink->contents();
+    }
     return 0;
 }
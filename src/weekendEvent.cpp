@@ -7,7 +7,8 @@
 void WeekendBegin::execute(AbstractSimulator *simulator) {
     Event::execute(simulator);
 
-    std::cout << "Weekend Start" << std::endl;
+    HPC_TRACE(simulator, TraceInfo, "Weekend Start\n");
+    HPC_TRACE_RECORD(simulator, BinaryTraceRecord::event(RecordWeekendBegin, time));
     if (simulator->eventsSize() > 1 || scheduler->totalOfNonHugeJobsWaiting() > 0) {
         time += numberOfHoursInAWeek;
         simulator->insert(this);
@@ -22,7 +23,8 @@ WeekendBegin::WeekendBegin(AbstractScheduler *scheduler) : scheduler(scheduler)
 
 void WeekendEnd::execute(AbstractSimulator *simulator) {
     Event::execute(simulator);
-    std::cout << "Weekend End" << std::endl;
+    HPC_TRACE(simulator, TraceInfo, "Weekend End\n");
+    HPC_TRACE_RECORD(simulator, BinaryTraceRecord::event(RecordWeekendEnd, time));
     scheduler->tryToExecuteNextJobs(simulator);
     if (simulator->eventsSize() > 1) {
         time += numberOfHoursInAWeek;
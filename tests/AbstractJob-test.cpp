@@ -0,0 +1,23 @@
+#include "catch.hpp"
+#include "../include/AbstractJob.h"
+
+TEST_CASE("test moldable jobs scale their durations according to Amdahl's law", "[job]") {
+    LargeJob job;
+    job.setNumberOfNodes(40).setExecutionDuration(10);
+    REQUIRE(!job.isMoldable());
+
+    job.setMoldable(20, 0.1);
+    REQUIRE(job.isMoldable());
+    REQUIRE(job.getWalltimeOn(40) == Approx(10));
+    // on half the nodes only the parallel part of the job is twice as long
+    double walltimeOnHalf = 10 * (0.1 + 0.9 / 20) / (0.1 + 0.9 / 40);
+    REQUIRE(job.getWalltimeOn(20) == Approx(walltimeOnHalf));
+
+    job.setDeclaredWalltime(12);
+    job.mold(20);
+    REQUIRE(!job.isMoldable());
+    REQUIRE(job.getNumberOfNodes() == 20);
+    REQUIRE(job.getExecutionDuration() == Approx(walltimeOnHalf));
+    REQUIRE(job.getRemainingDuration() == Approx(walltimeOnHalf));
+    REQUIRE(job.getWalltime() == Approx(1.2 * walltimeOnHalf));
+}
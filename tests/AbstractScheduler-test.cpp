@@ -0,0 +1,369 @@
+#include "catch.hpp"
+#include "TestPlatform.h"
+#include "../include/weekendEvent.h"
+#include "../include/JobCompletion.h"
+#include "../include/ReservationEvent.h"
+#include "../include/PartitionController.h"
+
+// the simulation starts on monday 9 AM, the week-end begins on friday 5 PM, 104 hours later
+
+TEST_CASE("test the hours left before the week-end", "[abstractScheduler]") {
+    REQUIRE(hoursUntilNextWeekend(0) == 104);
+    REQUIRE(hoursUntilNextWeekend(96) == 8);
+    REQUIRE(hoursUntilNextWeekend(104) == 0);
+    REQUIRE(!isDuringWeekend(104));
+    REQUIRE(isDuringWeekend(110));
+    REQUIRE(hoursUntilNextWeekend(110) == 0);
+    REQUIRE(hoursUntilNextWeekend(168 + 96) == 8);
+}
+
+TEST_CASE("test a job ending at the week-end cut-off starts on friday 4:59 PM", "[abstractScheduler]") {
+    TestPlatform platform(new Scheduler(), 4);
+    WeekendEnd weekendEnd(platform.scheduler);
+    platform.insert(&weekendEnd);
+    double fridayAt1659 = 103 + 59.0 / 60;
+    platform.runUntil(fridayAt1659);
+    auto *oneMinute = platform.submit<MediumJob>(1, 1.0 / 60);
+    auto *twoMinutes = platform.submit<MediumJob>(1, 2.0 / 60);
+    REQUIRE(oneMinute->getStartTime() == fridayAt1659);
+    REQUIRE(twoMinutes->getStartTime() == -1);
+    platform.runUntil(168);
+    REQUIRE(twoMinutes->getStartTime() == 168);
+}
+
+TEST_CASE("test a job longer than the hours left on friday morning waits for monday", "[abstractScheduler]") {
+    TestPlatform platform(new Scheduler(), 4);
+    WeekendEnd weekendEnd(platform.scheduler);
+    platform.insert(&weekendEnd);
+    // friday 9 AM, 8 hours before the week-end
+    platform.runUntil(96);
+    auto *nineHours = platform.submit<LargeJob>(2, 9);
+    REQUIRE(nineHours->getStartTime() == -1);
+    platform.runUntil(168);
+    REQUIRE(nineHours->getStartTime() == 168);
+
+    TestPlatform otherPlatform(new Scheduler(), 4);
+    otherPlatform.runUntil(96);
+    auto *eightHours = otherPlatform.submit<LargeJob>(2, 8);
+    REQUIRE(eightHours->getStartTime() == 96);
+}
+
+TEST_CASE("test no job starts during the week-end", "[abstractScheduler]") {
+    TestPlatform platform(new Scheduler(), 4);
+    WeekendEnd weekendEnd(platform.scheduler);
+    platform.insert(&weekendEnd);
+    platform.runUntil(110);
+    auto *oneMinute = platform.submit<SmallJob>(1, 1.0 / 60);
+    REQUIRE(oneMinute->getStartTime() == -1);
+    platform.runUntil(168);
+    REQUIRE(oneMinute->getStartTime() == 168);
+}
+
+TEST_CASE("test the jobs checkpointed for a huge job make enough room for it", "[abstractScheduler]") {
+    TestPlatform platform(new Scheduler(), 4);
+    platform.scheduler->enablePreemption(0.5);
+    WeekendBegin weekendBegin(platform.scheduler);
+    platform.insert(&weekendBegin);
+    // with preemption the jobs may run into the week-end
+    auto *first = platform.submit<LargeJob>(1, 200);
+    platform.runUntil(1);
+    auto *second = platform.submit<LargeJob>(1, 200);
+    platform.runUntil(2);
+    // the free nodes are enough once the job ending last is checkpointed
+    auto *hugeJob = platform.submit<HugeJob>(3, 10);
+    REQUIRE(hugeJob->getStartTime() == -1);
+
+    platform.runUntil(104);
+    REQUIRE(hugeJob->getStartTime() == 104);
+    REQUIRE(first->getNumberOfCheckpoints() == 0);
+    REQUIRE(second->getNumberOfCheckpoints() == 1);
+}
+
+TEST_CASE("test the jobs sharing a node are all checkpointed to free it for a huge job", "[abstractScheduler]") {
+    TestPlatform platform(new Scheduler(), 2);
+    platform.scheduler->enableCoreSharing();
+    platform.scheduler->enablePreemption(0.5);
+    WeekendBegin weekendBegin(platform.scheduler);
+    platform.insert(&weekendBegin);
+    auto *first = platform.submit<SmallJob>(1, 200, nullptr, 0, 4);
+    auto *second = platform.submit<SmallJob>(1, 200, nullptr, 0, 4);
+    REQUIRE(first->getCompletion()->getNodes()[0] == platform.getNode(0));
+    REQUIRE(second->getCompletion()->getNodes()[0] == platform.getNode(0));
+    platform.runUntil(1);
+    auto *hugeJob = platform.submit<HugeJob>(2, 10);
+
+    platform.runUntil(104);
+    REQUIRE(hugeJob->getStartTime() == 104);
+    REQUIRE(first->getNumberOfCheckpoints() == 1);
+    REQUIRE(second->getNumberOfCheckpoints() == 1);
+}
+
+TEST_CASE("test no job is checkpointed for a huge job the week-end planner would not start", "[abstractScheduler]") {
+    TestPlatform platform(new Scheduler(), 4);
+    platform.scheduler->enablePreemption(0.5);
+    platform.scheduler->setWeekendPlanner(new WeekendPlanner(2));
+    WeekendBegin weekendBegin(platform.scheduler);
+    platform.insert(&weekendBegin);
+    auto *running = platform.submit<LargeJob>(2, 200);
+    platform.runUntil(1);
+    // would not end before monday morning
+    auto *longHugeJob = platform.submit<HugeJob>(3, 100);
+
+    platform.runUntil(104);
+    REQUIRE(longHugeJob->getStartTime() == -1);
+    REQUIRE(running->getNumberOfCheckpoints() == 0);
+}
+
+TEST_CASE("test a moldable job starts on the free nodes when it completes sooner", "[abstractScheduler]") {
+    TestPlatform platform(new Scheduler(), 4);
+    platform.scheduler->enableMolding();
+    platform.submit<LargeJob>(2, 100);
+    platform.runUntil(1);
+    // 8 hours on its 4 nodes, 16 hours on the 2 free nodes : better than waiting 99 hours for the 2 others
+    auto *moldable = platform.submit<LargeJob>(4, 8);
+    moldable->setMoldable(2, 0);
+    platform.scheduler->tryToExecuteNextJobs(&platform);
+    REQUIRE(moldable->getStartTime() == 1);
+    REQUIRE(moldable->getNumberOfNodes() == 2);
+    REQUIRE(moldable->getCompletion()->getTime() == 17);
+}
+
+TEST_CASE("test a moldable job waits for more nodes when it completes sooner", "[abstractScheduler]") {
+    TestPlatform platform(new Scheduler(), 4);
+    platform.scheduler->enableMolding();
+    platform.submit<LargeJob>(2, 2);
+    platform.runUntil(1);
+    // on the 4 nodes free at time 2 it completes at time 10 instead of 17
+    auto *moldable = platform.submit<LargeJob>(4, 8);
+    moldable->setMoldable(2, 0);
+    platform.scheduler->tryToExecuteNextJobs(&platform);
+    REQUIRE(moldable->getStartTime() == -1);
+    platform.runUntil(2);
+    REQUIRE(moldable->getStartTime() == 2);
+    REQUIRE(moldable->getNumberOfNodes() == 4);
+}
+
+TEST_CASE("test a moldable job is not started on fewer nodes if it would run into the week-end",
+          "[abstractScheduler]") {
+    TestPlatform platform(new Scheduler(), 4);
+    platform.scheduler->enableMolding();
+    WeekendEnd weekendEnd(platform.scheduler);
+    platform.insert(&weekendEnd);
+    platform.runUntil(90);
+    platform.submit<LargeJob>(2, 13);
+    platform.runUntil(91);
+    // 13 hours are left, it ends in time on its 4 nodes but would need 16 hours on the 2 free nodes
+    auto *moldable = platform.submit<LargeJob>(4, 8);
+    moldable->setMoldable(2, 0);
+    platform.scheduler->tryToExecuteNextJobs(&platform);
+    REQUIRE(moldable->getStartTime() == -1);
+    // once the 4 nodes are free it is too late
+    platform.runUntil(103);
+    REQUIRE(moldable->getStartTime() == -1);
+    platform.runUntil(168);
+    REQUIRE(moldable->getStartTime() == 168);
+    REQUIRE(moldable->getNumberOfNodes() == 4);
+}
+
+TEST_CASE("test a job spread over several racks runs slower", "[abstractScheduler]") {
+    // racks of 4 nodes, the nodes are allocated by increasing id
+    TestPlatform platform(new Scheduler(), 16);
+    platform.scheduler->setTopology(4, 0.05, false);
+    // nodes 0 and 1
+    auto *oneRack = platform.submit<LargeJob>(2, 10);
+    // nodes 2 to 5
+    auto *twoRacks = platform.submit<LargeJob>(4, 10);
+    // nodes 6 to 12
+    auto *threeRacks = platform.submit<LargeJob>(7, 10);
+    REQUIRE(oneRack->getCompletion()->getTime() == 10);
+    REQUIRE(twoRacks->getCompletion()->getTime() == Approx(10.5));
+    REQUIRE(threeRacks->getCompletion()->getTime() == Approx(11));
+    REQUIRE(threeRacks->getExecutionDuration() == Approx(11));
+}
+
+TEST_CASE("test the compact placement keeps the jobs in a single rack", "[abstractScheduler]") {
+    TestPlatform platform(new Scheduler(), 8);
+    platform.scheduler->setTopology(4, 0.05, true);
+    auto *small = platform.submit<LargeJob>(2, 10);
+    // the first rack only has 2 free nodes left, the job is given the second one
+    auto *fullRack = platform.submit<LargeJob>(4, 10);
+    REQUIRE(small->getCompletion()->getTime() == 10);
+    REQUIRE(fullRack->getCompletion()->getTime() == 10);
+    for (Node *node : fullRack->getCompletion()->getNodes()) {
+        REQUIRE(node->getId() >= 4);
+    }
+}
+
+TEST_CASE("test a job which would run into a reservation waits instead of being checkpointed",
+          "[abstractScheduler]") {
+    TestPlatform platform(new Scheduler(), 4);
+    platform.scheduler->enablePreemption(0.5);
+    Reservation reservation{10, 20, 0, 1};
+    auto *calendar = new ReservationCalendar();
+    calendar->add(reservation);
+    platform.scheduler->setReservationCalendar(calendar);
+    ReservationBegin reservationBegin(platform.scheduler, reservation);
+    ReservationEnd reservationEnd(platform.scheduler, reservation);
+    platform.insert(&reservationBegin);
+    platform.insert(&reservationEnd);
+
+    // ends before the reservation begins, on the reserved nodes
+    auto *shortJob = platform.submit<LargeJob>(1, 5);
+    REQUIRE(shortJob->getStartTime() == 0);
+    REQUIRE(shortJob->getCompletion()->getNodes()[0]->getId() == 0);
+    // the 2 nodes which are not reserved are free
+    auto *longJob = platform.submit<LargeJob>(2, 25);
+    REQUIRE(longJob->getStartTime() == 0);
+    for (Node *node : longJob->getCompletion()->getNodes()) {
+        REQUIRE(node->getId() >= 2);
+    }
+    platform.runUntil(1);
+    auto *waiting = platform.submit<LargeJob>(2, 15);
+    REQUIRE(waiting->getStartTime() == -1);
+    // the 2 free nodes are reserved before it would end
+    platform.runUntil(5);
+    REQUIRE(waiting->getStartTime() == -1);
+
+    platform.runUntil(20);
+    REQUIRE(waiting->getStartTime() == 20);
+    REQUIRE(waiting->getNumberOfCheckpoints() == 0);
+    REQUIRE(longJob->getNumberOfCheckpoints() == 0);
+}
+
+TEST_CASE("test the jobs on the nodes of a reservation are only checkpointed with preemption",
+          "[abstractScheduler]") {
+    for (bool preemption : {false, true}) {
+        TestPlatform platform(new Scheduler(), 4);
+        if (preemption) {
+            platform.scheduler->enablePreemption(0.5);
+        }
+        // the job started before the reservation was booked
+        auto *running = platform.submit<LargeJob>(4, 30);
+        REQUIRE(running->getStartTime() == 0);
+        Reservation reservation{10, 20, 0, 1};
+        auto *calendar = new ReservationCalendar();
+        calendar->add(reservation);
+        platform.scheduler->setReservationCalendar(calendar);
+        ReservationBegin reservationBegin(platform.scheduler, reservation);
+        ReservationEnd reservationEnd(platform.scheduler, reservation);
+        platform.insert(&reservationBegin);
+        platform.insert(&reservationEnd);
+
+        platform.runUntil(11);
+        REQUIRE(running->getNumberOfCheckpoints() == (preemption ? 1 : 0));
+        if (!preemption) {
+            REQUIRE(running->getCompletion()->getTime() == 30);
+        }
+    }
+}
+
+TEST_CASE("test the nodes the next job can not use before the week-end are filled on friday afternoon",
+          "[abstractScheduler]") {
+    TestPlatform platform(new Scheduler(), 4);
+    WeekendEnd weekendEnd(platform.scheduler);
+    platform.insert(&weekendEnd);
+    platform.runUntil(90);
+    platform.submit<LargeJob>(2, 10);
+    // friday 2:30 PM, would end after the week-end cut-off once the running job completes
+    platform.runUntil(97.5);
+    auto *blocked = platform.submit<LargeJob>(4, 8);
+    platform.runUntil(98);
+    auto *filler = platform.submit<LargeJob>(3, 4);
+    auto *tooLong = platform.submit<LargeJob>(1, 5);
+    auto *shortJob = platform.submit<MediumJob>(1, 3);
+    REQUIRE(filler->getStartTime() == -1);
+    REQUIRE(shortJob->getStartTime() == -1);
+
+    // the 4 hours left are filled by the longest job fitting, then by the short job on the last node
+    platform.runUntil(100);
+    REQUIRE(filler->getStartTime() == 100);
+    REQUIRE(shortJob->getStartTime() == 100);
+    REQUIRE(tooLong->getStartTime() == -1);
+    REQUIRE(blocked->getStartTime() == -1);
+    platform.runUntil(168);
+    REQUIRE(blocked->getStartTime() == 168);
+}
+
+TEST_CASE("test a gpu job is not used to fill the nodes while the next gpu job ends before the week-end",
+          "[abstractScheduler]") {
+    // the next gpu job needs the 2 gpu nodes, the second one is free at 101
+    for (double nextJobWalltime : {3.0, 5.0}) {
+        TestPlatform platform(new Scheduler(), 0, 0, 0, 2);
+        WeekendEnd weekendEnd(platform.scheduler);
+        platform.insert(&weekendEnd);
+        platform.runUntil(90);
+        platform.submit<GpuJob>(1, 10);
+        platform.submit<GpuJob>(1, 11);
+        platform.runUntil(99);
+        auto *nextGpuJob = platform.submit<GpuJob>(2, nextJobWalltime);
+        // would delay the next gpu job until 102
+        auto *filler = platform.submit<GpuJob>(1, 2);
+
+        platform.runUntil(101);
+        if (nextJobWalltime == 3) {
+            REQUIRE(filler->getStartTime() == -1);
+            REQUIRE(nextGpuJob->getStartTime() == 101);
+        } else {
+            // the next gpu job can not end before the cut-off anyway
+            REQUIRE(filler->getStartTime() == 100);
+            REQUIRE(nextGpuJob->getStartTime() == -1);
+        }
+    }
+}
+
+TEST_CASE("test the free nodes of the small partition are lent to a waiting large job and taken back",
+          "[abstractScheduler]") {
+    // nodes 0 and 1 are reserved for small jobs, 2 to 4 are normal nodes
+    TestPlatform platform(new Scheduler(), 3, 0, 2);
+    platform.scheduler->setPartitionController(new PartitionController(1, 0, 2, 0, 0));
+    platform.submit<LargeJob>(2, 10);
+    auto *smallJob = platform.submit<SmallJob>(1, 2);
+    REQUIRE(smallJob->getCompletion()->getNodes()[0]->getNodeClass() == SmallNodeClass);
+    platform.runUntil(1);
+    auto *largeJob = platform.submit<LargeJob>(3, 5);
+    REQUIRE(largeJob->getStartTime() == -1);
+
+    // the large job waits longer than the small jobs when the small job completes
+    platform.runUntil(2);
+    REQUIRE(platform.getNode(0)->getNodeClass() == NormalNodeClass);
+    REQUIRE(platform.getNode(1)->getNodeClass() == NormalNodeClass);
+    REQUIRE(largeJob->getStartTime() == 2);
+
+    platform.runUntil(3);
+    // the next job, it never fits on the normal nodes
+    platform.submit<MediumJob>(5, 1);
+    platform.runUntil(4);
+    // not the next job, it may only use the small partition
+    auto *waitingSmallJob = platform.submit<SmallJob>(1, 1);
+    REQUIRE(waitingSmallJob->getStartTime() == -1);
+
+    // no large job waits any more when the nodes of the large job are freed
+    platform.runUntil(7);
+    REQUIRE(waitingSmallJob->getStartTime() == 7);
+    REQUIRE(waitingSmallJob->getCompletion()->getNodes()[0]->getNodeClass() == SmallNodeClass);
+    int numberOfSmallNodes = 0;
+    for (int id = 0; id < 5; ++id) {
+        if (platform.getNode(id)->getNodeClass() == SmallNodeClass) {
+            ++numberOfSmallNodes;
+        }
+    }
+    REQUIRE(numberOfSmallNodes == 2);
+}
+
+TEST_CASE("test the completion of a job doing I/O moves with the other jobs doing I/O", "[abstractScheduler]") {
+    TestPlatform platform(new Scheduler(), 20);
+    platform.scheduler->setFilesystemBandwidth(4);
+    // alone, it uses the whole bandwidth
+    auto *first = platform.submit<LargeJob>(10, 10, nullptr, 0.4);
+    REQUIRE(first->getCompletion()->getTime() == Approx(10));
+    platform.runUntil(2);
+    // both jobs do their I/O 1.5 times slower
+    auto *second = platform.submit<LargeJob>(10, 5, nullptr, 0.2);
+    REQUIRE(first->getCompletion()->getTime() == Approx(2 + 8 * 1.2));
+    REQUIRE(second->getCompletion()->getTime() == Approx(2 + 5 * 1.1));
+
+    // the first job runs at full speed again once the second one is done
+    platform.runUntil(7.5);
+    REQUIRE(second->getCompletionTime() == Approx(7.5));
+    REQUIRE(first->getCompletion()->getTime() == Approx(7.5 + 8 - 5.5 / 1.2));
+}
@@ -0,0 +1,38 @@
+#include <limits>
+#include "catch.hpp"
+#include "../include/AvailabilityProfile.h"
+
+TEST_CASE("test the profile keeps the free nodes of each class over time", "[availabilityProfile]") {
+    const double infinity = std::numeric_limits<double>::infinity();
+    AvailabilityProfile profile;
+    profile.add(0, infinity, NormalNodeClass, 10);
+    profile.add(0, infinity, GpuNodeClass, 2);
+    // a running job frees 6 normal nodes at time 5
+    profile.add(0, 5, NormalNodeClass, -6);
+    REQUIRE(profile.freeAt(0, NormalNodeClass) == 4);
+    REQUIRE(profile.freeAt(5, NormalNodeClass) == 10);
+    REQUIRE(profile.size() == 2);
+
+    NodeCounts nodes{};
+    REQUIRE(profile.earliestFit(0, 3, 4, {NormalNodeClass}, nodes) == 0);
+    REQUIRE(profile.earliestFit(0, 3, 5, {NormalNodeClass}, nodes) == 5);
+    REQUIRE(nodes[NormalNodeClass] == 5);
+    // the gpu nodes make the job fit now, they are taken last
+    REQUIRE(profile.earliestFit(0, 3, 5, {NormalNodeClass, GpuNodeClass}, nodes) == 0);
+    REQUIRE(nodes[NormalNodeClass] == 4);
+    REQUIRE(nodes[GpuNodeClass] == 1);
+
+    profile.reserve(0, 3, nodes);
+    REQUIRE(profile.freeAt(1, NormalNodeClass) == 0);
+    REQUIRE(profile.freeAt(1, GpuNodeClass) == 1);
+    REQUIRE(profile.freeAt(3, NormalNodeClass) == 4);
+    // a job of 4 nodes lasting 4 hours fits between 3 and 5 only if it does not last past 5
+    REQUIRE(profile.earliestFit(0, 2, 4, {NormalNodeClass}, nodes) == 3);
+    REQUIRE(profile.earliestFit(0, 4, 8, {NormalNodeClass}, nodes) == 5);
+
+    profile.advanceTo(4);
+    REQUIRE(profile.freeAt(4, NormalNodeClass) == 4);
+    REQUIRE(profile.freeAt(0, NormalNodeClass) == 0);
+    REQUIRE(profile.size() == 2);
+    REQUIRE(profile.earliestFit(0, 1, 13, {NormalNodeClass, GpuNodeClass}, nodes) == infinity);
+}
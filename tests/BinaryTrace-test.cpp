@@ -0,0 +1,36 @@
+#include "catch.hpp"
+#include <cstdio>
+#include "../include/BinaryTrace.h"
+
+TEST_CASE("test the binary trace records can be read back", "[binaryTrace]") {
+    std::string filename = "BinaryTrace-test.bin";
+    size_t numberOfRecords = BinaryTraceWriter::bufferedRecords + 10;
+    {
+        BinaryTraceWriter writer(filename);
+        REQUIRE(writer.isOpen());
+        for (size_t i = 0; i < numberOfRecords; ++i) {
+            BinaryTraceRecord record = BinaryTraceRecord::event(RecordWeekendBegin, i * 0.5);
+            record.jobId = i;
+            writer.write(record);
+        }
+    }
+    BinaryTraceReader reader(filename);
+    REQUIRE(reader.isValid());
+    BinaryTraceRecord record{};
+    size_t numberOfRecordsRead = 0;
+    while (reader.read(record)) {
+        REQUIRE(record.kind == RecordWeekendBegin);
+        REQUIRE(record.time == numberOfRecordsRead * 0.5);
+        REQUIRE(record.jobId == (int32_t) numberOfRecordsRead);
+        REQUIRE(record.nodeId == -1);
+        numberOfRecordsRead++;
+    }
+    REQUIRE(numberOfRecordsRead == numberOfRecords);
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("test a file which is not a binary trace is rejected", "[binaryTrace]") {
+    REQUIRE_FALSE(BinaryTraceReader("BinaryTrace-test-missing.bin").isValid());
+    REQUIRE(std::string(recordKindName(RecordNodeFree)) == "node_free");
+    REQUIRE(std::string(recordKindName(42)) == "unknown");
+}
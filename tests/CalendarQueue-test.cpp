@@ -0,0 +1,51 @@
+#include <random>
+#include "catch.hpp"
+#include "../include/CalendarQueue.h"
+#include "../include/ListQueue.h"
+
+TEST_CASE("test calendar queue returns events by increasing time", "[calendarqueue]") {
+    CalendarQueue queue;
+    std::vector<Event *> events;
+    for (double time : {500.0, 1.0, 168.0, 2.5, 3.0, 10000.0}) {
+        events.push_back(new Event(time));
+        queue.insert(events.back());
+    }
+    REQUIRE(queue.size() == 6);
+    for (double time : {1.0, 2.5, 3.0, 168.0, 500.0, 10000.0}) {
+        REQUIRE(((Event *) queue.removeFirst())->getTime() == time);
+    }
+    REQUIRE(queue.removeFirst() == nullptr);
+    for (auto &event : events) {
+        delete event;
+    }
+}
+
+TEST_CASE("test calendar queue orders events as the list queue while resizing", "[calendarqueue]") {
+    CalendarQueue calendarQueue;
+    ListQueue listQueue;
+    std::mt19937 generator(7);
+    std::exponential_distribution<double> increment(0.5);
+    std::vector<Event *> events;
+    double now = 0;
+    // the queue grows then shrinks so that the calendar is resized both ways
+    for (int i = 0; i < 2000; ++i) {
+        double time = (i % 5 == 0) ? std::floor(now) + 168 : now + increment(generator);
+        events.push_back(new Event(time));
+        calendarQueue.insert(events.back());
+        listQueue.insert(events.back());
+        if (i % 3 == 0) {
+            Comparable *first = listQueue.removeFirst();
+            REQUIRE(calendarQueue.removeFirst() == first);
+            now = ((Event *) first)->getTime();
+        }
+    }
+    REQUIRE(calendarQueue.remove(events[1999]) == listQueue.remove(events[1999]));
+    REQUIRE(calendarQueue.size() == listQueue.size());
+    while (listQueue.size() > 0) {
+        REQUIRE(calendarQueue.removeFirst() == listQueue.removeFirst());
+    }
+    REQUIRE(calendarQueue.size() == 0);
+    for (auto &event : events) {
+        delete event;
+    }
+}
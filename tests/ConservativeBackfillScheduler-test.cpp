@@ -0,0 +1,183 @@
+#include "catch.hpp"
+#include "TestPlatform.h"
+#include "../include/ConservativeBackfillScheduler.h"
+#include "../include/JobCompletion.h"
+#include "../include/PartitionController.h"
+#include "../include/ReservationEvent.h"
+#include "../include/weekendEvent.h"
+#include "../include/WeekendPlanner.h"
+
+// the jobs are submitted one hour apart, each one is reserved nodes after the jobs submitted before it
+
+TEST_CASE("test a short job is backfilled without delaying the jobs submitted before it",
+          "[conservativeBackfillScheduler]") {
+    TestPlatform platform(new ConservativeBackfillScheduler(), 4);
+    auto *running = platform.submit<LargeJob>(3, 10);
+    platform.runUntil(1);
+    // reserved the four nodes when the running job completes
+    auto *next = platform.submit<LargeJob>(4, 5);
+    platform.runUntil(2);
+    // ends before the reservation of the next job
+    auto *shortJob = platform.submit<MediumJob>(1, 5);
+    platform.runUntil(3);
+    // would still run at time 10, it is reserved a node once the next job completes
+    auto *longJob = platform.submit<LargeJob>(1, 20);
+    REQUIRE(running->getStartTime() == 0);
+    REQUIRE(next->getStartTime() == -1);
+    REQUIRE(shortJob->getStartTime() == 2);
+    REQUIRE(longJob->getStartTime() == -1);
+
+    platform.runUntil(10);
+    REQUIRE(shortJob->getCompletionTime() == 7);
+    REQUIRE(next->getStartTime() == 10);
+    REQUIRE(longJob->getStartTime() == -1);
+    platform.runUntil(15);
+    REQUIRE(longJob->getStartTime() == 15);
+}
+
+TEST_CASE("test a job whose nodes are not all free at its reservation waits for them",
+          "[conservativeBackfillScheduler]") {
+    TestPlatform platform(new ConservativeBackfillScheduler(), 4);
+    platform.submit<LargeJob>(4, 10);
+    platform.runUntil(1);
+    auto *next = platform.submit<LargeJob>(4, 5);
+    // node 0 is booked after the reservation of the next job was made, before it would complete
+    Reservation reservation{12, 20, 0, 0};
+    auto *calendar = new ReservationCalendar();
+    calendar->add(reservation);
+    platform.scheduler->setReservationCalendar(calendar);
+    ReservationBegin reservationBegin(platform.scheduler, reservation);
+    ReservationEnd reservationEnd(platform.scheduler, reservation);
+    platform.insert(&reservationBegin);
+    platform.insert(&reservationEnd);
+
+    platform.runUntil(10);
+    REQUIRE(next->getStartTime() == -1);
+    platform.runUntil(20);
+    REQUIRE(next->getStartTime() == 20);
+    REQUIRE(next->getNumberOfCheckpoints() == 0);
+}
+
+TEST_CASE("test the jobs checkpointed for the huge jobs are reserved nodes again",
+          "[conservativeBackfillScheduler]") {
+    TestPlatform platform(new ConservativeBackfillScheduler(), 4);
+    platform.scheduler->enablePreemption(0.5);
+    WeekendBegin weekendBegin(platform.scheduler);
+    WeekendEnd weekendEnd(platform.scheduler);
+    platform.insert(&weekendBegin);
+    platform.insert(&weekendEnd);
+    // with preemption the job may run into the week-end
+    auto *running = platform.submit<LargeJob>(4, 150);
+    platform.runUntil(1);
+    auto *hugeJob = platform.submit<HugeJob>(4, 10);
+    REQUIRE(running->getStartTime() == 0);
+
+    platform.runUntil(104);
+    REQUIRE(hugeJob->getStartTime() == 104);
+    REQUIRE(running->getNumberOfCheckpoints() == 1);
+    // no job starts during the week-end, the checkpointed job is reserved the nodes on monday morning
+    platform.runUntil(168);
+    REQUIRE(running->getStartTime() == 168);
+    REQUIRE(running->getCompletion()->getTime() == 168 + 150 - 104 + 0.5);
+}
+
+TEST_CASE("test the jobs started by the week-end planner keep the reservations of the others",
+          "[conservativeBackfillScheduler]") {
+    TestPlatform platform(new ConservativeBackfillScheduler(), 8);
+    platform.scheduler->setWeekendPlanner(new WeekendPlanner(2));
+    WeekendBegin weekendBegin(platform.scheduler);
+    WeekendEnd weekendEnd(platform.scheduler);
+    platform.insert(&weekendBegin);
+    platform.insert(&weekendEnd);
+    // too late to end before the week-end, they are all reserved nodes from monday morning
+    platform.runUntil(103.5);
+    std::vector<LargeJob *> jobs;
+    for (int i = 0; i < 1000; ++i) {
+        jobs.push_back(platform.submit<LargeJob>(1, 2));
+    }
+
+    // the planner fills the 8 nodes during the 64 hours of the week-end, each job started on its own
+    platform.runUntil(167);
+    int numberOfJobsStarted = 0;
+    for (LargeJob *job : jobs) {
+        if (job->getStartTime() != -1) {
+            REQUIRE(job->getStartTime() >= 104);
+            numberOfJobsStarted++;
+        }
+    }
+    REQUIRE(numberOfJobsStarted == 256);
+    // the jobs left are reserved the nodes again when the week-end ends : 8 of them start every 2 hours
+    platform.runUntil(170);
+    int numberOfJobsStartedOnMonday = 0;
+    for (LargeJob *job : jobs) {
+        if (job->getStartTime() >= 168) {
+            REQUIRE((job->getStartTime() == 168 || job->getStartTime() == 170));
+            numberOfJobsStartedOnMonday++;
+        }
+    }
+    REQUIRE(numberOfJobsStartedOnMonday == 16);
+}
+
+TEST_CASE("test the reservations follow the jobs slowed down by the racks they run on",
+          "[conservativeBackfillScheduler]") {
+    // racks of 4 nodes, the nodes are allocated by increasing id
+    TestPlatform platform(new ConservativeBackfillScheduler(), 8);
+    platform.scheduler->setTopology(4, 0.5, false);
+    platform.submit<LargeJob>(2, 10);
+    // nodes 2 to 5, over two racks it completes at 15
+    auto *slowJob = platform.submit<LargeJob>(4, 10);
+    platform.submit<LargeJob>(2, 10);
+    REQUIRE(slowJob->getCompletion()->getTime() == 15);
+    platform.runUntil(1);
+    // reserved the whole platform once the slow job completes
+    auto *wideJob = platform.submit<LargeJob>(8, 5);
+    platform.runUntil(2);
+    // backfilled on the 4 nodes free at 10, over two racks it completes at 16
+    auto *backfilled = platform.submit<LargeJob>(4, 4);
+
+    platform.runUntil(10);
+    REQUIRE(backfilled->getStartTime() == 10);
+    REQUIRE(backfilled->getCompletion()->getTime() == 16);
+    platform.runUntil(16);
+    REQUIRE(wideJob->getStartTime() == 16);
+}
+
+TEST_CASE("test the reservations follow the completions moved by the I/O of the jobs",
+          "[conservativeBackfillScheduler]") {
+    TestPlatform platform(new ConservativeBackfillScheduler(), 20);
+    platform.scheduler->setFilesystemBandwidth(4);
+    auto *first = platform.submit<LargeJob>(10, 10, nullptr, 0.4);
+    platform.runUntil(2);
+    // the first job now completes at 11.6 and the second one at 7.5
+    platform.submit<LargeJob>(10, 5, nullptr, 0.2);
+    platform.runUntil(3);
+    auto *wideJob = platform.submit<LargeJob>(20, 1);
+    platform.runUntil(4);
+    // backfilled on the nodes of the second job before the wide job
+    auto *backfilled = platform.submit<LargeJob>(10, 3.3);
+
+    platform.runUntil(7.5);
+    REQUIRE(backfilled->getStartTime() == 7.5);
+    // the first job completes sooner, the wide job is reserved the nodes at its completion
+    double firstCompletion = first->getCompletion()->getTime();
+    REQUIRE(firstCompletion == Approx(7.5 + 8 - 5.5 / 1.2));
+    platform.runUntil(firstCompletion);
+    REQUIRE(wideJob->getStartTime() == firstCompletion);
+}
+
+TEST_CASE("test the free nodes of the small partition lent to a waiting large job are counted as normal nodes",
+          "[conservativeBackfillScheduler]") {
+    // nodes 0 and 1 are reserved for small jobs, 2 and 3 are normal nodes
+    TestPlatform platform(new ConservativeBackfillScheduler(), 2, 0, 2);
+    platform.scheduler->setPartitionController(new PartitionController(1, 0, 2, 0, 0));
+    platform.submit<SmallJob>(1, 2);
+    platform.runUntil(1);
+    auto *largeJob = platform.submit<LargeJob>(3, 5);
+    REQUIRE(largeJob->getStartTime() == -1);
+
+    // the large job waits longer than the small jobs when the small job completes
+    platform.runUntil(2);
+    REQUIRE(platform.getNode(0)->getNodeClass() == NormalNodeClass);
+    REQUIRE(platform.getNode(1)->getNodeClass() == NormalNodeClass);
+    REQUIRE(largeJob->getStartTime() == 2);
+}
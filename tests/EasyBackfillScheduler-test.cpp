@@ -0,0 +1,62 @@
+#include "catch.hpp"
+#include "TestPlatform.h"
+#include "../include/EasyBackfillScheduler.h"
+#include "../include/JobCompletion.h"
+
+// the jobs are submitted one hour apart, so that the next job is the oldest one whatever its type
+
+TEST_CASE("test a short job is backfilled ahead of the blocked next job", "[easyBackfillScheduler]") {
+    TestPlatform platform(new EasyBackfillScheduler(), 4);
+    auto *running = platform.submit<LargeJob>(3, 10);
+    platform.runUntil(1);
+    // needs the four nodes, its shadow time is the completion of the running job
+    auto *next = platform.submit<LargeJob>(4, 5);
+    platform.runUntil(2);
+    auto *shortJob = platform.submit<MediumJob>(1, 5);
+    platform.runUntil(3);
+    // would still hold a node at the shadow time, when the next job needs all of them
+    auto *longJob = platform.submit<LargeJob>(1, 20);
+    REQUIRE(running->getStartTime() == 0);
+    REQUIRE(next->getStartTime() == -1);
+    REQUIRE(shortJob->getStartTime() == 2);
+    REQUIRE(longJob->getStartTime() == -1);
+
+    platform.runUntil(7);
+    REQUIRE(shortJob->getCompletionTime() == 7);
+    REQUIRE(longJob->getStartTime() == -1);
+    platform.runUntil(10);
+    // the next job was not delayed by the backfilled job
+    REQUIRE(next->getStartTime() == 10);
+    platform.runUntil(15);
+    REQUIRE(longJob->getStartTime() == 15);
+}
+
+TEST_CASE("test a job is not backfilled on the nodes reserved for the next job", "[easyBackfillScheduler]") {
+    // the small node has id 0, the normal nodes 1 to 3
+    TestPlatform platform(new EasyBackfillScheduler(), 3, 0, 1);
+    auto *running = platform.submit<LargeJob>(2, 10);
+    platform.runUntil(1);
+    // the large jobs only run on normal nodes : the three of them are reserved at the shadow time
+    auto *next = platform.submit<LargeJob>(3, 5);
+    platform.runUntil(2);
+    // the free normal node is reserved and it would still be running at the shadow time
+    auto *onReservedNode = platform.submit<MediumJob>(1, 20);
+    platform.runUntil(3);
+    // takes the small node, which the next job does not need
+    auto *onSmallNode = platform.submit<SmallJob>(1, 20);
+    platform.runUntil(4);
+    // ends before the shadow time, the reserved node is free again when the next job needs it
+    auto *beforeShadowTime = platform.submit<MediumJob>(1, 5);
+    REQUIRE(running->getStartTime() == 0);
+    REQUIRE(next->getStartTime() == -1);
+    REQUIRE(onReservedNode->getStartTime() == -1);
+    REQUIRE(onSmallNode->getStartTime() == 3);
+    REQUIRE(onSmallNode->getCompletion()->getNodes()[0] == platform.getNode(0));
+    REQUIRE(beforeShadowTime->getStartTime() == 4);
+
+    platform.runUntil(10);
+    REQUIRE(next->getStartTime() == 10);
+    REQUIRE(onReservedNode->getStartTime() == -1);
+    platform.runUntil(15);
+    REQUIRE(onReservedNode->getStartTime() == 15);
+}
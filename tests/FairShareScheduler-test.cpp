@@ -0,0 +1,94 @@
+#include "catch.hpp"
+#include "TestPlatform.h"
+#include "../include/FairShareScheduler.h"
+#include "../include/Researcher.h"
+#include "../include/weekendEvent.h"
+
+TEST_CASE("test the next job of a user is held until the job queued before it starts", "[fairShareScheduler]") {
+    Group group(1000), otherGroup(1000);
+    Researcher researcher(&group), otherResearcher(&otherGroup);
+    TestPlatform platform(new FairShareScheduler(SchedulerParameters()), 1);
+    platform.submit<LargeJob>(1, 3, &otherResearcher);
+    platform.runUntil(1);
+    auto *first = platform.submit<LargeJob>(1, 5, &researcher);
+    auto *second = platform.submit<LargeJob>(1, 5, &researcher);
+    auto *otherJob = platform.submit<LargeJob>(1, 5, &otherResearcher);
+    REQUIRE(platform.scheduler->totalOfNonHugeJobsWaiting() == 3);
+    // the held job keeps the priority given at its submission
+    REQUIRE(second->priority() == -1);
+    REQUIRE(first->priority() > otherJob->priority());
+
+    platform.runUntil(3);
+    REQUIRE(first->getStartTime() == 3);
+    // queued once the first job starts, after its user was charged more than the other user
+    REQUIRE(platform.scheduler->totalOfNonHugeJobsWaiting() == 2);
+    REQUIRE(second->priority() < otherJob->priority());
+    platform.runUntil(13);
+    REQUIRE(otherJob->getStartTime() == 8);
+    REQUIRE(second->getStartTime() == 13);
+}
+
+TEST_CASE("test charging a user only changes the priorities of the jobs of its account", "[fairShareScheduler]") {
+    Group group(1000), otherGroup(1000);
+    Researcher researcher(&group), colleague(&group), otherResearcher(&otherGroup);
+    // a small node and a normal node, the large jobs never fit
+    TestPlatform platform(new FairShareScheduler(SchedulerParameters()), 1, 0, 1);
+    auto *colleagueJob = platform.submit<LargeJob>(2, 5, &colleague);
+    auto *otherJob = platform.submit<LargeJob>(2, 5, &otherResearcher);
+    double colleaguePriority = colleagueJob->priority();
+    double otherPriority = otherJob->priority();
+
+    auto *smallJob = platform.submit<SmallJob>(1, 5, &researcher);
+    REQUIRE(smallJob->getStartTime() == 0);
+    // the usage of the group of the researcher counts for its colleague
+    REQUIRE(colleagueJob->priority() < colleaguePriority);
+    REQUIRE(otherJob->priority() == otherPriority);
+    REQUIRE(otherJob->priority() > colleagueJob->priority());
+}
+
+TEST_CASE("test a user is charged only for the cores its jobs use", "[fairShareScheduler]") {
+    Group group(1000), otherGroup(1000);
+    Researcher researcher(&group), otherResearcher(&otherGroup);
+    // two small nodes, the large jobs never fit
+    TestPlatform platform(new FairShareScheduler(SchedulerParameters()), 0, 0, 2);
+    auto *sharingJob = platform.submit<SmallJob>(1, 5, &researcher, 0, 4);
+    auto *wholeNodeJob = platform.submit<SmallJob>(1, 5, &otherResearcher);
+    REQUIRE(sharingJob->getStartTime() == 0);
+    REQUIRE(wholeNodeJob->getStartTime() == 0);
+
+    auto *job = platform.submit<LargeJob>(2, 5, &researcher);
+    auto *otherJob = platform.submit<LargeJob>(2, 5, &otherResearcher);
+    REQUIRE(job->priority() > otherJob->priority());
+}
+
+TEST_CASE("test a checkpointed job is queued again ahead of the next job of its user", "[fairShareScheduler]") {
+    Group group(1000), otherGroup(1000);
+    Researcher researcher(&group), otherResearcher(&otherGroup);
+    TestPlatform platform(new FairShareScheduler(SchedulerParameters()), 2);
+    platform.scheduler->enablePreemption(0.5);
+    WeekendBegin weekendBegin(platform.scheduler);
+    WeekendEnd weekendEnd(platform.scheduler);
+    platform.insert(&weekendBegin);
+    platform.insert(&weekendEnd);
+    auto *running = platform.submit<LargeJob>(2, 200, &researcher);
+    platform.runUntil(1);
+    // queued, then held behind the checkpointed job
+    auto *queued = platform.submit<LargeJob>(1, 5, &researcher);
+    // held behind the queued job
+    auto *held = platform.submit<LargeJob>(1, 5, &researcher);
+    auto *hugeJob = platform.submit<HugeJob>(2, 10, &otherResearcher);
+
+    platform.runUntil(104);
+    REQUIRE(hugeJob->getStartTime() == 104);
+    REQUIRE(running->getNumberOfCheckpoints() == 1);
+    REQUIRE(platform.scheduler->totalOfNonHugeJobsWaiting() == 3);
+
+    platform.runUntil(168);
+    REQUIRE(running->getStartTime() == 168);
+    REQUIRE(queued->getStartTime() == -1);
+    REQUIRE(held->getStartTime() == -1);
+    double end = 168 + 200 - 104 + 0.5;
+    platform.runUntil(end);
+    REQUIRE(queued->getStartTime() == end);
+    REQUIRE(held->getStartTime() == end);
+}
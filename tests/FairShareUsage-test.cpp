@@ -0,0 +1,36 @@
+#include <cmath>
+#include <limits>
+#include "catch.hpp"
+#include "../include/FairShareUsage.h"
+#include "../include/Researcher.h"
+#include "../include/Student.h"
+
+TEST_CASE("test the usage decays and keeps the order of the users", "[fairShare]") {
+    Group group(1000);
+    Curriculum curriculum(100, 10);
+    Researcher firstResearcher(&group), secondResearcher(&group);
+    Student student(&curriculum);
+    FairShareUsage usage(10, 1, 1);
+
+    usage.charge(&firstResearcher, 8, 0);
+    REQUIRE(usage.usage(&firstResearcher, 10) == Approx(4));
+    REQUIRE(usage.usage(&group, 20) == Approx(2));
+    usage.charge(&student, 8, 10);
+    REQUIRE(usage.usage(&student, 10) == Approx(8));
+    REQUIRE(usage.usage(&curriculum, 10) == Approx(8));
+
+    // the group usage counts for both researchers, the usage of the first researcher has decayed by half
+    REQUIRE(usage.key(&secondResearcher) < usage.key(&firstResearcher));
+    REQUIRE(usage.key(&firstResearcher) < usage.key(&student));
+
+    // the keys are rescaled when they would grow too large, the usage is unchanged
+    REQUIRE(!usage.charge(&secondResearcher, 1, 1000));
+    REQUIRE(usage.charge(&secondResearcher, 1, 10000));
+    REQUIRE(usage.usage(&secondResearcher, 10000) == Approx(1));
+    REQUIRE(std::isfinite(usage.key(&firstResearcher)));
+
+    FairShareUsage withoutDecay(std::numeric_limits<double>::infinity(), 1, 0);
+    withoutDecay.charge(&student, 3, 0);
+    REQUIRE(withoutDecay.usage(&student, 1000) == 3);
+    REQUIRE(withoutDecay.key(&student) == 3);
+}
@@ -0,0 +1,150 @@
+#include "catch.hpp"
+#include "../include/FreeNodePool.h"
+#include "../include/Node.h"
+
+TEST_CASE("test the pool counts and allocates the free nodes by class", "[freeNodePool]") {
+    std::vector<Node *> nodes;
+    FreeNodePool pool;
+    for (int i = 0; i < 200; ++i) {
+        nodes.push_back(new Node());
+        nodes.back()->setId(i);
+        pool.release(i < 150 ? NormalNodeClass : GpuNodeClass, nodes.back());
+    }
+    REQUIRE(pool.available(NormalNodeClass) == 150);
+    REQUIRE(pool.available(GpuNodeClass) == 50);
+    REQUIRE(pool.available({NormalNodeClass, GpuNodeClass, SmallNodeClass}) == 200);
+
+    std::vector<Node *> taken;
+    pool.take(NormalNodeClass, 70, taken);
+    REQUIRE(taken.size() == 70);
+    for (int i = 0; i < 70; ++i) {
+        REQUIRE(taken[i] == nodes[i]);
+    }
+    REQUIRE(pool.available(NormalNodeClass) == 80);
+
+    // the remaining normal nodes are taken before the gpu nodes
+    std::vector<Node *> takenAcrossClasses;
+    pool.take({NormalNodeClass, GpuNodeClass}, 100, takenAcrossClasses);
+    REQUIRE(takenAcrossClasses.size() == 100);
+    REQUIRE(takenAcrossClasses[0] == nodes[70]);
+    REQUIRE(takenAcrossClasses[79] == nodes[149]);
+    REQUIRE(takenAcrossClasses[80] == nodes[150]);
+    REQUIRE(pool.available(NormalNodeClass) == 0);
+    REQUIRE(pool.available(GpuNodeClass) == 30);
+
+    // released nodes are allocated again by increasing id
+    pool.release(NormalNodeClass, std::vector<Node *>{nodes[100], nodes[3], nodes[64]});
+    std::vector<Node *> takenAgain;
+    pool.take(NormalNodeClass, 2, takenAgain);
+    REQUIRE(takenAgain == std::vector<Node *>{nodes[3], nodes[64]});
+    REQUIRE(pool.available(NormalNodeClass) == 1);
+
+    for (auto &node : nodes) {
+        delete node;
+    }
+}
+
+TEST_CASE("test free nodes are moved from a class to another", "[freeNodePool]") {
+    std::vector<Node *> nodes;
+    FreeNodePool pool;
+    for (int i = 0; i < 10; ++i) {
+        nodes.push_back(new ReservedForSmallJobNode());
+        nodes.back()->setId(i);
+        pool.release(SmallNodeClass, nodes.back());
+    }
+    std::vector<Node *> taken;
+    pool.take(SmallNodeClass, 2, taken);
+    REQUIRE(pool.size(SmallNodeClass) == 10);
+
+    std::vector<Node *> moved;
+    pool.reassign(SmallNodeClass, NormalNodeClass, 5, moved);
+    REQUIRE(moved.size() == 5);
+    REQUIRE(moved[0] == nodes[2]);
+    REQUIRE(moved[0]->getNodeClass() == NormalNodeClass);
+    REQUIRE(pool.size(SmallNodeClass) == 5);
+    REQUIRE(pool.size(NormalNodeClass) == 5);
+    REQUIRE(pool.available(SmallNodeClass) == 3);
+    REQUIRE(pool.available(NormalNodeClass) == 0);
+
+    // the nodes moved are free again once released in their new class
+    pool.release(NormalNodeClass, moved);
+    REQUIRE(pool.available(NormalNodeClass) == 5);
+    REQUIRE(pool.size(NormalNodeClass) == 5);
+
+    // only the free nodes are moved when more are asked
+    std::vector<Node *> movedBack;
+    pool.reassign(SmallNodeClass, MediumNodeClass, 4, movedBack);
+    REQUIRE(movedBack.size() == 3);
+    REQUIRE(pool.size(SmallNodeClass) == 2);
+    REQUIRE(pool.size(MediumNodeClass) == 3);
+
+    for (auto &node : nodes) {
+        delete node;
+    }
+}
+
+TEST_CASE("test the nodes are allocated in as few racks as possible", "[freeNodePool]") {
+    std::vector<Node *> nodes;
+    FreeNodePool pool;
+    pool.setNodesPerRack(16);
+    for (int i = 0; i < 64; ++i) {
+        nodes.push_back(new Node());
+        nodes.back()->setId(i);
+        pool.release(NormalNodeClass, nodes.back());
+    }
+    // leave 10 free nodes in the first rack, 4 in the second, 16 in the others
+    std::vector<Node *> busy;
+    pool.take(NormalNodeClass, 6, busy);
+    pool.take(NormalNodeClass, 12, busy);
+    REQUIRE(pool.available(NormalNodeClass) == 46);
+
+    // the rack with the fewest free nodes where the job fits
+    std::vector<Node *> taken;
+    pool.take(NormalNodeClass, 4, taken);
+    REQUIRE(taken.size() == 4);
+    for (auto &node : taken) {
+        REQUIRE(node->getId() / 16 == 1);
+    }
+
+    // a job larger than a rack starts with the rack with the most free nodes, the rest keeps the last rack whole
+    std::vector<Node *> spread;
+    pool.take(NormalNodeClass, 20, spread);
+    REQUIRE(spread.size() == 20);
+    REQUIRE(spread[0] == nodes[32]);
+    REQUIRE(spread[16] == nodes[6]);
+    REQUIRE(pool.available(NormalNodeClass) == 22);
+    std::vector<Node *> wholeRack;
+    pool.take(NormalNodeClass, 16, wholeRack);
+    REQUIRE(wholeRack.front() == nodes[48]);
+    REQUIRE(wholeRack.back() == nodes[63]);
+
+    for (auto &node : nodes) {
+        delete node;
+    }
+}
+
+TEST_CASE("test every free node of a range of ids is taken", "[freeNodePool]") {
+    std::vector<Node *> nodes;
+    FreeNodePool pool;
+    for (int i = 0; i < 100; ++i) {
+        nodes.push_back(i < 10 ? new ReservedForSmallJobNode() : new Node());
+        nodes.back()->setId(i);
+        pool.release(nodes.back()->getNodeClass(), nodes.back());
+    }
+    std::vector<Node *> busy;
+    pool.take(NormalNodeClass, 5, busy);
+
+    // the range spans both classes and two words, nodes 10 to 14 are busy
+    std::vector<Node *> reserved;
+    pool.takeRange(5, 70, reserved);
+    REQUIRE(reserved.size() == 60);
+    REQUIRE(pool.available(SmallNodeClass) == 5);
+    REQUIRE(pool.available(NormalNodeClass) == 30);
+    std::vector<Node *> left;
+    pool.take(NormalNodeClass, 1, left);
+    REQUIRE(left[0] == nodes[70]);
+
+    for (auto &node : nodes) {
+        delete node;
+    }
+}
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include "catch.hpp"
+#include "../include/HeapQueue.h"
+#include "../include/ListQueue.h"
+
+TEST_CASE("test heap queue returns events by increasing time", "[heapqueue]") {
+    HeapQueue queue;
+    std::vector<Event *> events;
+    for (double time : {5.0, 1.0, 4.0, 2.0, 3.0}) {
+        events.push_back(new Event(time));
+        queue.insert(events.back());
+    }
+    REQUIRE(queue.size() == 5);
+    for (double time = 1; time <= 5; ++time) {
+        REQUIRE(((Event *) queue.removeFirst())->getTime() == time);
+    }
+    REQUIRE(queue.removeFirst() == nullptr);
+    for (auto &event : events) {
+        delete event;
+    }
+}
+
+TEST_CASE("test heap queue removes an arbitrary event", "[heapqueue]") {
+    HeapQueue queue;
+    Event first(1), second(2), third(3), fourth(4);
+    queue.insert(&third);
+    queue.insert(&first);
+    queue.insert(&fourth);
+    queue.insert(&second);
+    REQUIRE(queue.remove(&third) == &third);
+    REQUIRE(queue.remove(&third) == nullptr);
+    REQUIRE(queue.size() == 3);
+    REQUIRE(queue.removeFirst() == &first);
+    REQUIRE(queue.removeFirst() == &second);
+    REQUIRE(queue.removeFirst() == &fourth);
+}
+
+TEST_CASE("test heap queue orders equal events as the list queue", "[heapqueue]") {
+    HeapQueue heapQueue;
+    ListQueue listQueue;
+    std::vector<Event *> events;
+    for (int i = 0; i < 200; ++i) {
+        events.push_back(new Event((i * 7) % 13));
+        heapQueue.insert(events.back());
+        listQueue.insert(events.back());
+    }
+    REQUIRE(heapQueue.remove(events[42]) == listQueue.remove(events[42]));
+    while (listQueue.size() > 0) {
+        REQUIRE(heapQueue.removeFirst() == listQueue.removeFirst());
+    }
+    REQUIRE(heapQueue.size() == 0);
+    for (auto &event : events) {
+        delete event;
+    }
+}
+
+/**
+ * Event whose time the tests may change while it is out of the queues
+ */
+class MovableEvent : public Event {
+public:
+    explicit MovableEvent(double time) : Event(time) {};
+
+    void setTime(double newTime) { time = newTime; };
+};
+
+TEST_CASE("test heap queue moves events in bulk as the list queue", "[heapqueue]") {
+    // the queues have their own events, with the same times
+    HeapQueue heapQueue;
+    ListQueue listQueue;
+    std::vector<MovableEvent *> heapEvents, listEvents;
+    for (int i = 0; i < 200; ++i) {
+        heapEvents.push_back(new MovableEvent((i * 7) % 13));
+        heapQueue.insert(heapEvents.back());
+        listEvents.push_back(new MovableEvent((i * 7) % 13));
+        listQueue.insert(listEvents.back());
+    }
+    auto later = [](Comparable *event) {
+        auto *movable = (MovableEvent *) event;
+        movable->setTime(movable->getTime() + 5);
+    };
+    // few events are removed and inserted again, most events rebuild the heap
+    for (auto range : {std::make_pair(40, 43), std::make_pair(50, 200)}) {
+        std::vector<Comparable *> heapMoved(heapEvents.begin() + range.first, heapEvents.begin() + range.second);
+        std::vector<Comparable *> listMoved(listEvents.begin() + range.first, listEvents.begin() + range.second);
+        heapQueue.update(heapMoved, later);
+        listQueue.update(listMoved, later);
+    }
+    while (listQueue.size() > 0) {
+        auto heapFirst = std::find(heapEvents.begin(), heapEvents.end(), heapQueue.removeFirst());
+        auto listFirst = std::find(listEvents.begin(), listEvents.end(), listQueue.removeFirst());
+        REQUIRE(heapFirst - heapEvents.begin() == listFirst - listEvents.begin());
+    }
+    REQUIRE(heapQueue.size() == 0);
+    for (int i = 0; i < 200; ++i) {
+        delete heapEvents[i];
+        delete listEvents[i];
+    }
+}
@@ -0,0 +1,41 @@
+#include "catch.hpp"
+#include "../include/IoContention.h"
+#include "../include/AbstractJob.h"
+
+TEST_CASE("test the jobs doing I/O slow down when they ask for more than the bandwidth", "[ioContention]") {
+    IoContention contention(4);
+    LargeJob first, second;
+    first.setId(1);
+    first.setNumberOfNodes(10).setExecutionDuration(10).setIoIntensity(0.4);
+    second.setId(2);
+    second.setNumberOfNodes(10).setExecutionDuration(5).setIoIntensity(0.2);
+    std::vector<std::pair<AbstractJob *, double>> completions;
+
+    // the first job alone uses the whole bandwidth
+    contention.start(&first, 0, completions);
+    REQUIRE(contention.slowdown() == 1);
+    REQUIRE(completions.size() == 1);
+    REQUIRE(completions[0].first == &first);
+    REQUIRE(completions[0].second == Approx(10));
+
+    // both jobs do their I/O 1.5 times slower
+    completions.clear();
+    contention.start(&second, 2, completions);
+    REQUIRE(contention.slowdown() == Approx(1.5));
+    REQUIRE(completions.size() == 2);
+    REQUIRE(completions[0].first == &first);
+    REQUIRE(completions[0].second == Approx(2 + 8 * 1.2));
+    REQUIRE(completions[1].first == &second);
+    REQUIRE(completions[1].second == Approx(2 + 5 * 1.1));
+
+    // the first job runs at full speed again once the second one is done
+    completions.clear();
+    REQUIRE(contention.stop(&second, 7.5, completions) == Approx(5));
+    REQUIRE(contention.slowdown() == 1);
+    REQUIRE(completions.size() == 1);
+    double firstCompletion = completions[0].second;
+    REQUIRE(firstCompletion == Approx(7.5 + 8 - 5.5 / 1.2));
+    completions.clear();
+    REQUIRE(contention.stop(&first, firstCompletion, completions) == Approx(10));
+    REQUIRE(completions.empty());
+}
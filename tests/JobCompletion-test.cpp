@@ -0,0 +1,47 @@
+#include "catch.hpp"
+#include "TestPlatform.h"
+#include "../include/JobCompletion.h"
+
+TEST_CASE("test a single completion releases every node of a job", "[jobCompletion]") {
+    TestPlatform platform(new Scheduler(), 4);
+    auto *first = platform.submit<LargeJob>(4, 10);
+    auto *second = platform.submit<LargeJob>(4, 5);
+    REQUIRE(first->getStartTime() == 0);
+    REQUIRE(second->getStartTime() == -1);
+    // one event for the job, whatever its number of nodes
+    REQUIRE(platform.eventsSize() == 1);
+    REQUIRE(first->getCompletion()->getTime() == 10);
+    REQUIRE(first->getCompletion()->getNodes().size() == 4);
+    for (int id = 0; id < 4; ++id) {
+        REQUIRE(platform.getNode(id)->getJobBeingExecuted() == first);
+    }
+
+    platform.runUntil(10);
+    REQUIRE(first->getCompletionTime() == 10);
+    // the nodes were all released at once, the next job waiting for all of them starts at the same time
+    REQUIRE(second->getStartTime() == 10);
+    for (int id = 0; id < 4; ++id) {
+        REQUIRE(platform.getNode(id)->getJobBeingExecuted() == second);
+    }
+    platform.runUntil(15);
+    REQUIRE(second->getCompletionTime() == 15);
+    REQUIRE(platform.eventsSize() == 0);
+}
+
+TEST_CASE("test a completion taken out of the calendar runs at its time once inserted again", "[jobCompletion]") {
+    TestPlatform platform(new Scheduler(), 2);
+    auto *job = platform.submit<MediumJob>(2, 3);
+    auto *other = platform.submit<MediumJob>(1, 1);
+    JobCompletion *completion = job->getCompletion();
+    REQUIRE(platform.remove(completion));
+    REQUIRE(!platform.remove(completion));
+    REQUIRE(platform.eventsSize() == 0);
+
+    platform.insert(completion);
+    platform.runUntil(2);
+    REQUIRE(job->getCompletionTime() == 0);
+    platform.runUntil(3);
+    REQUIRE(job->getCompletionTime() == 3);
+    REQUIRE(other->getStartTime() == 3);
+    REQUIRE(platform.eventsSize() == 1);
+}
@@ -0,0 +1,122 @@
+#include "catch.hpp"
+#include "../include/JobQueue.h"
+#include "../include/AbstractJob.h"
+
+TEST_CASE("test the next job is the oldest head of the queues", "[jobQueue]") {
+    NextJobIndex index;
+    JobQueue<MediumJob> mediumJobs(&index, MediumJobQueue);
+    JobQueue<SmallJob> smallJobs(&index, SmallJobQueue);
+    JobQueue<GpuJob> gpuJobs(&index, GpuJobQueue);
+    MediumJob medium;
+    SmallJob firstSmall, secondSmall;
+    GpuJob gpu;
+    medium.setSubmittingTime(3);
+    firstSmall.setSubmittingTime(1);
+    secondSmall.setSubmittingTime(2);
+    gpu.setSubmittingTime(2.5);
+
+    REQUIRE(index.nextJob() == nullptr);
+    mediumJobs.push_back(&medium);
+    REQUIRE(index.nextJob() == &medium);
+    smallJobs.push_back(&firstSmall);
+    smallJobs.push_back(&secondSmall);
+    gpuJobs.push_back(&gpu);
+    REQUIRE(index.nextNonGpuJob() == &firstSmall);
+    REQUIRE(index.nextJob() == &firstSmall);
+
+    smallJobs.pop_front();
+    REQUIRE(index.nextJob() == &secondSmall);
+    smallJobs.erase(smallJobs.begin());
+    REQUIRE(index.nextNonGpuJob() == &medium);
+    REQUIRE(index.nextJob() == &gpu);
+    gpuJobs.pop_front();
+    REQUIRE(index.nextJob() == &medium);
+}
+
+TEST_CASE("test the first queue wins on equal priorities", "[jobQueue]") {
+    NextJobIndex index;
+    JobQueue<MediumJob> mediumJobs(&index, MediumJobQueue);
+    JobQueue<SmallJob> smallJobs(&index, SmallJobQueue);
+    JobQueue<GpuJob> gpuJobs(&index, GpuJobQueue);
+    MediumJob medium;
+    SmallJob small;
+    GpuJob gpu;
+    smallJobs.push_back(&small);
+    mediumJobs.push_back(&medium);
+    REQUIRE(index.nextNonGpuJob() == &medium);
+    gpuJobs.push_back(&gpu);
+    REQUIRE(index.nextJob() == &gpu);
+}
+
+TEST_CASE("test the queue is ordered by priority and reordered when a priority changes", "[jobQueue]") {
+    NextJobIndex index;
+    JobQueue<SmallJob> smallJobs(&index, SmallJobQueue);
+    JobQueue<MediumJob> mediumJobs(&index, MediumJobQueue);
+    SmallJob first, second, third;
+    MediumJob medium;
+    first.setSubmittingTime(1);
+    second.setSubmittingTime(2);
+    third.setSubmittingTime(3);
+    medium.setSubmittingTime(1.5);
+    smallJobs.push_back(&third);
+    smallJobs.push_back(&first);
+    smallJobs.push_back(&second);
+    mediumJobs.push_back(&medium);
+    REQUIRE(smallJobs.front() == &first);
+    REQUIRE(index.nextJob() == &first);
+
+    // the head losing priority is moved behind the jobs of equal priority
+    REQUIRE(smallJobs.setPriority(&first, -3));
+    REQUIRE(smallJobs.front() == &second);
+    REQUIRE(index.nextJob() == &medium);
+    smallJobs.pop_front();
+    REQUIRE(smallJobs.front() == &third);
+    REQUIRE(smallJobs.setPriority(&third, 0));
+    REQUIRE(index.nextJob() == &third);
+    REQUIRE(!smallJobs.setPriority(&second, 0));
+    REQUIRE(smallJobs.remove(&first));
+    REQUIRE(smallJobs.size() == 1);
+}
+
+TEST_CASE("test the queue finds the longest job ending in time on the nodes", "[jobQueue]") {
+    JobQueue<MediumJob> mediumJobs;
+    MediumJob shortJob, longJob, wideJob;
+    shortJob.setExecutionDuration(3).setNumberOfNodes(2);
+    longJob.setExecutionDuration(7).setNumberOfNodes(2);
+    wideJob.setExecutionDuration(5).setNumberOfNodes(16);
+    mediumJobs.push_back(&shortJob);
+    mediumJobs.push_back(&longJob);
+    mediumJobs.push_back(&wideJob);
+
+    REQUIRE(mediumJobs.longestFitting(8, 16) == &longJob);
+    REQUIRE(mediumJobs.longestFitting(6, 16) == &wideJob);
+    REQUIRE(mediumJobs.longestFitting(6, 4) == &shortJob);
+    REQUIRE(mediumJobs.longestFitting(2, 16) == nullptr);
+
+    // the declared walltime is used instead of the execution duration
+    mediumJobs.remove(&shortJob);
+    shortJob.setDeclaredWalltime(10);
+    mediumJobs.push_back(&shortJob);
+    REQUIRE(mediumJobs.longestFitting(8, 4) == &longJob);
+    // the jobs have equal priorities, the head is the oldest one
+    mediumJobs.pop_front();
+    REQUIRE(mediumJobs.longestFitting(24, 4) == &shortJob);
+    REQUIRE(mediumJobs.longestFitting(8, 4) == nullptr);
+}
+
+TEST_CASE("test a checkpointed job is indexed by the walltime it has left", "[jobQueue]") {
+    JobQueue<LargeJob> largeJobs;
+    LargeJob job;
+    job.setExecutionDuration(12).setNumberOfNodes(32);
+    job.checkpoint(10, 0.5);
+    REQUIRE(job.getRemainingDuration() == 2.5);
+    REQUIRE(job.getExecutionDuration() == 12);
+    REQUIRE(job.getNumberOfCheckpoints() == 1);
+    largeJobs.push_back(&job);
+    REQUIRE(largeJobs.longestFitting(3, 32) == &job);
+
+    // the declared walltime is reduced by the same amount
+    largeJobs.pop_front();
+    job.setDeclaredWalltime(16);
+    REQUIRE(job.getWalltime() == 6.5);
+}
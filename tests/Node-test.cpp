@@ -0,0 +1,43 @@
+#include "catch.hpp"
+#include "../include/Node.h"
+#include "../include/AbstractJob.h"
+
+TEST_CASE("test small jobs share a node at the granularity of the cores", "[node]") {
+    Node node;
+    SmallJob first, second;
+    LargeJob large;
+    first.setNumberOfCores(4).setNumberOfNodes(1).setExecutionDuration(1);
+    second.setNumberOfCores(12).setNumberOfNodes(1).setExecutionDuration(2);
+    REQUIRE(first.isSharingNodes());
+    REQUIRE(!large.isSharingNodes());
+    REQUIRE(large.getNumberOfCores() == 16);
+
+    // the node-hours of a job sharing its node are the share of the cores it uses
+    REQUIRE(first.getNodeHours() == 0.25);
+
+    REQUIRE(node.isAvailable());
+    node.assign(&first);
+    REQUIRE(node.getFreeCores() == 12);
+    REQUIRE(!node.isAvailable());
+    node.assign(&second);
+    REQUIRE(node.getFreeCores() == 0);
+    node.release(&first);
+    REQUIRE(node.getFreeCores() == 4);
+    REQUIRE(node.getJobBeingExecuted() == &second);
+    node.release(&second);
+    REQUIRE(node.isAvailable());
+    REQUIRE(node.getJobBeingExecuted() == nullptr);
+
+    // the job still running is the one executed when the last one assigned ends first
+    node.assign(&first);
+    node.assign(&second);
+    node.release(&second);
+    REQUIRE(node.getJobBeingExecuted() == &first);
+    node.release(&first);
+    REQUIRE(node.getJobBeingExecuted() == nullptr);
+
+    node.assign(&large);
+    REQUIRE(node.getFreeCores() == 0);
+    node.release(&large);
+    REQUIRE(node.isAvailable());
+}
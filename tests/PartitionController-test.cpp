@@ -0,0 +1,24 @@
+#include "catch.hpp"
+#include "../include/PartitionController.h"
+
+TEST_CASE("test the partitions lend their free nodes to the large jobs waiting longer", "[partitionController]") {
+    PartitionController controller(24, 6, 13, 19, 39);
+    REQUIRE(!controller.startResizing(12));
+    REQUIRE(controller.startResizing(24));
+    REQUIRE(!controller.startResizing(40));
+    REQUIRE(controller.startResizing(48));
+
+    // no large job waiting, the partition is kept
+    REQUIRE(controller.transfer(SmallNodeClass, 13, 10, 0, 0, 0, 0, 0) == 0);
+    // the free nodes are lent down to the minimum size of the partition
+    REQUIRE(controller.transfer(SmallNodeClass, 13, 4, 0, 0, 0, 5, 1) == -4);
+    REQUIRE(controller.transfer(SmallNodeClass, 13, 10, 0, 0, 0, 5, 1) == -7);
+    REQUIRE(controller.transfer(MediumNodeClass, 19, 10, 0, 1, 1, 5, 1) == 0);
+    // the free normal nodes are taken back up to the maximum size of the partition
+    REQUIRE(controller.transfer(SmallNodeClass, 6, 0, 3, 5, 1, 1, 1) == 3);
+    REQUIRE(controller.transfer(MediumNodeClass, 30, 0, 20, 5, 1, 0, 0) == 9);
+    REQUIRE(controller.transfer(MediumNodeClass, 39, 0, 20, 5, 1, 0, 0) == 0);
+    // a long queue of the partition outweighs a single large job waiting longer
+    REQUIRE(controller.transfer(SmallNodeClass, 6, 0, 3, 2, 4, 5, 1) == 3);
+    REQUIRE(controller.transfer(SmallNodeClass, 13, 10, 0, 2, 3, 5, 1) == 0);
+}
@@ -0,0 +1,34 @@
+#include <stdexcept>
+#include "catch.hpp"
+#include "../include/PriorityFormula.h"
+#include "../include/HPCParameters.h"
+
+TEST_CASE("test the priority expressions are compiled into weights", "[priorityFormula]") {
+    PriorityFormula formula("1000*age + 500 * fairShare+size - 50*student + 20*gpu");
+    REQUIRE(formula.getWeight(AgePriorityFactor) == 1000);
+    REQUIRE(formula.getWeight(FairSharePriorityFactor) == 500);
+    REQUIRE(formula.getWeight(SizePriorityFactor) == 1);
+    REQUIRE(formula.getWeight(StudentPriorityFactor) == -50);
+    REQUIRE(formula.getWeight(GpuPriorityFactor) == 20);
+    REQUIRE(formula.getWeight(SmallPriorityFactor) == 0);
+
+    // a week of age is worth 1000, a gpu job of a student 20 - 50
+    REQUIRE(formula.evaluate(4, StudentUserKind, 0, 0, 0) - formula.evaluate(4, StudentUserKind, 168, 0, 0) ==
+            Approx(1000));
+    REQUIRE(formula.evaluate(4, StudentUserKind, 0, 0, 1) == Approx(-30 + 500));
+    REQUIRE(formula.evaluate(0, ResearcherUserKind, 0, HPCParameters::TotalNumberOfNodes, 0) == Approx(1));
+
+    std::string error;
+    REQUIRE(!formula.parse("1000*age + 2*speed", error));
+    REQUIRE(error == "Unknown priority factor : speed");
+    REQUIRE(!formula.parse("1000 age", error));
+    REQUIRE(!formula.parse("age fairShare", error));
+    // the weights are kept when the expression is not valid
+    REQUIRE(formula.getWeight(AgePriorityFactor) == 1000);
+    REQUIRE(formula.parse("", error));
+    REQUIRE(formula.getWeight(AgePriorityFactor) == 0);
+
+    // the reason of the failure is not lost when the formula is created
+    REQUIRE_THROWS_AS(PriorityFormula("1000*age + 2*speed"), std::invalid_argument);
+    REQUIRE_THROWS_WITH(PriorityFormula("1000*age + 2*speed"), "Unknown priority factor : speed");
+}
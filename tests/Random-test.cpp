@@ -0,0 +1,50 @@
+#include "catch.hpp"
+#include "../include/random.h"
+
+TEST_CASE("test seeded draws are reproducible", "[random]") {
+    Random::seed(42);
+    std::vector<double> firstRun;
+    for (int i = 0; i < 100; ++i) {
+        firstRun.push_back(Random::exponential(12));
+        firstRun.push_back(Random::normalDouble(8, 2));
+        firstRun.push_back(Random::binomialInt(50, 0.5));
+    }
+    Random::seed(42);
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(firstRun[3 * i] == Random::exponential(12));
+        REQUIRE(firstRun[3 * i + 1] == Random::normalDouble(8, 2));
+        REQUIRE(firstRun[3 * i + 2] == Random::binomialInt(50, 0.5));
+    }
+}
+
+TEST_CASE("test random distributions", "[random]") {
+    Random::seed(7);
+    double sum = 0;
+    for (int i = 0; i < 100000; ++i) {
+        sum += Random::exponential(12);
+    }
+    REQUIRE(sum / 100000 == Approx(12).epsilon(0.02));
+    std::vector<int> weights = {0, 1, 0, 3, 0};
+    int counts[5] = {0, 0, 0, 0, 0};
+    for (int i = 0; i < 40000; ++i) {
+        counts[Random::discreteInt(weights)]++;
+    }
+    REQUIRE(counts[0] + counts[2] + counts[4] == 0);
+    REQUIRE(counts[3] / (double) counts[1] == Approx(3).epsilon(0.05));
+}
+
+TEST_CASE("test substreams are reproducible and independent", "[random]") {
+    RandomStream first(RandomStream::substreamSeed(2019, 0));
+    RandomStream second(RandomStream::substreamSeed(2019, 1));
+    RandomStream firstAgain(RandomStream::substreamSeed(2019, 0));
+    REQUIRE(RandomStream::substreamSeed(2019, 0) != RandomStream::substreamSeed(2020, 0));
+    int equalDraws = 0;
+    for (int i = 0; i < 100; ++i) {
+        double draw = first.uniformDouble(0, 1);
+        REQUIRE(draw == firstAgain.uniformDouble(0, 1));
+        if (draw == second.uniformDouble(0, 1)) {
+            equalDraws++;
+        }
+    }
+    REQUIRE(equalDraws == 0);
+}
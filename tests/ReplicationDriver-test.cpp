@@ -0,0 +1,105 @@
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include "catch.hpp"
+#include "../include/ReplicationDriver.h"
+
+/**
+ * Return whether two replications measured the same values, the measurements of a type of jobs which never ran
+ * being NaN in both
+ */
+static bool sameResults(const SimulationResults &a, const SimulationResults &b) {
+    std::vector<std::pair<std::string, double>> valuesOfA = a.namedValues(), valuesOfB = b.namedValues();
+    if (valuesOfA.size() != valuesOfB.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < valuesOfA.size(); ++i) {
+        bool bothNaN = std::isnan(valuesOfA[i].second) && std::isnan(valuesOfB[i].second);
+        if (valuesOfA[i].first != valuesOfB[i].first || (!bothNaN && valuesOfA[i].second != valuesOfB[i].second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("test the confidence interval uses the quantiles of the Student distribution", "[replicationDriver]") {
+    REQUIRE(ReplicationDriver::confidenceHalfWidth({}) == 0);
+    REQUIRE(ReplicationDriver::confidenceHalfWidth({4}) == 0);
+    // mean 2 and standard deviation 1 over 2 degrees of freedom
+    REQUIRE(ReplicationDriver::confidenceHalfWidth({1, 2, 3}) == Approx(4.303 / std::sqrt(3)));
+    REQUIRE(ReplicationDriver::confidenceHalfWidth({5, 5, 5, 5}) == 0);
+}
+
+TEST_CASE("test the replications give the same results whatever the number of threads", "[replicationDriver]") {
+    const std::string inputFile = std::string(DATA_DIRECTORY) + "InputDataExample.txt";
+    ReplicationDriver sequential(inputFile, 42, 2, 1);
+    sequential.run();
+    ReplicationDriver parallel(inputFile, 42, 2, 2);
+    parallel.run();
+    REQUIRE(sequential.getResults().size() == 2);
+    REQUIRE(parallel.getResults().size() == 2);
+    for (int replication = 0; replication < 2; ++replication) {
+        REQUIRE(sameResults(sequential.getResults()[replication], parallel.getResults()[replication]));
+    }
+    // the replications are different draws
+    REQUIRE(!sameResults(sequential.getResults()[0], sequential.getResults()[1]));
+
+    // each replication runs on the substream of its number
+    HPCSimulator simulator;
+    simulator.getTracer().setLevel(TraceOff);
+    simulator.setSeed(RandomStream::substreamSeed(42, 1));
+    simulator.initialisation(inputFile);
+    simulator.start();
+    REQUIRE(sameResults(simulator.computeResults(), sequential.getResults()[1]));
+}
+
+TEST_CASE("test an invalid reservation of the input file is reported", "[replicationDriver]") {
+    const std::string inputFile = std::string(DATA_DIRECTORY) + "InputDataExample.txt";
+    std::string error;
+    REQUIRE(ReplicationDriver(inputFile, 42, 1, 1).checkScheduler(error));
+
+    // the example followed by a reservation ending before it begins
+    const std::string invalidFile = "InvalidReservation.txt";
+    {
+        std::ifstream example(inputFile);
+        std::ofstream invalid(invalidFile);
+        invalid << example.rdbuf() << "\nReservation 56 48 64 95\n";
+    }
+    REQUIRE(!ReplicationDriver(invalidFile, 42, 1, 1).checkScheduler(error));
+    REQUIRE(error == "Invalid reservation : Reservation 56 48 64 95");
+    std::remove(invalidFile.c_str());
+}
+
+TEST_CASE("test an invalid or unknown line of the optional section of the input file is reported", "[replicationDriver]") {
+    const std::string inputFile = std::string(DATA_DIRECTORY) + "InputDataExample.txt";
+    const std::string topologyFile = "Topology.txt";
+    // lines added after the example, with the error expected
+    const std::vector<std::pair<std::string, std::string>> topologies = {
+            {"NodesPerRack 0\n", "Invalid number of nodes per rack : NodesPerRack 0"},
+            {"NodesPerRack many\n", "Invalid number of nodes per rack : NodesPerRack many"},
+            {"NodesPerRack 32\nCommunicationPenalty -0.1\n", "Invalid communication penalty : CommunicationPenalty -0.1"},
+            {"CommunicationPenalty 0.1\n", "A communication penalty requires the number of nodes per rack"},
+            {"CompactPlacement maybe\n", "Invalid compact placement : CompactPlacement maybe"},
+            {"CompactPlacement 2\n", "Invalid compact placement : CompactPlacement 2"},
+            {"NodesPerRack 32\nCompactPlacement 0\n", ""},
+            // only the first error is reported
+            {"CommunicationPenalty 0.1\nReservation 56 48 64 95\n", "Invalid reservation : Reservation 56 48 64 95"},
+            {"FilesystemBandwidth abc\n", "Invalid filesystem bandwidth : FilesystemBandwidth abc"},
+            {"FilesystemBandwidth -5\n", "Invalid filesystem bandwidth : FilesystemBandwidth -5"},
+            {"Reservaton 5 10 0 3\n", "Unknown keyword : Reservaton 5 10 0 3"},
+            {"WalltimeOverestimate 0.5\n", "Invalid walltime overestimate : WalltimeOverestimate 0.5"},
+            {"WalltimeOverestimate 1.5\n", ""},
+            // the size of the racks may come after the penalty
+            {"CommunicationPenalty 0.1\nNodesPerRack 32\n", ""}};
+    for (auto &topology : topologies) {
+        {
+            std::ifstream example(inputFile);
+            std::ofstream lines(topologyFile);
+            lines << example.rdbuf() << "\n" << topology.first;
+        }
+        std::string error;
+        REQUIRE(ReplicationDriver(topologyFile, 42, 1, 1).checkScheduler(error) == topology.second.empty());
+        REQUIRE(error == topology.second);
+    }
+    std::remove(topologyFile.c_str());
+}
@@ -0,0 +1,33 @@
+#include "catch.hpp"
+#include "../include/ReservationCalendar.h"
+
+TEST_CASE("test the reservation calendar finds the reservations overlapping a time window", "[reservationCalendar]") {
+    ReservationCalendar calendar;
+    // added out of order, a long maintenance window starts first
+    calendar.add(Reservation{48, 56, 64, 95});
+    calendar.add(Reservation{10, 200, 0, 7});
+    calendar.add(Reservation{100, 104, 64, 127});
+    calendar.add(Reservation{30, 40, 8, 20});
+    calendar.add(Reservation{60, 62, 64, 65});
+    REQUIRE(calendar.getReservations().size() == 5);
+    REQUIRE(calendar.getReservations()[0].start == 10);
+    REQUIRE(calendar.getReservations()[4].start == 100);
+
+    std::vector<const Reservation *> found = calendar.overlapping(50, 61);
+    REQUIRE(found.size() == 3);
+    REQUIRE(found[0]->start == 10);
+    REQUIRE(found[1]->start == 48);
+    REQUIRE(found[2]->start == 60);
+    // the windows are half open
+    REQUIRE(calendar.overlapping(56, 60).size() == 1);
+    REQUIRE(calendar.overlapping(200, 300).empty());
+
+    // a job fits before the next reservation on its node
+    REQUIRE(calendar.isFree(64, 0, 48));
+    REQUIRE(!calendar.isFree(64, 0, 48.5));
+    REQUIRE(calendar.isFree(100, 0, 100));
+    REQUIRE(!calendar.isFree(3, 150, 151));
+    REQUIRE(calendar.isReservedAt(8, 30));
+    REQUIRE(!calendar.isReservedAt(8, 40));
+    REQUIRE(!calendar.isReservedAt(21, 35));
+}
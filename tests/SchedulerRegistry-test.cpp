@@ -0,0 +1,116 @@
+#include "catch.hpp"
+#include "../include/SchedulerRegistry.h"
+#include "../include/AbstractScheduler.h"
+
+TEST_CASE("test the registry creates the schedulers by name", "[schedulerRegistry]") {
+    SchedulerParameters parameters;
+    std::string error;
+    REQUIRE(SchedulerRegistry::check("fifo", parameters, error));
+    REQUIRE(SchedulerRegistry::find("easy") != nullptr);
+    REQUIRE(SchedulerRegistry::find("unknown") == nullptr);
+    REQUIRE(SchedulerRegistry::create("unknown", parameters) == nullptr);
+
+    AbstractScheduler *scheduler = SchedulerRegistry::create("conservative", parameters);
+    REQUIRE(scheduler != nullptr);
+    delete scheduler;
+
+    // parameters the scheduler does not know are refused
+    parameters.set("depth", "2");
+    REQUIRE(!SchedulerRegistry::check("fifo", parameters, error));
+    REQUIRE(error == "Unknown parameter of the fifo scheduler : depth");
+
+    static double depthGiven = 0;
+    SchedulerRegistry::add({"test", "scheduler registered by the test", {"depth"},
+                            [](const SchedulerParameters &parameters) -> AbstractScheduler * {
+                                depthGiven = parameters.get("depth", 1);
+                                return new Scheduler();
+                            }, nullptr});
+    scheduler = SchedulerRegistry::create("test", parameters);
+    REQUIRE(scheduler != nullptr);
+    REQUIRE(depthGiven == 2);
+    REQUIRE(parameters.get("other", 5) == 5);
+    REQUIRE(parameters.getString("depth", "") == "2");
+    REQUIRE(SchedulerRegistry::descriptions().back().name == "test");
+    delete scheduler;
+}
+
+TEST_CASE("test the values of the parameters must be numbers", "[schedulerRegistry]") {
+    SchedulerRegistry::add({"test", "scheduler registered by the test", {"depth"},
+                            [](const SchedulerParameters &) -> AbstractScheduler * { return new Scheduler(); }, nullptr});
+    SchedulerParameters parameters;
+    std::string error;
+    parameters.set("depth", "deep");
+    REQUIRE(!parameters.isNumber("depth"));
+    REQUIRE(!SchedulerRegistry::check("test", parameters, error));
+    REQUIRE(error == "Invalid value of parameter depth");
+    REQUIRE(SchedulerRegistry::create("test", parameters) == nullptr);
+
+    parameters.set("depth", "2levels");
+    REQUIRE(!SchedulerRegistry::check("test", parameters, error));
+    parameters.set("depth", "");
+    REQUIRE(!SchedulerRegistry::check("test", parameters, error));
+
+    parameters.set("depth", "0.25");
+    REQUIRE(parameters.isNumber("depth"));
+    REQUIRE(SchedulerRegistry::check("test", parameters, error));
+
+    // the formula of the multifactor scheduler is the only value which is not a number
+    SchedulerParameters multifactorParameters;
+    multifactorParameters.set("priority", "1000*age");
+    REQUIRE(SchedulerRegistry::check("multifactor", multifactorParameters, error));
+    multifactorParameters.set("halfLife", "week");
+    REQUIRE(!SchedulerRegistry::check("multifactor", multifactorParameters, error));
+    REQUIRE(error == "Invalid value of parameter halfLife");
+}
+
+TEST_CASE("test the fair-share scale and the recalculation period of the multifactor scheduler are checked",
+          "[schedulerRegistry]") {
+    SchedulerParameters parameters;
+    std::string error;
+    parameters.set("usageScale", "0");
+    REQUIRE(!SchedulerRegistry::check("multifactor", parameters, error));
+    REQUIRE(error == "The usageScale parameter must be positive");
+    parameters.set("usageScale", "-5");
+    REQUIRE(!SchedulerRegistry::check("multifactor", parameters, error));
+    REQUIRE(SchedulerRegistry::create("multifactor", parameters) == nullptr);
+
+    parameters.set("usageScale", "500");
+    parameters.set("recalculationPeriod", "-1");
+    REQUIRE(!SchedulerRegistry::check("multifactor", parameters, error));
+    REQUIRE(error == "The recalculationPeriod parameter can not be negative");
+    parameters.set("recalculationPeriod", "0");
+    REQUIRE(SchedulerRegistry::check("multifactor", parameters, error));
+}
+
+TEST_CASE("test every scheduler accepts the week-end packing parameters", "[schedulerRegistry]") {
+    SchedulerParameters parameters;
+    std::string error;
+    parameters.set("weekendPacking", "1");
+    parameters.set("maxSkippedWeekends", "3");
+    REQUIRE(SchedulerRegistry::check("fifo", parameters, error));
+    REQUIRE(SchedulerRegistry::check("conservative", parameters, error));
+    AbstractScheduler *scheduler = SchedulerRegistry::create("easy", parameters);
+    REQUIRE(scheduler != nullptr);
+    delete scheduler;
+
+    parameters.set("maxSkippedWeekends", "-1");
+    REQUIRE(!SchedulerRegistry::check("fifo", parameters, error));
+    REQUIRE(error == "The maxSkippedWeekends parameter can not be negative");
+
+    parameters.set("maxSkippedWeekends", "2");
+    parameters.set("preemption", "1");
+    REQUIRE(SchedulerRegistry::check("fairshare", parameters, error));
+    parameters.set("checkpointOverhead", "-0.5");
+    REQUIRE(!SchedulerRegistry::check("fairshare", parameters, error));
+    REQUIRE(error == "The checkpointOverhead parameter can not be negative");
+
+    parameters.set("checkpointOverhead", "0.5");
+    parameters.set("partitionPeriod", "24");
+    parameters.set("maxSmallNodes", "20");
+    REQUIRE(SchedulerRegistry::check("conservative", parameters, error));
+    parameters.set("minSmallNodes", "0");
+    REQUIRE(SchedulerRegistry::check("conservative", parameters, error));
+    parameters.set("minMediumNodes", "40");
+    REQUIRE(!SchedulerRegistry::check("conservative", parameters, error));
+    REQUIRE(error == "The bounds of the partitions can not be negative and the minimums can not exceed the maximums");
+}
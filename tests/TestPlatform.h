@@ -0,0 +1,116 @@
+#ifndef SUPERCOMPUTERSIMULATION_TESTPLATFORM_H
+#define SUPERCOMPUTERSIMULATION_TESTPLATFORM_H
+
+#include <vector>
+#include "../include/HPCSimulator.h"
+#include "../include/HeapQueue.h"
+#include "../include/AbstractScheduler.h"
+#include "../include/AbstractJob.h"
+#include "../include/Node.h"
+#include "../include/User.h"
+
+/**
+ * Simulation of a small platform for the tests of the schedulers : the test submits the jobs itself
+ * and runs the events up to the times it checks. The platform owns the scheduler, the nodes and the jobs.
+ */
+class TestPlatform : public HPCSimulator {
+private:
+    std::vector<Node *> nodes;
+    /**
+     * Jobs submitted, the finished ones are deleted by HPCSimulator
+     */
+    std::vector<AbstractJob *> jobs;
+    /**
+     * User submitting every job
+     */
+    User user;
+
+public:
+    AbstractScheduler *scheduler;
+
+    /**
+     * Give the nodes to the scheduler, with ids in the order of HPCSimulator::start : the gpu nodes first,
+     * then the nodes reserved for small jobs, for medium jobs and the normal nodes
+     */
+    explicit TestPlatform(AbstractScheduler *scheduler, int normalNodes, int mediumNodes = 0, int smallNodes = 0,
+                          int gpuNodes = 0) : scheduler(scheduler) {
+        events = new HeapQueue();
+        tracer.setLevel(TraceOff);
+        for (int i = 0; i < gpuNodes; ++i) {
+            nodes.push_back(new GpuNode());
+        }
+        for (int i = 0; i < smallNodes; ++i) {
+            nodes.push_back(new ReservedForSmallJobNode());
+        }
+        for (int i = 0; i < mediumNodes; ++i) {
+            nodes.push_back(new ReservedForMediumJobNode());
+        }
+        for (int i = 0; i < normalNodes; ++i) {
+            nodes.push_back(new Node());
+        }
+        for (size_t id = 0; id < nodes.size(); ++id) {
+            nodes[id]->setId(id);
+            nodes[id]->addScheduler(scheduler);
+            nodes[id]->addFreeNodeToScheduler(this);
+        }
+    }
+
+    TestPlatform(const TestPlatform &platform) = delete;
+
+    TestPlatform &operator=(const TestPlatform &platform) = delete;
+
+    ~TestPlatform() override {
+        delete scheduler;
+        for (auto &job : jobs) {
+            if (job->getCompletionTime() == 0) {
+                delete job;
+            }
+        }
+        for (auto &node : nodes) {
+            delete node;
+        }
+    }
+
+    /**
+     * Submit a job now
+     * @param numberOfNodes
+     * @param duration of the execution, also its walltime
+     * @param submitter of the job, the same user for every job by default
+     * @param ioIntensity share of its time the job spends on I/O
+     * @param numberOfCores used on each node, 0 for the whole nodes
+     * @return the job, owned by the platform
+     */
+    template<typename Job>
+    Job *submit(int numberOfNodes, double duration, User *submitter = nullptr, double ioIntensity = 0,
+                int numberOfCores = 0) {
+        auto *job = new Job();
+        job->setId(newJobId());
+        job->setNumberOfNodes(numberOfNodes).setExecutionDuration(duration).setSubmittingTime(now())
+                .setUser(submitter != nullptr ? submitter : &user).setIoIntensity(ioIntensity)
+                .setNumberOfCores(numberOfCores);
+        jobs.push_back(job);
+        job->insertIn(this, scheduler);
+        return job;
+    }
+
+    /**
+     * Execute the events up to a time, included
+     * @param limit time at which the simulation stops
+     */
+    void runUntil(double limit) {
+        Event *event;
+        while ((event = (Event *) events->removeFirst()) != nullptr) {
+            if (event->getTime() > limit) {
+                events->insert(event);
+                break;
+            }
+            time = event->getTime();
+            event->execute(this);
+        }
+        time = limit;
+    }
+
+    Node *getNode(int id) const { return nodes[id]; };
+};
+
+#endif //SUPERCOMPUTERSIMULATION_TESTPLATFORM_H
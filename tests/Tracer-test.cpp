@@ -0,0 +1,45 @@
+#include "catch.hpp"
+#include <sstream>
+#include "../include/Simulator.h"
+
+TEST_CASE("test the ring sink keeps the last characters", "[tracer]") {
+    RingTraceSink ring(8);
+    ring.write("abc", 3);
+    REQUIRE(ring.contents() == "abc");
+    ring.write("defghij", 7);
+    REQUIRE(ring.contents() == "cdefghij");
+    ring.write("0123456789", 10);
+    REQUIRE(ring.contents() == "23456789");
+}
+
+TEST_CASE("test the tracer buffers the messages until flushed", "[tracer]") {
+    std::ostringstream out;
+    Simulator simulator;
+    simulator.getTracer().setSink(new StreamTraceSink(out));
+    HPC_TRACE(&simulator, TraceInfo, "Weekend Start\n");
+    REQUIRE(out.str().empty());
+    simulator.getTracer().flush();
+    REQUIRE(out.str() == "Weekend Start\n");
+    std::string longMessage(3 * Tracer::bufferSize, 'x');
+    HPC_TRACE(&simulator, TraceInfo, longMessage);
+    REQUIRE(out.str().size() > Tracer::bufferSize);
+    simulator.getTracer().flush();
+    REQUIRE(out.str() == "Weekend Start\n" + longMessage);
+}
+
+TEST_CASE("test the messages above the level are not built", "[tracer]") {
+    std::ostringstream out;
+    Simulator simulator;
+    simulator.getTracer().setSink(new StreamTraceSink(out));
+    simulator.getTracer().setLevel(TraceInfo);
+    int numberOfCalls = 0;
+    auto message = [&numberOfCalls]() {
+        numberOfCalls++;
+        return "event\n";
+    };
+    HPC_TRACE(&simulator, TraceEvents, message());
+    HPC_TRACE(&simulator, TraceInfo, message());
+    simulator.getTracer().flush();
+    REQUIRE(numberOfCalls == 1);
+    REQUIRE(out.str() == "event\n");
+}
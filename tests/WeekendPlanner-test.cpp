@@ -0,0 +1,91 @@
+#include "catch.hpp"
+#include "TestPlatform.h"
+#include "../include/WeekendPlanner.h"
+#include "../include/weekendEvent.h"
+
+TEST_CASE("test the knapsack selects the most valuable items fitting in the capacity", "[weekendPlanner]") {
+    // a single large item is worth less than the two items filling the capacity
+    std::vector<size_t> selection = WeekendPlanner::knapsack({100, 64, 64}, {6400, 4096, 4096}, 128);
+    REQUIRE(selection == std::vector<size_t>({1, 2}));
+
+    // on equal values the first items are preferred
+    selection = WeekendPlanner::knapsack({64, 64, 64}, {100, 100, 100}, 128);
+    REQUIRE(selection == std::vector<size_t>({0, 1}));
+
+    // items larger than the capacity are never selected
+    selection = WeekendPlanner::knapsack({200, 10}, {1e6, 1}, 128);
+    REQUIRE(selection == std::vector<size_t>({1}));
+
+    REQUIRE(WeekendPlanner::knapsack({}, {}, 128).empty());
+    REQUIRE(WeekendPlanner::knapsack({1}, {1}, 0).empty());
+}
+
+TEST_CASE("test a huge job left waiting for too many week-ends must start", "[weekendPlanner]") {
+    WeekendPlanner planner(2);
+    HugeJob hugeJob;
+    const AbstractJob *job = &hugeJob;
+    REQUIRE(!planner.mustStart(job));
+    planner.skipped(job);
+    REQUIRE(planner.getSkippedWeekends(job) == 1);
+    REQUIRE(!planner.mustStart(job));
+    planner.skipped(job);
+    REQUIRE(planner.mustStart(job));
+    planner.started(job);
+    REQUIRE(planner.getSkippedWeekends(job) == 0);
+    REQUIRE(!planner.mustStart(job));
+}
+
+TEST_CASE("test the knapsack keeps its result with many candidates of the same size", "[weekendPlanner]") {
+    // only the 4 most valuable items of size 32 can be part of a selection for 128 nodes
+    std::vector<int> sizes(1000, 32);
+    std::vector<double> values(1000, 1);
+    values[500] = 2;
+    values[999] = 3;
+    std::vector<size_t> selection = WeekendPlanner::knapsack(sizes, values, 128);
+    REQUIRE(selection == std::vector<size_t>({0, 1, 500, 999}));
+}
+
+TEST_CASE("test a huge job which must start is started once", "[weekendPlanner]") {
+    auto *planner = new WeekendPlanner(1);
+    TestPlatform platform(new Scheduler(), 4);
+    platform.scheduler->setWeekendPlanner(planner);
+    auto *job = platform.submit<HugeJob>(2, 10);
+    planner->skipped(job);
+    REQUIRE(planner->mustStart(job));
+    // once started it is no more a job which must start, it must not be selected again for the free nodes
+    WeekendBegin weekendBegin(platform.scheduler);
+    platform.insert(&weekendBegin);
+    platform.runUntil(104);
+    REQUIRE(job->getStartTime() == 104);
+    int numberOfNodesUsed = 0;
+    for (int id = 0; id < 4; ++id) {
+        if (platform.getNode(id)->getJobBeingExecuted() == job) {
+            numberOfNodesUsed++;
+        }
+    }
+    REQUIRE(numberOfNodesUsed == 2);
+}
+
+TEST_CASE("test the planner selects the huge jobs which must start first, then the most node-hours",
+          "[weekendPlanner]") {
+    WeekendPlanner planner(1);
+    HugeJob forced, tooLong, hugeJob;
+    LargeJob largeJob, refused;
+    forced.setNumberOfNodes(2).setExecutionDuration(10);
+    tooLong.setNumberOfNodes(1).setExecutionDuration(100);
+    hugeJob.setNumberOfNodes(2).setExecutionDuration(10);
+    largeJob.setNumberOfNodes(1).setExecutionDuration(30);
+    refused.setNumberOfNodes(1).setExecutionDuration(60);
+    planner.skipped(&forced);
+    std::vector<AbstractJob *> hugeJobs = {&tooLong, &forced, &hugeJob};
+    std::vector<AbstractJob *> otherJobs = {&refused, &largeJob};
+    auto fits = [&refused](AbstractJob *job) { return job != &refused; };
+
+    // 2 nodes left once the forced job is selected : the large job uses more node-hours than the huge job
+    std::vector<AbstractJob *> selection = planner.select(hugeJobs, otherJobs, 4, 64, fits);
+    REQUIRE(selection == std::vector<AbstractJob *>({&forced, &largeJob}));
+
+    // nothing else is selected when a huge job which must start does not fit
+    selection = planner.select(hugeJobs, otherJobs, 1, 64, fits);
+    REQUIRE(selection.empty());
+}
@@ -1,2 +1,3 @@
 #define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#define CATCH_CONFIG_NO_POSIX_SIGNALS // the alternate signal stack of this catch version does not build with recent glibc
 #include "catch.hpp"
\ No newline at end of file
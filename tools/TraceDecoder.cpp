@@ -0,0 +1,65 @@
+/**
+ * Convert a binary trace written with --binary-trace into CSV or JSON on the standard output.
+ * Usage : TraceDecoder trace.bin [csv|json]
+ */
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "../include/BinaryTrace.h"
+
+static const char *jobTypeName(int32_t jobType) {
+    static const char *names[] = {"small", "medium", "large", "huge", "gpu"};
+    if (jobType < 0 || jobType >= 5) {
+        return "";
+    }
+    return names[jobType];
+}
+
+static void printCsv(BinaryTraceReader &reader) {
+    std::cout << "time,event,job,user,type,nodes,node,duration,submitted\n";
+    BinaryTraceRecord record{};
+    char line[256];
+    while (reader.read(record)) {
+        std::snprintf(line, sizeof(line), "%.6f,%s,%d,%d,%s,%d,%d,%.6f,%.6f\n", record.time,
+                      recordKindName(record.kind), record.jobId, record.userId, jobTypeName(record.jobType),
+                      record.numberOfNodes, record.nodeId, record.duration, record.submittingTime);
+        std::cout << line;
+    }
+}
+
+static void printJson(BinaryTraceReader &reader) {
+    std::cout << "[";
+    BinaryTraceRecord record{};
+    char line[320];
+    bool first = true;
+    while (reader.read(record)) {
+        std::snprintf(line, sizeof(line),
+                      "%s\n{\"time\":%.6f,\"event\":\"%s\",\"job\":%d,\"user\":%d,\"type\":\"%s\",\"nodes\":%d,"
+                      "\"node\":%d,\"duration\":%.6f,\"submitted\":%.6f}",
+                      first ? "" : ",", record.time, recordKindName(record.kind), record.jobId, record.userId,
+                      jobTypeName(record.jobType), record.numberOfNodes, record.nodeId, record.duration,
+                      record.submittingTime);
+        std::cout << line;
+        first = false;
+    }
+    std::cout << "\n]\n";
+}
+
+int main(int argc, char *argv[]) {
+    std::string format = argc > 2 ? argv[2] : "csv";
+    if (argc < 2 || (format != "csv" && format != "json")) {
+        std::cout << "Usage : TraceDecoder trace.bin [csv|json]\n";
+        return 1;
+    }
+    BinaryTraceReader reader(argv[1]);
+    if (!reader.isValid()) {
+        std::cout << "Not a binary trace of version " << BinaryTraceWriter::version << " : " << argv[1] << "\n";
+        return 1;
+    }
+    if (format == "csv") {
+        printCsv(reader);
+    } else {
+        printJson(reader);
+    }
+    return 0;
+}